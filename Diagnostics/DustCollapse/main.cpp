@@ -13,7 +13,7 @@
 //
 #include <iostream>
 #include <regex>
-#include <AMReX_DataServices.H>
+#include <plotfile_compression.H>
 #include <DustCollapse_F.H>
 
 using namespace amrex;
@@ -68,18 +68,8 @@ int main(int argc, char* argv[])
     	Real yctr = center[1];
     	Real zctr = center[2];
 
-		// Start dataservices
-		DataServices::SetBatchMode();
-
-		// Define the type of file
-		Amrvis::FileType fileType(Amrvis::NEWPLT);
-		DataServices dataServices (pltfile, fileType);
-
-		if (!dataServices.AmrDataOk())
-			DataServices::Dispatch(DataServices::ExitRequest, NULL);
-
-		// get data from plot file
-		AmrData& data = dataServices.AmrDataRef();
+		// read the plotfile, compressed or not
+		plt_compress::PlotfileData data(pltfile);
 
 		int finestLevel = data.FinestLevel();
 
@@ -3,7 +3,7 @@
 // function of r, for comparison to the analytic solution.
 //
 #include <iostream>
-#include <AMReX_DataServices.H>
+#include <plotfile_compression.H>
 #include <Radiation_F.H>
 #include <Radiation_utils.H>
 
@@ -25,18 +25,8 @@ int main(int argc, char* argv[])
 
 	GetInputArgs(argc, argv, pltfile, slcfile, dir);
 
-	// Start dataservices
-	DataServices::SetBatchMode();
-
-	// Define the type of file
-	Amrvis::FileType fileType(Amrvis::NEWPLT);
-	DataServices dataServices (pltfile, fileType);
-
-	if (!dataServices.AmrDataOk())
-		DataServices::Dispatch(DataServices::ExitRequest, NULL);
-
-	// get data from plot file
-	AmrData& data = dataServices.AmrDataRef();
+	// read the plotfile, compressed or not
+	plt_compress::PlotfileData data(pltfile);
 
 	int finestLevel = data.FinestLevel();
 
@@ -9,7 +9,7 @@
 // We read in all the variables, but only output a subset
 //
 #include <iostream>
-#include <AMReX_DataServices.H>
+#include <plotfile_compression.H>
 #include <Radiation_F.H>
 #include <Radiation_utils.H>
 
@@ -38,18 +38,8 @@ int main(int argc, char* argv[])
 	if (idir > AMREX_SPACEDIM)
 		Abort("ERROR: idir must be <= DIM");
 
-	// Start dataservices
-	DataServices::SetBatchMode();
-
-	// Define the type of file
-	Amrvis::FileType fileType(Amrvis::NEWPLT);
-	DataServices dataServices (pltfile, fileType);
-
-	if (!dataServices.AmrDataOk())
-		DataServices::Dispatch(DataServices::ExitRequest, NULL);
-
-	// get data from plot file
-	AmrData& data = dataServices.AmrDataRef();
+	// read the plotfile, compressed or not
+	plt_compress::PlotfileData data(pltfile);
 
 	int finestLevel = data.FinestLevel();
 
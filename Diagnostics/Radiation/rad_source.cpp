@@ -9,7 +9,7 @@
 // energy density in the first zone as a function of time.
 //
 #include <iostream>
-#include <AMReX_DataServices.H>
+#include <plotfile_compression.H>
 #include <Radiation_F.H>
 #include <Radiation_utils.H>
 
@@ -39,18 +39,8 @@ int main(int argc, char* argv[])
 
 		string pltfile = argv[i];
 
-		// Start dataservices
-		DataServices::SetBatchMode();
-
-		// Define the type of file
-		Amrvis::FileType fileType(Amrvis::NEWPLT);
-		DataServices dataServices (pltfile, fileType);
-
-		if (!dataServices.AmrDataOk())
-			DataServices::Dispatch(DataServices::ExitRequest, NULL);
-
-		// get data from plot file
-		AmrData& data = dataServices.AmrDataRef();
+		// read the plotfile, compressed or not
+		plt_compress::PlotfileData data(pltfile);
 
 		// get variable names
 		const Vector<string>& varNames = data.PlotVarNames();
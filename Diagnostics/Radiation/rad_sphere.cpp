@@ -4,7 +4,7 @@
 //
 #include <iostream>
 #include <regex>
-#include <AMReX_DataServices.H>
+#include <plotfile_compression.H>
 #include <Radiation_F.H>
 #include <Radiation_utils.H>
 
@@ -82,18 +82,8 @@ int main(int argc, char* argv[])
         Print() << "variable = " << variable << std::endl;
 	Print() << std::endl;
 
-	// Start dataservices
-	DataServices::SetBatchMode();
-
-	// Define the type of file
-	Amrvis::FileType fileType(Amrvis::NEWPLT);
-	DataServices dataServices (pltfile, fileType);
-
-	if (!dataServices.AmrDataOk())
-		DataServices::Dispatch(DataServices::ExitRequest, NULL);
-
-	// get data from plot file
-	AmrData& data = dataServices.AmrDataRef();
+	// read the plotfile, compressed or not
+	plt_compress::PlotfileData data(pltfile);
 
 	int finestLevel = data.FinestLevel();
 
@@ -3,7 +3,7 @@
 //
 #include <iostream>
 #include <regex>
-#include <AMReX_DataServices.H>
+#include <plotfile_compression.H>
 #include <Radiation_F.H>
 #include <Radiation_utils.H>
 
@@ -79,18 +79,8 @@ int main(int argc, char* argv[])
 
 	group_file.close();
 
-	// Start dataservices
-	DataServices::SetBatchMode();
-
-	// Define the type of file
-	Amrvis::FileType fileType(Amrvis::NEWPLT);
-	DataServices dataServices (pltfile, fileType);
-
-	if (!dataServices.AmrDataOk())
-		DataServices::Dispatch(DataServices::ExitRequest, NULL);
-
-	// get data from plot file
-	AmrData& data = dataServices.AmrDataRef();
+	// read the plotfile, compressed or not
+	plt_compress::PlotfileData data(pltfile);
 
 	if (data.FinestLevel() != 0)
 		Abort("ERROR: rhd_shocktube only works for single level");
@@ -5,7 +5,7 @@
 #include <iostream>
 // #include <stringstream>
 #include <regex>
-#include <AMReX_DataServices.H>
+#include <plotfile_compression.H>
 #include <Sedov_F.H>
 
 using namespace amrex;
@@ -44,18 +44,8 @@ int main(int argc, char* argv[])
 	double xctr = center[0];
 	double yctr = center[1];
 	double zctr = center[2];
-	// Start dataservices
-	DataServices::SetBatchMode();
-
-	// Define the type of file
-	Amrvis::FileType fileType(Amrvis::NEWPLT);
-	DataServices dataServices (pltfile, fileType);
-
-	if (!dataServices.AmrDataOk())
-		DataServices::Dispatch(DataServices::ExitRequest, NULL);
-
-	// get data from plot file
-	AmrData& data = dataServices.AmrDataRef();
+	// read the plotfile, compressed or not
+	plt_compress::PlotfileData data(pltfile);
 
 	int finestLevel = data.FinestLevel();
 
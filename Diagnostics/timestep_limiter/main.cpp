@@ -5,7 +5,7 @@
 #include <fstream>
 // #include <stringstream>
 #include <regex>
-#include <AMReX_DataServices.H>
+#include <plotfile_compression.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_BaseFab.H>
 #include <Limiter_F.H>
@@ -56,15 +56,8 @@ int main(int argc, char* argv[])
     ca_get_method_params(&NUM_GROW);
     ca_set_castro_method_params();
 
-	// Start dataservices
-	DataServices::SetBatchMode();
-
-	// Define the type of file
-	Amrvis::FileType fileType(Amrvis::NEWPLT);
-	DataServices dataServices (pltfile, fileType);
-
-	if (!dataServices.AmrDataOk())
-		DataServices::Dispatch(DataServices::ExitRequest, NULL);
+	// read the plotfile, compressed or not
+	plt_compress::PlotfileData data(pltfile);
 
     // initialize microphysics stuff 
     auto probin_name = "probin";
@@ -76,9 +69,6 @@ int main(int argc, char* argv[])
 
     microphysics_initialize(probin_file.dataPtr(), &probin_file_length);
 
-	// get data from plot file
-	AmrData& data = dataServices.AmrDataRef();
-
 	// get variable names
 	const Vector<string>& varNames = data.PlotVarNames();
 
@@ -3,9 +3,7 @@
 
 #include <state_indices.H>
 
-#include <castro_params.H>
-#include <eos.H>
-#include <conductivity.H>
+#include <diffusion_util.H>
 
 using namespace amrex;
 
@@ -41,18 +39,7 @@ fill_temp_cond(const Box& bx,
     }
 
 
-    if (eos_state.rho > castro::diffuse_cutoff_density) {
-      conductivity(eos_state);
-
-      if (eos_state.rho < castro::diffuse_cutoff_density_hi) {
-        Real multiplier = (eos_state.rho - castro::diffuse_cutoff_density) /
-          (castro::diffuse_cutoff_density_hi - castro::diffuse_cutoff_density);
-        eos_state.conductivity = eos_state.conductivity * multiplier;
-      }
-    } else {
-      eos_state.conductivity = 0.0_rt;
-    }
-    coeff_arr(i,j,k) = castro::diffuse_cond_scale_fac * eos_state.conductivity;
+    coeff_arr(i,j,k) = diffusion_conductivity(eos_state);
 
   });
 }
@@ -90,19 +77,7 @@ fill_temp_diff_coeff(const Box& bx,
     }
 
 
-    if (eos_state.rho > castro::diffuse_cutoff_density) {
-      conductivity(eos_state);
-
-      if (eos_state.rho < castro::diffuse_cutoff_density_hi) {
-        Real multiplier = (eos_state.rho - castro::diffuse_cutoff_density) /
-          (castro::diffuse_cutoff_density_hi - castro::diffuse_cutoff_density);
-        eos_state.conductivity = eos_state.conductivity * multiplier;
-      }
-    } else {
-      eos_state.conductivity = 0.0_rt;
-    }
-    coeff_arr(i,j,k) = castro::diffuse_cond_scale_fac * eos_state.conductivity *
-      rhoinv / eos_state.cv;
+    coeff_arr(i,j,k) = diffusion_conductivity(eos_state) * rhoinv / eos_state.cv;
 
   });
 }
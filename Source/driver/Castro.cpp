@@ -16,6 +16,11 @@
 #include <Castro.H>
 #include <Castro_F.H>
 #include <Castro_error_F.H>
+#include <Castro_bc_fill_nd.H>
+#include <Derive.H>
+#include <checkpoint_staging.H>
+#include <memory_accounting.H>
+#include <telemetry.H>
 #include <runtime_parameters.H>
 #include <AMReX_VisMF.H>
 #include <AMReX_TagBox.H>
@@ -33,6 +38,7 @@
 
 #ifdef GRAVITY
 #include <Gravity.H>
+#include <radial_bins.H>
 #endif
 
 #ifdef DIFFUSION
@@ -61,6 +67,10 @@
 
 #include <ambient.H>
 
+#ifdef MHD
+#include <mhd_util.H>
+#endif
+
 using namespace amrex;
 
 bool         Castro::signalStopJob = false;
@@ -152,6 +162,11 @@ int          Castro::do_init_probparams = 0;
 void
 Castro::variableCleanUp ()
 {
+  // Wait for the last staged checkpoint to reach its destination.
+  if (!checkpoint_stage_dir.empty()) {
+    chk_stage::finish();
+  }
+
 #ifdef GRAVITY
   if (gravity != 0) {
     if (verbose > 1 && ParallelDescriptor::IOProcessor()) {
@@ -186,6 +201,7 @@ Castro::variableCleanUp ()
 #endif
 
 #ifdef AMREX_PARTICLES
+  FlushParticleTimestamps();
   delete TracerPC;
   TracerPC = 0;
 #endif
@@ -458,6 +474,8 @@ Castro::read_params ()
 
    StateDescriptor::setBndryFuncThreadSafety(bndry_func_thread_safe);
 
+   mem_acct::init(memory_report > 0 || memory_budget > 0.0, memory_budget);
+
    ParmParse ppa("amr");
    ppa.query("probin_file",probin_file);
 
@@ -658,10 +676,14 @@ Castro::Castro (Amr&            papa,
     }
 #endif
 
+    watch_memory();
+
 }
 
 Castro::~Castro ()
 {
+    mem_acct::unwatch(this);
+
 #ifdef RADIATION
     if (radiation != 0) {
       //radiation->cleanup(level);
@@ -768,6 +790,19 @@ Castro::initMFs()
     }
 #endif
 
+#ifdef MHD
+    // The EMFs live on the edges: cell-centered along the edge and nodal
+    // in the other two directions.
+
+    emf.resize(3);
+
+    for (int dir = 0; dir < 3; ++dir) {
+      IntVect edge(1, 1, 1);
+      edge[dir] = 0;
+      emf[dir].reset(new MultiFab(amrex::convert(grids, edge), dmap, 1, 0));
+    }
+#endif
+
 #ifdef RADIATION
     if (Radiation::rad_hydro_combined) {
         rad_fluxes.resize(BL_SPACEDIM);
@@ -803,6 +838,11 @@ Castro::initMFs()
         }
 #endif
 
+#ifdef MHD
+        emf_reg.define(grids, dmap, crse_ratio);
+        emf_reg.setVal(0.0);
+#endif
+
     }
 
     // Set the flux register scalings.
@@ -846,6 +886,104 @@ Castro::initMFs()
 
 }
 
+void
+Castro::watch_memory ()
+{
+    mem_acct::watch(this, level, mem_acct::state, [this] ()
+    {
+        Long n = 0;
+        for (int k = 0; k < num_state_type; ++k) {
+            if (state[k].hasOldData()) {
+                n += mem_acct::bytes(state[k].oldData());
+            }
+            if (state[k].hasNewData()) {
+                n += mem_acct::bytes(state[k].newData());
+            }
+        }
+        return n;
+    });
+
+    mem_acct::watch(this, level, mem_acct::hydro, [this] ()
+    {
+        return mem_acct::bytes(Sborder) + mem_acct::bytes(hydro_source);
+    });
+
+    mem_acct::watch(this, level, mem_acct::sources, [this] ()
+    {
+        Long n = mem_acct::bytes(sources_for_hydro) + mem_acct::bytes(source_corrector);
+#ifdef ROTATION
+        n += mem_acct::bytes(rot_cache);
+#endif
+#ifdef SPONGE
+        n += mem_acct::bytes(sponge_cache);
+#endif
+        return n;
+    });
+
+    mem_acct::watch(this, level, mem_acct::fluxes, [this] ()
+    {
+        Long n = mem_acct::bytes(fluxes) + mem_acct::bytes(mass_fluxes) + mem_acct::bytes(P_radial);
+#ifdef RADIATION
+        n += mem_acct::bytes(rad_fluxes);
+#endif
+#ifdef MHD
+        n += mem_acct::bytes(emf);
+#endif
+        return n;
+    });
+
+    mem_acct::watch(this, level, mem_acct::retry, [this] ()
+    {
+        Long n = 0;
+        for (const auto& sd : prev_state) {
+            if (sd && sd->hasOldData()) {
+                n += mem_acct::bytes(sd->oldData());
+            }
+            if (sd && sd->hasNewData()) {
+                n += mem_acct::bytes(sd->newData());
+            }
+        }
+        return n;
+    });
+
+#ifdef TRUE_SDC
+    // k_new[0] and A_new[0] are aliases.
+
+    mem_acct::watch(this, level, mem_acct::sdc, [this] ()
+    {
+        Long n = mem_acct::bytes(k_new, 1) + mem_acct::bytes(A_old) + mem_acct::bytes(A_new, 1) +
+                 mem_acct::bytes(Sburn) + mem_acct::bytes(q) + mem_acct::bytes(qaux) +
+                 mem_acct::bytes(q_bar) + mem_acct::bytes(qaux_bar);
+#ifdef REACTIONS
+        n += mem_acct::bytes(R_old);
+#endif
+#ifdef DIFFUSION
+        n += mem_acct::bytes(T_cc);
+#endif
+        return n;
+    });
+#endif
+
+#ifdef GRAVITY
+    if (do_grav) {
+        mem_acct::watch(this, level, mem_acct::gravity, [this] ()
+        {
+            return mem_acct::bytes(gravity->get_grad_phi_prev(level)) +
+                   mem_acct::bytes(gravity->get_grad_phi_curr(level)) +
+                   mem_acct::bytes(comp_minus_level_phi) +
+                   mem_acct::bytes(comp_minus_level_grad_phi);
+        });
+    }
+#endif
+
+#ifdef RADIATION
+    mem_acct::watch(this, level, mem_acct::radiation, [this] ()
+    {
+        return mem_acct::bytes(Erborder) + mem_acct::bytes(lamborder);
+    });
+#endif
+}
+
 void
 Castro::setTimeLevel (Real time,
                       Real dt_old,
@@ -1494,6 +1632,25 @@ Castro::init (AmrLevel &old)
         }
     }
 
+#ifdef MHD
+    // The field interpolated from the coarse level is divergence free, and
+    // so is the field copied from the old grids, but not where they meet.
+
+    if (level > 0) {
+        correct_B_regrid_seams(oldlev->boxArray(),
+                               get_new_data(Mag_Type_x),
+                               get_new_data(Mag_Type_y),
+                               get_new_data(Mag_Type_z));
+
+        if (state[Mag_Type_x].hasOldData()) {
+            correct_B_regrid_seams(oldlev->boxArray(),
+                                   get_old_data(Mag_Type_x),
+                                   get_old_data(Mag_Type_y),
+                                   get_old_data(Mag_Type_z));
+        }
+    }
+#endif
+
     // Copy some other data we need from the old class.
     // One reason this is necessary is if we are doing
     // a post-timestep regrid -- then we're going to need
@@ -1588,6 +1745,13 @@ Castro::estTimeStep ()
 
     Real estdt_hydro = max_dt / cfl;
 
+#if defined(MHD) && defined(DIFFUSION)
+    // The MHD timestep pass also gives the diffusion-limited timestep.
+
+    bool have_estdt_diffusion = false;
+    Real estdt_diffusion_mhd = max_dt / cfl;
+#endif
+
     if (do_hydro)
     {
 
@@ -1631,7 +1795,18 @@ Castro::estTimeStep ()
 #endif
 
 #ifdef MHD
-          estdt_hydro = estdt_mhd();
+          Real div_B_err;
+#ifdef DIFFUSION
+          estdt_mhd(estdt_hydro, estdt_diffusion_mhd, div_B_err);
+          have_estdt_diffusion = true;
+#else
+          Real estdt_diffusion_mhd;
+          estdt_mhd(estdt_hydro, estdt_diffusion_mhd, div_B_err);
+#endif
+
+          if (verbose) {
+              amrex::Print() << "...max |div B| dx / max |B| at level " << level << ": " << div_B_err << std::endl;
+          }
 #else
           estdt_hydro = estdt_cfl(time);
 #endif
@@ -1664,6 +1839,11 @@ Castro::estTimeStep ()
 
     if (diffuse_temp)
     {
+#if defined(MHD)
+      if (have_estdt_diffusion) {
+        estdt_diffusion = estdt_diffusion_mhd;
+      } else
+#endif
       estdt_diffusion = estdt_temp_diffusion();
     }
 
@@ -2082,11 +2262,39 @@ Castro::post_timestep (int iteration_local)
           sum_integrated_quantities();
         }
 
+        if (analysis_due(cumtime, dtlev)) {
+          insitu_analysis();
+        }
+
+        // Start or check on the background copy of a staged checkpoint.
+
+        if (!checkpoint_stage_dir.empty()) {
+          chk_stage::poll();
+        }
+
 #ifdef GRAVITY
         if (moving_center) {
           write_center();
         }
+
+        // Drop the saved HSE boundary columns of the boxes that were
+        // not filled during this step.
+
+        hse_fill_prune_cache();
 #endif
+
+        // The telemetry for this step, including the finer levels'
+        // subcycles.  Plotfile and checkpoint output happen after
+        // post_timestep, so their time goes into the next record.
+
+        if (!telemetry_file.empty()) {
+          telemetry::write_step(telemetry_file, telemetry_format,
+                                nstep, cumtime, dtlev, parent->finestLevel());
+        }
+
+        if (memory_report > 0 && nstep % memory_report == 0) {
+          mem_acct::report(parent->finestLevel(), "step " + std::to_string(nstep));
+        }
     }
 
 #ifdef RADIATION
@@ -2165,7 +2373,16 @@ Castro::post_restart ()
 
                    gravity->update_max_rhs();
 
-                   gravity->multilevel_solve_for_new_phi(0, parent->finestLevel());
+                   // If the checkpoint holds a composite solution that is still
+                   // consistent with the density, we don't need to solve again.
+
+                   bool use_checkpointed_phi = false;
+                   if (gravity::checkpoint_grad_phi && grown_factor <= 1)
+                       use_checkpointed_phi = gravity->read_grad_phi(parent->theRestartFile(),
+                                                                     parent->finestLevel());
+
+                   if (!use_checkpointed_phi)
+                       gravity->multilevel_solve_for_new_phi(0, parent->finestLevel());
                    if (gravity->test_results_of_solves() == 1)
                        gravity->test_composite_phi(level);
                 }
@@ -2229,6 +2446,18 @@ Castro::post_regrid (int lbase,
 
     fine_mask.clear();
 
+    if (memory_report > 0 && level == new_finest) {
+        mem_acct::report(new_finest, "regrid");
+    }
+
+#ifdef GRAVITY
+    // The saved HSE boundary columns are tied to the old grids.
+
+    if (level == lbase) {
+        hse_fill_clear_cache();
+    }
+#endif
+
 #ifdef AMREX_PARTICLES
     if (TracerPC && level == lbase) {
         TracerPC->Redistribute(lbase);
@@ -2332,6 +2561,12 @@ Castro::post_regrid (int lbase,
                     S_new, state[State_Type].curTime(), S_new.nGrow());
 
     }
+
+#ifdef MHD
+    if (level == new_finest && new_finest > 0) {
+        check_div_B_levels(lbase, "regrid");
+    }
+#endif
 }
 
 void
@@ -2352,6 +2587,12 @@ Castro::post_init (Real /*stop_time*/)
       getLevel(k).avgDown();
     }
 
+#ifdef MHD
+    if (finest_level > 0) {
+        check_div_B_levels(0, "initialization");
+    }
+#endif
+
 #ifdef GRAVITY
 
     if (do_grav) {
@@ -2468,6 +2709,10 @@ Castro::post_init (Real /*stop_time*/)
           sum_integrated_quantities();
         }
 
+        if (analysis_due(cumtime, dtlev)) {
+          insitu_analysis();
+        }
+
 #ifdef GRAVITY
     if (level == 0 && moving_center == 1) {
        write_center();
@@ -2632,6 +2877,12 @@ Castro::FluxRegCrseInit() {
     }
 #endif
 
+#ifdef MHD
+    for (int i = 0; i < 3; ++i) {
+      fine_level.emf_reg.CrseInit(*emf[i], i, flux_crse_scale);
+    }
+#endif
+
 }
 
 
@@ -2662,6 +2913,12 @@ Castro::FluxRegFineAdd() {
     }
 #endif
 
+#ifdef MHD
+    for (int i = 0; i < 3; ++i) {
+      emf_reg.FineAdd(*emf[i], i, flux_fine_scale);
+    }
+#endif
+
 }
 
 
@@ -2669,6 +2926,7 @@ void
 Castro::reflux(int crse_level, int fine_level)
 {
     BL_PROFILE("Castro::reflux()");
+    telemetry::ScopedTimer telemetry_timer(crse_level, telemetry::reflux);
 
     BL_ASSERT(fine_level > crse_level);
 
@@ -2767,6 +3025,19 @@ Castro::reflux(int crse_level, int fine_level)
 
         reg->setVal(0.0);
 
+#ifdef MHD
+        // Replace the coarse EMFs on the coarse-fine edges with the fine
+        // ones.  The faces under the fine grids that this also changes are
+        // overwritten when we average down.
+
+        getLevel(lev).emf_reg.Reflux(crse_lev.get_new_data(Mag_Type_x),
+                                     crse_lev.get_new_data(Mag_Type_y),
+                                     crse_lev.get_new_data(Mag_Type_z),
+                                     crse_lev.geom);
+
+        getLevel(lev).emf_reg.setVal(0.0);
+#endif
+
 #if (BL_SPACEDIM <= 2)
         if (!Geom().IsCartesian()) {
 
@@ -3015,6 +3286,10 @@ Castro::avgDown ()
   if (level == parent->finestLevel()) return;
 
   for (int k = 0; k < num_state_type; k++) {
+#ifdef MHD
+      // The components of B are averaged down together, with Mag_Type_x.
+      if (k == Mag_Type_y || k == Mag_Type_z) continue;
+#endif
       avgDown(k);
   }
 
@@ -3209,6 +3484,13 @@ Castro::avgDown (int state_indx)
 
     if (level == parent->finestLevel()) return;
 
+#ifdef MHD
+    if (state_indx == Mag_Type_x || state_indx == Mag_Type_y || state_indx == Mag_Type_z) {
+        avgDown_B();
+        return;
+    }
+#endif
+
     Castro& fine_lev = getLevel(level+1);
 
     const Geometry& fgeom = fine_lev.geom;
@@ -3692,6 +3974,71 @@ Castro::derive (const std::string& name,
     AmrLevel::derive(name,time,mf,dcomp);
 }
 
+void
+Castro::derive_thermo_group (const Vector<std::string>& names,
+                             Real                       time,
+                             MultiFab&                  mf,
+                             const Vector<int>&         dcomps)
+{
+
+    BL_PROFILE("Castro::derive_thermo_group()");
+
+    AMREX_ALWAYS_ASSERT(names.size() == dcomps.size());
+
+    GpuArray<int, thermo_derive::nvar> comp;
+    for (int n = 0; n < thermo_derive::nvar; ++n) {
+        comp[n] = -1;
+    }
+
+    for (int n = 0; n < names.size(); ++n) {
+        const int idx = thermo_derive::index(names[n]);
+        AMREX_ALWAYS_ASSERT(idx >= 0);
+        comp[idx] = dcomps[n];
+    }
+
+    // All of the group members work zone by zone, so we only need
+    // the valid zones of the state.
+
+    MultiFab S(grids, dmap, NUM_STATE, 0);
+    FillPatch(*this, S, 0, time, State_Type, 0, NUM_STATE);
+
+#ifdef REACTIONS
+    MultiFab R;
+    if (comp[thermo_derive::t_sound_t_enuc] >= 0) {
+        R.define(grids, dmap, 1, 0);
+        FillPatch(*this, R, 0, time, Reactions_Type, NumSpec+NumAux, 1);
+    }
+#endif
+
+    const auto dx = geom.CellSizeArray();
+
+#if AMREX_SPACEDIM == 1
+    const Real dd = dx[0];
+#elif AMREX_SPACEDIM == 2
+    const Real dd = amrex::min(dx[0], dx[1]);
+#else
+    const Real dd = amrex::min(dx[0], dx[1], dx[2]);
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(S, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+        Array4<Real const> enuc;
+#ifdef REACTIONS
+        if (comp[thermo_derive::t_sound_t_enuc] >= 0) {
+            enuc = R.array(mfi);
+        }
+#endif
+
+        ca_derthermo(bx, mf.array(mfi), S.array(mfi), enuc, comp, dd);
+    }
+
+}
+
 void
 Castro::amrinfo_init ()
 {
@@ -3915,9 +4262,7 @@ Castro::check_div_B( MultiFab& Bx,
       [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
       {
           
-          Real divB = (Bx_arr(i+1,j,k) - Bx_arr(i,j,k))/dx[0] +
-                      (By_arr(i,j+1,k) - By_arr(i,j,k))/dx[1] + 
-                      (Bz_arr(i,j,k+1) - Bz_arr(i,j,k))/dx[2];
+          Real divB = mhd_div_B(i, j, k, Bx_arr, By_arr, Bz_arr, dx);
         
           Real bx_cell_c = 0.5_rt * (Bx_arr(i,j,k) + Bx_arr(i+1,j,k));
           Real by_cell_c = 0.5_rt * (By_arr(i,j,k) + By_arr(i,j+1,k));
@@ -4304,91 +4649,70 @@ Castro::make_radial_data(int is_new)
 
    int numpts_1d = get_numpts();
 
-   Vector<Real> radial_vol(numpts_1d,0);
-
    const Real* dx = geom.CellSize();
    Real  dr = dx[0];
 
-   if (is_new == 1) {
-      MultiFab& S = get_new_data(State_Type);
-      const int nc = S.nComp();
-      Vector<Real> radial_state(numpts_1d*nc,0);
-      for (MFIter mfi(S); mfi.isValid(); ++mfi)
-      {
-         Box bx(mfi.validbox());
-         ca_compute_avgstate(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),ZFILL(dx),&dr,&nc,
-                             BL_TO_FORTRAN_ANYD(     S[mfi]),radial_state.dataPtr(),
-                             BL_TO_FORTRAN_ANYD(volume[mfi]),radial_vol.dataPtr(),
-                             ZFILL(geom.ProbLo()),&numpts_1d);
-      }
-
-      ParallelDescriptor::ReduceRealSum(radial_vol.dataPtr(),numpts_1d);
-      ParallelDescriptor::ReduceRealSum(radial_state.dataPtr(),numpts_1d*nc);
+   MultiFab& S = (is_new == 1) ? get_new_data(State_Type) : get_old_data(State_Type);
+   const int nc = S.nComp();
 
-      int first = 0;
-      int np_max = 0;
-      for (int i = 0; i < numpts_1d; i++) {
-         if (radial_vol[i] > 0.)
-         {
-            for (int j = 0; j < nc; j++) {
-              radial_state[nc*i+j] /= radial_vol[i];
-            }
-         } else if (first == 0) {
-            np_max = i;
-            first  = 1;
-         }
-      }
+   AMREX_ALWAYS_ASSERT(nc == NUM_STATE);
 
-      Vector<Real> radial_state_short(np_max*nc,0);
+   // Bin the state radially. We store the radial component of the
+   // momentum in the UMX, UMY and UMZ components for now.
 
-      for (int i = 0; i < np_max; i++) {
-         for (int j = 0; j < nc; j++) {
-           radial_state_short[nc*i+j] = radial_state[nc*i+j];
-         }
-      }
+   RadialBins bins(numpts_1d, NUM_STATE);
 
-      const Real new_time = state[State_Type].curTime();
-      set_new_outflow_data(radial_state_short.dataPtr(),&new_time,&np_max,&nc);
-   }
-   else
+   bins.accumulate<NUM_STATE>(S, geom, dr, 1, true,
+   [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, Array4<Real const> const& u,
+                              GpuArray<Real, 3> const& loc, Real* vals) noexcept
    {
-      MultiFab& S = get_old_data(State_Type);
-      const int nc = S.nComp();
-      Vector<Real> radial_state(numpts_1d*nc,0);
-      for (MFIter mfi(S); mfi.isValid(); ++mfi)
-      {
-         Box bx(mfi.validbox());
-         ca_compute_avgstate(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),ZFILL(dx),&dr,&nc,
-                             BL_TO_FORTRAN_ANYD(     S[mfi]),radial_state.dataPtr(),
-                             BL_TO_FORTRAN_ANYD(volume[mfi]),radial_vol.dataPtr(),
-                             ZFILL(geom.ProbLo()),&numpts_1d);
-      }
+       Real r = std::sqrt(loc[0] * loc[0] + loc[1] * loc[1] + loc[2] * loc[2]);
 
-      ParallelDescriptor::ReduceRealSum(radial_vol.dataPtr(),numpts_1d);
-      ParallelDescriptor::ReduceRealSum(radial_state.dataPtr(),numpts_1d*nc);
+       Real radial_mom = u(i,j,k,UMX) * (loc[0] / r) +
+                         u(i,j,k,UMY) * (loc[1] / r) +
+                         u(i,j,k,UMZ) * (loc[2] / r);
 
-      int first = 0;
-      int np_max = 0;
-      for (int i = 0; i < numpts_1d; i++) {
-         if (radial_vol[i] > 0.)
-         {
-            for (int j = 0; j < nc; j++) {
-              radial_state[nc*i+j] /= radial_vol[i];
-            }
-         } else if (first == 0) {
-            np_max = i;
-            first  = 1;
-         }
+       for (int n = 0; n < NUM_STATE; ++n) {
+           vals[n] = u(i,j,k,n);
+       }
+
+       vals[UMX] = radial_mom;
+       vals[UMY] = radial_mom;
+       vals[UMZ] = radial_mom;
+   });
+
+   bins.reduce();
+
+   // Every zone is in a bin, so the bins hold the volume of the whole
+   // domain (of the full star, if we only have an octant of it).  This
+   // catches zone volumes that are wrong for the geometry, e.g. in 1D
+   // or 2D Cartesian coordinates.
+   AMREX_ASSERT_WITH_MESSAGE(std::abs(bins.totalVolume() - RadialBins::octantFactor(geom) * volume.sum()) <=
+                             1.e-12_rt * bins.totalVolume(),
+                             "radial bins do not add up to the volume of the domain");
+
+   int np_max = 0;
+   for (int i = 0; i < numpts_1d; i++) {
+      if (bins.volume(i) == 0.) {
+         np_max = i;
+         break;
       }
+   }
 
-      Vector<Real> radial_state_short(np_max*nc,0);
+   Vector<Real> radial_state_short(np_max*nc,0);
 
-      for (int i = 0; i < np_max; i++) {
-         for (int j = 0; j < nc; j++) {
-           radial_state_short[nc*i+j] = radial_state[nc*i+j];
-         }
+   for (int i = 0; i < np_max; i++) {
+      for (int j = 0; j < nc; j++) {
+        radial_state_short[nc*i+j] = bins.average(i, j);
       }
+   }
 
+   if (is_new == 1) {
+      const Real new_time = state[State_Type].curTime();
+      set_new_outflow_data(radial_state_short.dataPtr(),&new_time,&np_max,&nc);
+   }
+   else
+   {
       const Real old_time = state[State_Type].prevTime();
       set_old_outflow_data(radial_state_short.dataPtr(),&old_time,&np_max,&nc);
    }
@@ -4533,6 +4857,7 @@ void
 Castro::expand_state(MultiFab& S, Real time, int ng)
 {
   BL_PROFILE("Castro::expand_state()");
+  telemetry::ScopedTimer telemetry_timer(level, telemetry::fillpatch);
 
   BL_ASSERT(S.nGrow() >= ng);
 
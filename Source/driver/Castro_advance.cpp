@@ -1,6 +1,8 @@
 
 #include <Castro.H>
 #include <Castro_F.H>
+#include <memory_accounting.H>
+#include <telemetry.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -127,6 +129,9 @@ Castro::initialize_do_advance(Real time)
 
     BL_PROFILE("Castro::initialize_do_advance()");
 
+    mem_acct::check(mem_acct::bytes(grids, dmap, NUM_STATE, NUM_GROW),
+                    "Sborder on level " + std::to_string(level));
+
     // Reset the CFL violation flag.
 
     cfl_violation = 0;
@@ -201,6 +206,8 @@ Castro::initialize_do_advance(Real time)
     Sborder.setVal(0.0, USHK, 1, Sborder.nGrow());
 #endif
 
+    mem_acct::sample();
+
 }
 
 
@@ -288,6 +295,10 @@ Castro::initialize_advance(Real time, Real dt, int amr_iteration, int amr_ncycle
     }
 #endif
 
+    mem_acct::check(2 * mem_acct::bytes(grids, dmap, NSRC, NUM_GROW) +
+                    mem_acct::bytes(grids, dmap, NUM_STATE, 0),
+                    "the source and update arrays on level " + std::to_string(level));
+
     // This array holds the sum of all source terms that affect the
     // hydrodynamics.
 
@@ -419,6 +430,14 @@ Castro::initialize_advance(Real time, Real dt, int amr_iteration, int amr_ncycle
     }
 #endif
 
+#ifdef MHD
+    for (int dir = 0; dir < 3; ++dir) {
+        emf[dir]->setVal(0.0);
+    }
+#endif
+
+    mem_acct::sample();
+
 }
 
 
@@ -479,6 +498,8 @@ Castro::finalize_advance()
 
     num_zones_advanced += static_cast<Real>(grids.numPts()) / getLevel(0).grids.numPts();
 
+    telemetry::add_count(level, telemetry::zones, static_cast<Real>(grids.numPts()));
+
     Real wall_time = ParallelDescriptor::second() - wall_time_start;
     Real fom_advance = grids.numPts() / wall_time / 1.e6;
 
@@ -1,6 +1,8 @@
 
 #include <Castro.H>
 #include <Castro_F.H>
+#include <memory_accounting.H>
+#include <telemetry.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -420,6 +422,8 @@ Castro::retry_advance_ctu(Real dt, advance_status status)
 
         dt_subcycle = std::min(dt, dt_subcycle) * retry_subcycle_factor;
 
+        telemetry::add_count(level, telemetry::retries, 1.0);
+
         if (verbose && ParallelDescriptor::IOProcessor()) {
             std::cout << std::endl;
             std::cout << "  Timestep " << dt << " rejected at level " << level << "." << std::endl;
@@ -432,6 +436,14 @@ Castro::retry_advance_ctu(Real dt, advance_status status)
         // be useful to us at the end of the timestep when we need
         // to restore the original old data.
 
+        if (!prev_state[State_Type]->hasOldData()) {
+            Long backup = 0;
+            for (int k = 0; k < num_state_type; k++) {
+                backup += mem_acct::bytes(state[k].oldData()) + mem_acct::bytes(state[k].newData());
+            }
+            mem_acct::check(backup, "the retry backup on level " + std::to_string(level));
+        }
+
         for (int k = 0; k < num_state_type; k++) {
 
             // We want to store the previous state in pinned memory
@@ -457,6 +469,8 @@ Castro::retry_advance_ctu(Real dt, advance_status status)
 
         }
 
+        mem_acct::sample();
+
         // Clear the contribution to the fluxes from this step.
 
         for (int dir = 0; dir < 3; ++dir) {
@@ -481,6 +495,12 @@ Castro::retry_advance_ctu(Real dt, advance_status status)
         }
 #endif
 
+#ifdef MHD
+        for (int dir = 0; dir < 3; ++dir) {
+          emf[dir]->setVal(0.0);
+        }
+#endif
+
         // For simplified SDC, we'll have garbage data if we
         // attempt to use the lagged source terms (both reacting
         // and non-reacting) from the last timestep, since that
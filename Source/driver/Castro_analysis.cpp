@@ -0,0 +1,523 @@
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+
+#include <Castro.H>
+#include <radial_bins.H>
+
+using namespace amrex;
+
+namespace {
+
+    // A host copy of the first ncomp components of fab on bx.
+
+    FArrayBox host_fab (const FArrayBox& fab, const Box& bx, int ncomp)
+    {
+#ifdef AMREX_USE_GPU
+        FArrayBox hfab(bx, ncomp, The_Pinned_Arena());
+        hfab.copy<RunOn::Device>(fab, bx, 0, bx, 0, ncomp);
+        Gpu::streamSynchronize();
+#else
+        FArrayBox hfab(bx, ncomp);
+        hfab.copy<RunOn::Host>(fab, bx, 0, bx, 0, ncomp);
+#endif
+        return hfab;
+    }
+
+    // Collect the rows of every rank on the I/O processor.
+
+    std::vector<Real> gather_rows (const std::vector<Real>& rows)
+    {
+        const int ioproc = ParallelDescriptor::IOProcessorNumber();
+        const int nprocs = ParallelDescriptor::NProcs();
+
+        int nlocal = static_cast<int>(rows.size());
+
+        std::vector<int> counts(nprocs, 0);
+        ParallelDescriptor::Gather(&nlocal, 1, counts.data(), ioproc);
+
+        std::vector<int> disps(nprocs, 0);
+        int ntotal = 0;
+        if (ParallelDescriptor::IOProcessor()) {
+            for (int p = 0; p < nprocs; ++p) {
+                disps[p] = ntotal;
+                ntotal += counts[p];
+            }
+        }
+
+        std::vector<Real> all(std::max(ntotal, 1));
+        ParallelDescriptor::Gatherv(rows.data(), nlocal, all.data(), counts, disps, ioproc);
+        all.resize(ntotal);
+
+        return all;
+    }
+
+    Vector<std::string> analysis_vars (const std::string& name)
+    {
+        Vector<std::string> vars = {"density", "Temp"};
+
+        ParmParse pp("castro");
+        if (pp.contains(name.c_str())) {
+            vars.clear();
+            pp.queryarr(name.c_str(), vars);
+        }
+
+        return vars;
+    }
+
+}
+
+
+
+bool
+Castro::analysis_due (Real cumtime, Real dtlev) const
+{
+    const int nstep = parent->levelSteps(0);
+
+    if (analysis_interval > 0 && nstep % analysis_interval == 0) {
+        return true;
+    }
+
+    if (analysis_per > 0.0) {
+
+        const int num_per_old = static_cast<int>(std::floor((cumtime - dtlev) / analysis_per));
+        const int num_per_new = static_cast<int>(std::floor((cumtime        ) / analysis_per));
+
+        if (num_per_old != num_per_new) {
+            return true;
+        }
+
+    }
+
+    return false;
+}
+
+
+
+void
+Castro::insitu_analysis ()
+{
+    BL_PROFILE("Castro::insitu_analysis()");
+
+    AMREX_ASSERT(level == 0);
+
+    const Real strt_time = ParallelDescriptor::second();
+
+    const int nstep = parent->levelSteps(0);
+    const Real time = state[State_Type].curTime();
+    const int finest_level = parent->finestLevel();
+
+    if (ParallelDescriptor::IOProcessor()) {
+        if (!amrex::UtilCreateDirectory(analysis_dir, 0755)) {
+            amrex::CreateDirectoryFailed(analysis_dir);
+        }
+    }
+    ParallelDescriptor::Barrier();
+
+    // The composite mask of each level: zero where a zone is
+    // covered by the next finer level, one elsewhere.
+
+    Vector<const MultiFab*> mask(finest_level + 1, nullptr);
+    for (int lev = 0; lev < finest_level; ++lev) {
+        mask[lev] = &getLevel(lev+1).build_fine_mask();
+    }
+
+    analysis_slices(nstep, time, mask);
+    analysis_profiles(nstep, time, mask);
+    analysis_histograms(nstep, time, mask);
+
+    if (verbose > 0)
+    {
+        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
+        Real      run_time = ParallelDescriptor::second() - strt_time;
+
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+
+        amrex::Print() << "Castro::insitu_analysis() time = " << run_time << "\n" << "\n";
+#ifdef BL_LAZY
+        });
+#endif
+    }
+}
+
+
+
+void
+Castro::analysis_slices (int nstep, Real time, const Vector<const MultiFab*>& mask)
+{
+    BL_PROFILE("Castro::analysis_slices()");
+
+    ParmParse pp("castro");
+
+    Vector<int> slice_dir;
+    Vector<Real> slice_coord;
+    pp.queryarr("analysis_slice_dir", slice_dir);
+    pp.queryarr("analysis_slice_coord", slice_coord);
+
+    if (slice_dir.empty()) {
+        return;
+    }
+
+    if (slice_dir.size() != slice_coord.size()) {
+        amrex::Error("castro.analysis_slice_dir and castro.analysis_slice_coord must have the same length");
+    }
+
+    const Vector<std::string> vars = analysis_vars("analysis_slice_vars");
+    const int nvars = vars.size();
+
+    const int finest_level = parent->finestLevel();
+
+    // Derive the variables once per level and use them for all of the slices.
+
+    Vector<MultiFab> data(finest_level + 1);
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        Castro& c = getLevel(lev);
+        data[lev].define(c.grids, c.dmap, nvars, 0);
+        for (int n = 0; n < nvars; ++n) {
+            c.derive(vars[n], time, data[lev], n);
+        }
+    }
+
+    // Each row is the level, the zone center, and the variables.
+
+    const int nrow = 1 + AMREX_SPACEDIM + nvars;
+
+    for (int s = 0; s < slice_dir.size(); ++s) {
+
+        const int dir = slice_dir[s];
+        const Real coord = slice_coord[s];
+
+        if (dir < 0 || dir >= AMREX_SPACEDIM) {
+            amrex::Error("castro.analysis_slice_dir must be between 0 and AMREX_SPACEDIM-1");
+        }
+
+        std::vector<Real> rows;
+
+        for (int lev = 0; lev <= finest_level; ++lev) {
+
+            const Geometry& lgeom = parent->Geom(lev);
+            const auto dx = lgeom.CellSizeArray();
+            const auto problo = lgeom.ProbLoArray();
+
+            const int islice = static_cast<int>(std::floor((coord - problo[dir]) / dx[dir]));
+
+            if (islice < lgeom.Domain().smallEnd(dir) || islice > lgeom.Domain().bigEnd(dir)) {
+                continue;
+            }
+
+            for (MFIter mfi(data[lev]); mfi.isValid(); ++mfi) {
+
+                Box bx = mfi.validbox();
+
+                if (islice < bx.smallEnd(dir) || islice > bx.bigEnd(dir)) {
+                    continue;
+                }
+
+                bx.setSmall(dir, islice);
+                bx.setBig(dir, islice);
+
+                FArrayBox hdat = host_fab(data[lev][mfi], bx, nvars);
+                FArrayBox hmask;
+                if (mask[lev]) {
+                    hmask = host_fab((*mask[lev])[mfi], bx, 1);
+                }
+
+                auto const d = hdat.const_array();
+                auto const m = hmask.const_array();
+                const bool masked = mask[lev] != nullptr;
+
+                amrex::LoopOnCpu(bx, [&] (int i, int j, int k)
+                {
+                    if (masked && m(i,j,k) == 0.0_rt) {
+                        return;
+                    }
+
+                    const IntVect iv(AMREX_D_DECL(i, j, k));
+
+                    rows.push_back(static_cast<Real>(lev));
+                    for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+                        rows.push_back(problo[idir] + (static_cast<Real>(iv[idir]) + 0.5_rt) * dx[idir]);
+                    }
+                    for (int n = 0; n < nvars; ++n) {
+                        rows.push_back(d(i,j,k,n));
+                    }
+                });
+            }
+        }
+
+        const std::vector<Real> all = gather_rows(rows);
+
+        if (ParallelDescriptor::IOProcessor()) {
+
+            const std::string filename = analysis_dir + "/" +
+                amrex::Concatenate("slice" + std::to_string(s) + "_", nstep, 7) + ".txt";
+
+            std::ofstream out(filename.c_str(), std::ios::out | std::ios::trunc);
+            if (!out.good()) {
+                amrex::FileOpenFailed(filename);
+            }
+
+            out << "# slice normal to direction " << dir << " at " << coord
+                << ", time = " << std::setprecision(12) << time << ", step = " << nstep << "\n";
+            out << "# level";
+            const char* coord_names[] = {"x", "y", "z"};
+            for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+                out << " " << coord_names[idir];
+            }
+            for (const auto& v : vars) {
+                out << " " << v;
+            }
+            out << "\n";
+
+            out << std::setprecision(12);
+            for (std::size_t r = 0; r < all.size(); r += nrow) {
+                out << static_cast<int>(all[r]);
+                for (int c = 1; c < nrow; ++c) {
+                    out << " " << all[r + c];
+                }
+                out << "\n";
+            }
+        }
+    }
+}
+
+
+
+void
+Castro::analysis_profiles (int nstep, Real time, const Vector<const MultiFab*>& mask)
+{
+    BL_PROFILE("Castro::analysis_profiles()");
+
+    if (analysis_profile_type == 0) {
+        return;
+    }
+
+    AMREX_ALWAYS_ASSERT(analysis_profile_type == 1 || analysis_profile_type == 2);
+
+    const bool cylindrical = analysis_profile_type == 2;
+
+    const Vector<std::string> vars = analysis_vars("analysis_profile_vars");
+    const int nvars = vars.size();
+
+    const int finest_level = parent->finestLevel();
+
+    const Real dr = analysis_profile_dr > 0.0_rt ?
+        analysis_profile_dr : parent->Geom(finest_level).CellSize(0);
+
+    // The bins extend to the farthest corner of the domain.
+
+    Real maxdist2 = 0.0_rt;
+    for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+        if (cylindrical && idir == AMREX_SPACEDIM - 1) {
+            continue;
+        }
+        const Real d = amrex::max(std::abs(geom.ProbHi(idir) - problem::center[idir]),
+                                  std::abs(geom.ProbLo(idir) - problem::center[idir]));
+        maxdist2 += d * d;
+    }
+
+    const int nbins = static_cast<int>(std::sqrt(maxdist2) / dr) + 1;
+
+    Vector<std::unique_ptr<RadialBins>> bins(nvars);
+    Vector<RadialBins*> bin_ptrs(nvars);
+    for (int n = 0; n < nvars; ++n) {
+        bins[n].reset(new RadialBins(nbins, 1, cylindrical));
+        bin_ptrs[n] = bins[n].get();
+    }
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+
+        Castro& c = getLevel(lev);
+
+        for (int n = 0; n < nvars; ++n) {
+
+            auto mf = c.derive(vars[n], time, 0);
+
+            bins[n]->accumulate<1>(*mf, parent->Geom(lev), dr, 1, false,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, Array4<Real const> const& u,
+                                       GpuArray<Real, 3> const& /*loc*/, Real* vals) noexcept
+            {
+                vals[0] = u(i,j,k,0);
+            }, mask[lev]);
+        }
+    }
+
+    RadialBins::reduce(bin_ptrs);
+
+#if defined(AMREX_DEBUG) || defined(AMREX_USE_ASSERTION)
+    // The bins reach the farthest corner of the domain, so together they
+    // hold the volume of the uncovered zones of all levels (of the full
+    // object, if we only have an octant of it).
+
+    Real domain_vol = 0.0_rt;
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        const MultiFab& vol = getLevel(lev).volume;
+        domain_vol += RadialBins::octantFactor(parent->Geom(lev)) *
+            (mask[lev] ? MultiFab::Dot(vol, 0, *mask[lev], 0, 1, 0) : vol.sum());
+    }
+
+    AMREX_ASSERT_WITH_MESSAGE(std::abs(bins[0]->totalVolume() - domain_vol) <= 1.e-12_rt * domain_vol,
+                              "radial profile bins do not add up to the volume of the domain");
+#endif
+
+    if (ParallelDescriptor::IOProcessor()) {
+
+        const std::string filename = analysis_dir + "/" +
+            amrex::Concatenate("profile_", nstep, 7) + ".txt";
+
+        std::ofstream out(filename.c_str(), std::ios::out | std::ios::trunc);
+        if (!out.good()) {
+            amrex::FileOpenFailed(filename);
+        }
+
+        out << "# " << (cylindrical ? "cylindrical" : "spherical")
+            << " volume-weighted profile, time = " << std::setprecision(12) << time
+            << ", step = " << nstep << "\n";
+        out << "# r volume";
+        for (const auto& v : vars) {
+            out << " " << v;
+        }
+        out << "\n";
+
+        out << std::setprecision(12);
+        for (int i = 0; i < nbins; ++i) {
+            if (bins[0]->volume(i) <= 0.0_rt) {
+                continue;
+            }
+            out << (static_cast<Real>(i) + 0.5_rt) * dr << " " << bins[0]->volume(i);
+            for (int n = 0; n < nvars; ++n) {
+                out << " " << bins[n]->average(i, 0);
+            }
+            out << "\n";
+        }
+    }
+}
+
+
+
+void
+Castro::analysis_histograms (int nstep, Real time, const Vector<const MultiFab*>& mask)
+{
+    BL_PROFILE("Castro::analysis_histograms()");
+
+    const int nbins = analysis_hist_nbins;
+
+    if (nbins <= 0) {
+        return;
+    }
+
+    // The quantities are log10(density), log10(T), and the mass
+    // fractions.  Zones outside the range of a histogram are
+    // counted in its first or last bin.
+
+    const int nq = 2 + NumSpec;
+
+    Vector<Real> qlo(nq, 0.0_rt);
+    Vector<Real> qhi(nq, 1.0_rt);
+    Vector<std::string> qname(nq);
+
+    qlo[0] = analysis_hist_logrho_min;
+    qhi[0] = analysis_hist_logrho_max;
+    qname[0] = "log10(density)";
+
+    qlo[1] = analysis_hist_logT_min;
+    qhi[1] = analysis_hist_logT_max;
+    qname[1] = "log10(Temp)";
+
+    for (int n = 0; n < NumSpec; ++n) {
+        qname[2+n] = desc_lst[State_Type].name(UFS+n) + " / density";
+    }
+
+    for (int q = 0; q < nq; ++q) {
+        AMREX_ALWAYS_ASSERT(qhi[q] > qlo[q]);
+    }
+
+    const Real logrho_lo = qlo[0];
+    const Real logrho_hi = qhi[0];
+    const Real logT_lo = qlo[1];
+    const Real logT_hi = qhi[1];
+
+    Gpu::ManagedVector<Real> hist(nq * nbins, 0.0_rt);
+    Real* const h = hist.dataPtr();
+
+    const int finest_level = parent->finestLevel();
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+
+        Castro& c = getLevel(lev);
+
+        const MultiFab& S = c.get_new_data(State_Type);
+
+        for (MFIter mfi(S); mfi.isValid(); ++mfi) {
+
+            const Box& bx = mfi.validbox();
+
+            auto const u = S.const_array(mfi);
+            auto const vol = c.volume.const_array(mfi);
+            auto const m = mask[lev] ? mask[lev]->const_array(mfi) : Array4<Real const>();
+
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+            {
+                Real mass = u(i,j,k,URHO) * vol(i,j,k);
+                if (m) {
+                    mass *= m(i,j,k);
+                }
+
+                if (mass == 0.0_rt) {
+                    return;
+                }
+
+                auto bin = [=] (Real x, Real lo, Real hi) -> int
+                {
+                    int b = static_cast<int>(std::floor((x - lo) / (hi - lo) * nbins));
+                    return amrex::min(amrex::max(b, 0), nbins - 1);
+                };
+
+                Gpu::Atomic::Add(&h[bin(std::log10(u(i,j,k,URHO)), logrho_lo, logrho_hi)], mass);
+                Gpu::Atomic::Add(&h[nbins + bin(std::log10(u(i,j,k,UTEMP)), logT_lo, logT_hi)], mass);
+
+                for (int n = 0; n < NumSpec; ++n) {
+                    Real X = u(i,j,k,UFS+n) / u(i,j,k,URHO);
+                    Gpu::Atomic::Add(&h[(2 + n) * nbins + bin(X, 0.0_rt, 1.0_rt)], mass);
+                }
+            });
+        }
+    }
+
+    Gpu::synchronize();
+
+    ParallelDescriptor::ReduceRealSum(hist.dataPtr(), nq * nbins,
+                                      ParallelDescriptor::IOProcessorNumber());
+
+    if (ParallelDescriptor::IOProcessor()) {
+
+        const std::string filename = analysis_dir + "/" +
+            amrex::Concatenate("histogram_", nstep, 7) + ".txt";
+
+        std::ofstream out(filename.c_str(), std::ios::out | std::ios::trunc);
+        if (!out.good()) {
+            amrex::FileOpenFailed(filename);
+        }
+
+        out << "# mass-weighted histograms, time = " << std::setprecision(12) << time
+            << ", step = " << nstep << "\n";
+
+        out << std::setprecision(12);
+        for (int q = 0; q < nq; ++q) {
+            out << "\n# " << qname[q] << "\n";
+            out << "# bin_lo bin_hi mass\n";
+            const Real width = (qhi[q] - qlo[q]) / nbins;
+            for (int b = 0; b < nbins; ++b) {
+                out << qlo[q] + b * width << " " << qlo[q] + (b + 1) * width << " "
+                    << hist[q * nbins + b] << "\n";
+            }
+        }
+    }
+}
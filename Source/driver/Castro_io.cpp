@@ -3,15 +3,22 @@
 #include <unistd.h>
 #endif
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <ctime>
 
 #include <AMReX_Utility.H>
+#include <AMReX_AsyncOut.H>
 #include <Castro.H>
 #include <Castro_F.H>
 #include <Castro_io.H>
+#include <Derive.H>
+#include <plotfile_compression.H>
+#include <checkpoint_staging.H>
+#include <telemetry.H>
 #include <AMReX_ParmParse.H>
 
 #ifdef RADIATION
@@ -59,6 +66,39 @@ namespace
 {
     int input_version = -1;
     int current_version = 9;
+
+    // Write contents to the file at path.  With asynchronous output
+    // (amrex.async_out = 1) the write is queued on the AsyncOut
+    // background thread, behind the MultiFab data of the same output,
+    // so the caller does not wait on the file system.
+
+    void write_output_file (const std::string& path, std::string&& contents)
+    {
+        auto f = [path, c = std::move(contents)] ()
+        {
+            std::ofstream ofs(path.c_str(), std::ios::out);
+            ofs << c;
+            ofs.close();
+        };
+
+        if (AsyncOut::UseAsyncOut()) {
+            AsyncOut::Submit(std::move(f));
+        } else {
+            f();
+        }
+    }
+
+    // With asynchronous output, wait for the previous output to drain
+    // before staging a new one, so that at most one output's worth of
+    // data is held in the staging buffers at a time.
+
+    void finish_previous_output ()
+    {
+        if (AsyncOut::UseAsyncOut()) {
+            BL_PROFILE("Castro::finish_previous_output()");
+            AsyncOut::Finish();
+        }
+    }
 }
 
 // I/O routines for Castro
@@ -149,6 +189,8 @@ Castro::restart (Amr&     papa,
 
     initMFs();
 
+    watch_memory();
+
     // get the elapsed CPU time to now;
     if (level == 0 && ParallelDescriptor::IOProcessor())
     {
@@ -401,15 +443,38 @@ Castro::checkPoint(const std::string& dir,
                    bool /*dump_old_default*/)
 {
 
+  telemetry::ScopedTimer telemetry_timer(level, telemetry::io);
+
+  if (level == 0) {
+      finish_previous_output();
+  }
+
+  // With staged checkpointing, everything but the Amr Header and the
+  // particles is written to the node-local staging directory.
+
+  const bool staged = !checkpoint_stage_dir.empty();
+
+  if (staged && level == 0) {
+      chk_stage::begin(checkpoint_stage_dir, dir, parent->finestLevel());
+  }
+
+  const std::string out_dir = staged ? chk_stage::staged_path(checkpoint_stage_dir, dir) : dir;
+
   const Real io_start_time = ParallelDescriptor::second();
 
-  AmrLevel::checkPoint(dir, os, how, dump_old);
+  AmrLevel::checkPoint(out_dir, os, how, dump_old);
 
   const Real io_time = ParallelDescriptor::second() - io_start_time;
 
 #ifdef RADIATION
   if (do_radiation) {
-    radiation->checkPoint(level, dir, os, how);
+    radiation->checkPoint(level, out_dir, os, how);
+  }
+#endif
+
+#ifdef GRAVITY
+  if (do_grav && gravity::checkpoint_grad_phi && gravity->get_gravity_type() == "PoissonGrav") {
+    gravity->write_grad_phi(level, out_dir, how);
   }
 #endif
 
@@ -420,26 +485,18 @@ Castro::checkPoint(const std::string& dir,
   if (level == 0 && ParallelDescriptor::IOProcessor())
     {
         {
-            std::ofstream CastroHeaderFile;
-            std::string FullPathCastroHeaderFile = dir;
-            FullPathCastroHeaderFile += "/CastroHeader";
-            CastroHeaderFile.open(FullPathCastroHeaderFile.c_str(), std::ios::out);
-
-            CastroHeaderFile << "Checkpoint version: " << current_version << std::endl;
-            CastroHeaderFile.close();
+            std::ostringstream CastroHeader;
+            CastroHeader << "Checkpoint version: " << current_version << std::endl;
+            write_output_file(out_dir + "/CastroHeader", CastroHeader.str());
 
-            writeJobInfo(dir, io_time);
+            writeJobInfo(out_dir, io_time);
 
             // output the list of state variables, so we can do a sanity check on restart
-            std::ofstream StateListFile;
-            std::string FullPathStateList = dir;
-            FullPathStateList += "/state_names.txt";
-            StateListFile.open(FullPathStateList.c_str(), std::ios::out);
-
+            std::ostringstream StateList;
             for (int n = 0; n < NUM_STATE; n++) {
-              StateListFile << desc_lst[State_Type].name(n) << "\n";
+              StateList << desc_lst[State_Type].name(n) << "\n";
             }
-            StateListFile.close();
+            write_output_file(out_dir + "/state_names.txt", StateList.str());
         }
 
         // If we have limited this last timestep to hit a plot interval,
@@ -449,49 +506,40 @@ Castro::checkPoint(const std::string& dir,
 
         if (lastDtPlotLimited == 1) {
 
-            std::ofstream dtHeaderFile;
-            std::string FullPathdtHeaderFile = dir;
-            FullPathdtHeaderFile += "/dtHeader";
-            dtHeaderFile.open(FullPathdtHeaderFile.c_str(), std::ios::out);
-
-            dtHeaderFile << lastDtBeforePlotLimiting << std::endl;
-            dtHeaderFile.close();
+            std::ostringstream dtHeader;
+            dtHeader << lastDtBeforePlotLimiting << std::endl;
+            write_output_file(out_dir + "/dtHeader", dtHeader.str());
 
         }
 
         {
             // store elapsed CPU time
-            std::ofstream CPUFile;
-            std::string FullPathCPUFile = dir;
-            FullPathCPUFile += "/CPUtime";
-            CPUFile.open(FullPathCPUFile.c_str(), std::ios::out);
-
-            CPUFile << std::setprecision(17) << getCPUTime();
-            CPUFile.close();
+            std::ostringstream CPUtime;
+            CPUtime << std::setprecision(17) << getCPUTime();
+            write_output_file(out_dir + "/CPUtime", CPUtime.str());
         }
 
 #ifdef GRAVITY
         if (use_point_mass) {
 
             // store current value of the point mass
-            std::ofstream PMFile;
-            std::string FullPathPMFile = dir;
-            FullPathPMFile += "/point_mass";
-            PMFile.open(FullPathPMFile.c_str(), std::ios::out);
-
-            PMFile << std::setprecision(17) << point_mass << std::endl;
-
-            PMFile.close();
+            std::ostringstream PM;
+            PM << std::setprecision(17) << point_mass << std::endl;
+            write_output_file(out_dir + "/point_mass", PM.str());
 
         }
 #endif
 
         {
             // store any problem-specific stuff
-            problem_checkpoint(dir);
+            problem_checkpoint(out_dir);
         }
     }
 
+  if (staged && level == parent->finestLevel()) {
+      chk_stage::end();
+  }
+
 }
 
 std::string
@@ -920,6 +968,12 @@ Castro::plotFileOutput(const std::string& dir,
                        VisMF::How how,
                        const int is_small)
 {
+    telemetry::ScopedTimer telemetry_timer(level, telemetry::io);
+
+    if (level == 0) {
+        finish_previous_output();
+    }
+
 #ifdef AMREX_PARTICLES
   ParticlePlotFile(dir);
 #endif
@@ -975,6 +1029,38 @@ Castro::plotFileOutput(const std::string& dir,
 
     Real cur_time = state[State_Type].curTime();
 
+    //
+    // Names of variables -- first state, then derived
+    //
+    Vector<std::string> plot_names;
+    plot_names.reserve(n_data_items);
+
+    for (int i =0; i < plot_var_map.size(); i++)
+    {
+        int typ = plot_var_map[i].first;
+        int comp = plot_var_map[i].second;
+        plot_names.push_back(desc_lst[typ].name(comp));
+    }
+
+    for (auto it = derive_names.begin(); it != derive_names.end(); ++it)
+    {
+        const DeriveRec* rec = derive_lst.get(*it);
+        if (rec->numDerive() > 1) {
+            for (int i = 0; i < rec->numDerive(); ++i) {
+                plot_names.push_back(rec->variableName(0) + '_' + std::to_string(i));
+            }
+        }
+        else {
+            plot_names.push_back(rec->variableName(0));
+        }
+    }
+
+#ifdef RADIATION
+    for (int i=0; i<Radiation::nplotvar; ++i) {
+        plot_names.push_back(Radiation::plotvar_names[i]);
+    }
+#endif
+
     if (level == 0 && ParallelDescriptor::IOProcessor())
     {
         //
@@ -988,35 +1074,10 @@ Castro::plotFileOutput(const std::string& dir,
 
         os << n_data_items << '\n';
 
-        //
-        // Names of variables -- first state, then derived
-        //
-        for (int i =0; i < plot_var_map.size(); i++)
-        {
-            int typ = plot_var_map[i].first;
-            int comp = plot_var_map[i].second;
-            os << desc_lst[typ].name(comp) << '\n';
+        for (const auto& name : plot_names) {
+            os << name << '\n';
         }
 
-        for (auto it = derive_names.begin(); it != derive_names.end(); ++it)
-        {
-            const DeriveRec* rec = derive_lst.get(*it);
-            if (rec->numDerive() > 1) {
-                for (int i = 0; i < rec->numDerive(); ++i) {
-                    os << rec->variableName(0) + '_' + std::to_string(i) + '\n';
-                }
-            }
-            else {
-                os << rec->variableName(0) << '\n';
-            }
-        }
-
-#ifdef RADIATION
-        for (int i=0; i<Radiation::nplotvar; ++i) {
-          os << Radiation::plotvar_names[i] << '\n';
-        }
-#endif
-
         os << BL_SPACEDIM << '\n';
         os << parent->cumTime() << '\n';
         int f_lev = parent->finestLevel();
@@ -1137,15 +1198,37 @@ Castro::plotFileOutput(const std::string& dir,
         cnt++;
     }
     //
-    // Cull data from derived variables.
+    // Cull data from derived variables.  The thermodynamic ones are
+    // evaluated together below, so that we only call the EOS once
+    // per zone for all of them.
     //
+    Vector<std::string> thermo_names;
+    Vector<int> thermo_comps;
+
     if (dlist.size() > 0)
     {
+        int n_thermo = 0;
+        for (auto it = dlist.begin(); it != dlist.end(); ++it)
+        {
+            if (((parent->isDerivePlotVar(it->name()) && is_small == 0) ||
+                 (parent->isDeriveSmallPlotVar(it->name()) && is_small == 1)) &&
+                thermo_derive::index(it->name()) >= 0) {
+                n_thermo++;
+            }
+        }
+
         for (auto it = dlist.begin(); it != dlist.end(); ++it)
         {
             if ((parent->isDerivePlotVar(it->name()) && is_small == 0) || 
                 (parent->isDeriveSmallPlotVar(it->name()) && is_small == 1)) {
 
+                if (n_thermo > 1 && thermo_derive::index(it->name()) >= 0) {
+                    thermo_names.push_back(it->name());
+                    thermo_comps.push_back(cnt);
+                    cnt++;
+                    continue;
+                }
+
                 auto derive_dat = derive(it->variableName(0), cur_time, nGrow);
                 MultiFab::Copy(plotMF, *derive_dat, 0, cnt, it->numDerive(), nGrow);
                 cnt = cnt + it->numDerive();
@@ -1154,6 +1237,10 @@ Castro::plotFileOutput(const std::string& dir,
         }
     }
 
+    if (thermo_names.size() > 0) {
+        derive_thermo_group(thermo_names, cur_time, plotMF, thermo_comps);
+    }
+
 #ifdef RADIATION
     if (Radiation::nplotvar > 0) {
         MultiFab::Copy(plotMF,*(radiation->plotvar[level]),0,cnt,Radiation::nplotvar,0);
@@ -1169,7 +1256,30 @@ Castro::plotFileOutput(const std::string& dir,
 
     const Real io_start_time = ParallelDescriptor::second();
 
-    if (amrex::AsyncOut::UseAsyncOut()) {
+    if (plot_compression == 1) {
+
+        // Variables we must store exactly; everything else is
+        // rounded to a relative error of plot_compression_rtol.
+
+        Vector<std::string> lossless_vars = {"density", "rho_E", "rho_e"};
+        ParmParse pp("castro");
+        if (pp.contains("plot_compression_lossless_vars")) {
+            lossless_vars.clear();
+            pp.queryarr("plot_compression_lossless_vars", lossless_vars);
+        }
+
+        const int lossy_bits = plt_compress::mantissa_bits(plot_compression_rtol);
+
+        Vector<int> keep_bits(n_data_items, lossy_bits);
+        for (int n = 0; n < n_data_items; ++n) {
+            if (std::find(lossless_vars.begin(), lossless_vars.end(), plot_names[n]) != lossless_vars.end()) {
+                keep_bits[n] = plt_compress::lossless;
+            }
+        }
+
+        plt_compress::write_level(plotMF, keep_bits, TheFullPath);
+
+    } else if (amrex::AsyncOut::UseAsyncOut()) {
         VisMF::AsyncWrite(std::move(plotMF),TheFullPath);
     } else {
         VisMF::Write(plotMF,TheFullPath,how,true);
@@ -1182,17 +1292,12 @@ Castro::plotFileOutput(const std::string& dir,
     }
 
 #ifdef GRAVITY
-    if (use_point_mass && level == 0) {
+    if (use_point_mass && level == 0 && ParallelDescriptor::IOProcessor()) {
 
         // store current value of the point mass
-        std::ofstream PMFile;
-        std::string FullPathPMFile = dir;
-        FullPathPMFile += "/point_mass";
-        PMFile.open(FullPathPMFile.c_str(), std::ios::out);
-
-        PMFile << std::setprecision(17) << point_mass << std::endl;
-
-        PMFile.close();
+        std::ostringstream PM;
+        PM << std::setprecision(17) << point_mass << std::endl;
+        write_output_file(dir + "/point_mass", PM.str());
 
     }
 #endif
@@ -334,11 +334,7 @@ Castro::variableSetUp ()
   ca_read_sponge_params(probin_file_name.dataPtr(),&probin_file_length);
 
   // bring the sponge parameters into C++
-  ca_get_sponge_params(sponge_lower_factor, sponge_upper_factor,
-                       sponge_lower_radius, sponge_upper_radius,
-                       sponge_lower_density, sponge_upper_density,
-                       sponge_lower_pressure, sponge_upper_pressure,
-                       sponge_target_velocity, sponge_timescale);
+  get_sponge_params();
 
 #endif
 
@@ -382,21 +378,24 @@ Castro::variableSetUp ()
                          interp,state_data_extrap,store_in_checkpoint);
 
 #ifdef MHD
+  // The face-centered field is interpolated linearly in the normal
+  // direction and is constant across the face, which keeps it divergence
+  // free (see Castro::correct_B_regrid_seams for where it meets old data).
   store_in_checkpoint = true;
   IndexType xface(IntVect{AMREX_D_DECL(1,0,0)});
   desc_lst.addDescriptor(Mag_Type_x, xface,
                          StateDescriptor::Point, 0, 1, 
-                         interp, state_data_extrap,
+                         &face_linear_interp, state_data_extrap,
                          store_in_checkpoint);
   IndexType yface(IntVect{AMREX_D_DECL(0,1,0)});
   desc_lst.addDescriptor(Mag_Type_y, yface,
                          StateDescriptor::Point, 0, 1,
-                         interp, state_data_extrap,
+                         &face_linear_interp, state_data_extrap,
                          store_in_checkpoint);
   IndexType zface(IntVect{AMREX_D_DECL(0,0,1)});
   desc_lst.addDescriptor(Mag_Type_z, zface,
                          StateDescriptor::Point, 0, 1,
-                         interp, state_data_extrap,
+                         &face_linear_interp, state_data_extrap,
                          store_in_checkpoint);
 #endif
 
@@ -589,9 +588,19 @@ Castro::variableSetUp ()
 
 #ifdef MHD
   set_mag_field_bc(bc, phys_bc);
-  desc_lst.setComponent(Mag_Type_x, 0, "b_x", bc, BndryFunc(ca_face_fillx));
-  desc_lst.setComponent(Mag_Type_y, 0, "b_y", bc, BndryFunc(ca_face_filly));
-  desc_lst.setComponent(Mag_Type_z, 0, "b_z", bc, BndryFunc(ca_face_fillz));
+
+  BndryFunc faceBndryFunc_x(ca_face_fillx);
+  faceBndryFunc_x.setRunOnGPU(true);
+
+  BndryFunc faceBndryFunc_y(ca_face_filly);
+  faceBndryFunc_y.setRunOnGPU(true);
+
+  BndryFunc faceBndryFunc_z(ca_face_fillz);
+  faceBndryFunc_z.setRunOnGPU(true);
+
+  desc_lst.setComponent(Mag_Type_x, 0, "b_x", bc, faceBndryFunc_x);
+  desc_lst.setComponent(Mag_Type_y, 0, "b_y", bc, faceBndryFunc_y);
+  desc_lst.setComponent(Mag_Type_z, 0, "b_z", bc, faceBndryFunc_z);
 #endif
 
 
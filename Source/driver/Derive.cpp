@@ -1261,3 +1261,143 @@ extern "C"
 #ifdef __cplusplus
 }
 #endif
+
+namespace thermo_derive {
+
+  int index (const std::string& name)
+  {
+    static const std::string names[nvar] = {"pressure", "soundspeed", "Gamma_1", "MachNumber",
+                                            "uplusc", "uminusc", "entropy",
+                                            "t_sound_t_enuc", "thermal_cond", "diff_coeff"};
+
+    for (int n = 0; n < nvar; n++) {
+      if (name == names[n]) {
+        return n;
+      }
+    }
+
+    return -1;
+  }
+
+}
+
+void ca_derthermo(const Box& bx, Array4<Real> const& der,
+                  Array4<Real const> const& dat,
+                  Array4<Real const> const& enuc,
+                  const GpuArray<int, thermo_derive::nvar>& comp,
+                  Real dd)
+{
+
+  using namespace thermo_derive;
+
+  // Everything other than the diffusion coefficients needs the
+  // (rho, e) EOS call, even in zones where e < 0.
+
+  bool need_re = false;
+  for (int n = 0; n < t_sound_t_enuc + 1; n++) {
+    if (comp[n] >= 0) {
+      need_re = true;
+    }
+  }
+
+  amrex::ParallelFor(bx,
+  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+  {
+
+    Real rhoInv = 1.0_rt / dat(i,j,k,URHO);
+
+    eos_t eos_state;
+    eos_state.rho  = dat(i,j,k,URHO);
+    eos_state.T = dat(i,j,k,UTEMP);
+    eos_state.e = dat(i,j,k,UEINT) * rhoInv;
+    for (int n = 0; n < NumSpec; n++) {
+      eos_state.xn[n] = dat(i,j,k,UFS+n) * rhoInv;
+    }
+#if NAUX_NET > 0
+    for (int n = 0; n < NumAux; n++) {
+      eos_state.aux[n] = dat(i,j,k,UFX+n) * rhoInv;
+    }
+#endif
+
+#ifdef DIFFUSION
+    // the conductivity uses (rho, T) with T = small_temp if e < 0
+    eos_t cond_state = eos_state;
+    const bool cond_rt = eos_state.e < 0.0_rt;
+#endif
+
+    if (need_re) {
+      eos(eos_input_re, eos_state);
+    }
+
+    if (comp[pressure] >= 0) {
+      der(i,j,k,comp[pressure]) = eos_state.p;
+    }
+
+    if (comp[soundspeed] >= 0) {
+      der(i,j,k,comp[soundspeed]) = eos_state.cs;
+    }
+
+    if (comp[Gamma_1] >= 0) {
+      der(i,j,k,comp[Gamma_1]) = eos_state.gam1;
+    }
+
+    if (comp[MachNumber] >= 0) {
+      der(i,j,k,comp[MachNumber]) = std::sqrt(dat(i,j,k,UMX)*dat(i,j,k,UMX) +
+                                              dat(i,j,k,UMY)*dat(i,j,k,UMY) +
+                                              dat(i,j,k,UMZ)*dat(i,j,k,UMZ)) /
+        dat(i,j,k,URHO) / eos_state.cs;
+    }
+
+    if (comp[uplusc] >= 0) {
+      der(i,j,k,comp[uplusc]) = dat(i,j,k,UMX) / dat(i,j,k,URHO) + eos_state.cs;
+    }
+
+    if (comp[uminusc] >= 0) {
+      der(i,j,k,comp[uminusc]) = dat(i,j,k,UMX) / dat(i,j,k,URHO) - eos_state.cs;
+    }
+
+    if (comp[entropy] >= 0) {
+      der(i,j,k,comp[entropy]) = eos_state.s;
+    }
+
+#ifdef REACTIONS
+    if (comp[t_sound_t_enuc] >= 0) {
+      Real enuc_spec = std::abs(enuc(i,j,k)) / dat(i,j,k,URHO);
+
+      if (enuc_spec > 1.e-100_rt) {
+        Real t_e = eos_state.e / enuc_spec;
+        Real t_s = dd / eos_state.cs;
+
+        der(i,j,k,comp[t_sound_t_enuc]) = t_s/t_e;
+      } else {
+        der(i,j,k,comp[t_sound_t_enuc]) = 0.0_rt;
+      }
+    }
+#endif
+
+#ifdef DIFFUSION
+    if (comp[thermal_cond] >= 0 || comp[diff_coeff] >= 0) {
+
+      if (cond_rt) {
+        cond_state.T = castro::small_temp;
+        eos(eos_input_rt, cond_state);
+      } else if (need_re) {
+        cond_state = eos_state;
+      } else {
+        eos(eos_input_re, cond_state);
+      }
+
+      Real cond = diffusion_conductivity(cond_state);
+
+      if (comp[thermal_cond] >= 0) {
+        der(i,j,k,comp[thermal_cond]) = cond;
+      }
+
+      if (comp[diff_coeff] >= 0) {
+        der(i,j,k,comp[diff_coeff]) = cond * rhoInv / cond_state.cv;
+      }
+    }
+#endif
+
+  });
+}
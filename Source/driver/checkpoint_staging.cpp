@@ -0,0 +1,393 @@
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <AMReX_AsyncOut.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+#include <AMReX_VisMF.H>
+
+#include <checkpoint_staging.H>
+
+using namespace amrex;
+
+namespace {
+
+    // Staged checkpoint being written (between begin and end), and the
+    // one waiting for its copy to start (between end and start_copy).
+
+    std::string writing_src, writing_dst;
+    std::string staged_src, staged_dst;
+
+    // Copy in flight.
+
+    std::string copying_src, copying_dst;
+    std::thread copy_thread;
+    std::atomic<bool> copy_done{true};
+    bool copy_ok = true;
+
+    int saved_nfiles = -1;
+
+    int node_leader = -1;
+
+    // Amr writes the checkpoint to <name>.temp and renames it when done.
+
+    std::string final_name (const std::string& dir)
+    {
+        const std::string suffix = ".temp";
+        std::string name = dir;
+        while (name.size() > 1 && name.back() == '/') {
+            name.pop_back();
+        }
+        if (name.size() > suffix.size() &&
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            name.erase(name.size() - suffix.size());
+        }
+        return name;
+    }
+
+    std::string base_name (const std::string& path)
+    {
+        const auto pos = path.find_last_of('/');
+        return pos == std::string::npos ? path : path.substr(pos + 1);
+    }
+
+    std::string dir_name (const std::string& path)
+    {
+        const auto pos = path.find_last_of('/');
+        if (pos == std::string::npos) {
+            return ".";
+        }
+        return pos == 0 ? "/" : path.substr(0, pos);
+    }
+
+    // One rank per node (sharing the node-local file system) does the copy.
+
+    bool is_node_leader ()
+    {
+        if (node_leader < 0) {
+#ifdef BL_USE_MPI
+            MPI_Comm node_comm;
+            MPI_Comm_split_type(ParallelDescriptor::Communicator(), MPI_COMM_TYPE_SHARED,
+                                ParallelDescriptor::MyProc(), MPI_INFO_NULL, &node_comm);
+            int node_rank;
+            MPI_Comm_rank(node_comm, &node_rank);
+            MPI_Comm_free(&node_comm);
+            node_leader = (node_rank == 0);
+#else
+            node_leader = 1;
+#endif
+        }
+        return node_leader == 1;
+    }
+
+    // The file system helpers below run on the copy thread, so they
+    // only use POSIX calls and report failure by their return value.
+
+    bool make_dirs (const std::string& path)
+    {
+        std::string partial;
+        std::istringstream is(path);
+        std::string part;
+        if (!path.empty() && path[0] == '/') {
+            partial = "/";
+        }
+        while (std::getline(is, part, '/')) {
+            if (part.empty()) {
+                continue;
+            }
+            partial += part;
+            if (::mkdir(partial.c_str(), 0755) != 0 && errno != EEXIST) {
+                return false;
+            }
+            partial += "/";
+        }
+        return true;
+    }
+
+    bool copy_file (const std::string& src, const std::string& dst)
+    {
+        std::ifstream in(src, std::ios::binary);
+        std::ofstream out(dst, std::ios::binary | std::ios::trunc);
+        if (!in || !out) {
+            return false;
+        }
+        out << in.rdbuf();
+        out.close();
+        return !out.fail();
+    }
+
+    // Move the tree src into dst, file by file, so that the node-local
+    // space is released as we go.
+
+    bool move_tree (const std::string& src, const std::string& dst)
+    {
+        if (!make_dirs(dst)) {
+            return false;
+        }
+
+        DIR* d = ::opendir(src.c_str());
+        if (d == nullptr) {
+            return false;
+        }
+
+        bool ok = true;
+
+        while (struct dirent* e = ::readdir(d)) {
+            const std::string name = e->d_name;
+            if (name == "." || name == "..") {
+                continue;
+            }
+
+            const std::string s = src + "/" + name;
+            const std::string t = dst + "/" + name;
+
+            struct stat st;
+            if (::stat(s.c_str(), &st) != 0) {
+                ok = false;
+                continue;
+            }
+
+            if (S_ISDIR(st.st_mode)) {
+                ok = move_tree(s, t) && ok;
+            } else if (copy_file(s, t)) {
+                ::unlink(s.c_str());
+            } else {
+                ok = false;
+            }
+        }
+
+        ::closedir(d);
+        ::rmdir(src.c_str());
+
+        return ok;
+    }
+
+    void remove_tree (const std::string& path)
+    {
+        DIR* d = ::opendir(path.c_str());
+        if (d == nullptr) {
+            ::unlink(path.c_str());
+            return;
+        }
+
+        while (struct dirent* e = ::readdir(d)) {
+            const std::string name = e->d_name;
+            if (name != "." && name != "..") {
+                remove_tree(path + "/" + name);
+            }
+        }
+
+        ::closedir(d);
+        ::rmdir(path.c_str());
+    }
+
+    // Append a completely copied checkpoint to the manifest.  The new
+    // manifest is written next to the old one and renamed over it, so the
+    // manifest is never seen partially written.
+
+    void record (const std::string& chk)
+    {
+        const std::string manifest = dir_name(chk) + "/checkpoint_manifest";
+
+        std::string contents;
+        {
+            std::ifstream in(manifest);
+            if (in) {
+                std::ostringstream ss;
+                ss << in.rdbuf();
+                contents = ss.str();
+            }
+        }
+
+        const std::string tmp = manifest + ".new";
+        {
+            std::ofstream out(tmp, std::ios::trunc);
+            out << contents << chk << "\n";
+        }
+
+        if (std::rename(tmp.c_str(), manifest.c_str()) != 0) {
+            amrex::Warning("unable to update the checkpoint manifest " + manifest);
+        }
+    }
+
+    void start_copy ()
+    {
+        if (staged_src.empty()) {
+            return;
+        }
+
+        // Make sure that Amr is done with the checkpoint directory on
+        // every rank before we start filling it in.
+
+        ParallelDescriptor::Barrier();
+
+        copying_src = staged_src;
+        copying_dst = staged_dst;
+        staged_src.clear();
+        staged_dst.clear();
+
+        copy_ok = true;
+
+        if (is_node_leader()) {
+            copy_done = false;
+            copy_thread = std::thread([src = copying_src, dst = copying_dst] ()
+            {
+                copy_ok = move_tree(src, dst);
+                copy_done = true;
+            });
+        } else {
+            copy_done = true;
+        }
+    }
+
+    // Finish the copy in flight if every node is done with it (or, with
+    // wait = true, once every node is done with it).  Returns false if
+    // the copy is still going.
+
+    bool complete_copy (bool wait)
+    {
+        if (copying_dst.empty()) {
+            return true;
+        }
+
+        if (!wait) {
+            int done = copy_done ? 1 : 0;
+            ParallelDescriptor::ReduceIntMin(done);
+            if (!done) {
+                return false;
+            }
+        }
+
+        if (copy_thread.joinable()) {
+            copy_thread.join();
+        }
+
+        int ok = copy_ok ? 1 : 0;
+        ParallelDescriptor::ReduceIntMin(ok);
+
+        if (ParallelDescriptor::IOProcessor()) {
+            if (ok) {
+                record(copying_dst);
+                std::cout << "Staged checkpoint " << copying_dst << " is complete" << std::endl;
+            } else {
+                std::cout << "Warning: copying the staged checkpoint " << copying_dst
+                          << " failed; it is not recorded in the manifest" << std::endl;
+            }
+        }
+
+        copying_src.clear();
+        copying_dst.clear();
+
+        return true;
+    }
+
+}
+
+namespace chk_stage
+{
+
+std::string
+staged_path (const std::string& stage_root, const std::string& dir)
+{
+    return stage_root + "/" + base_name(final_name(dir));
+}
+
+void
+begin (const std::string& stage_root, const std::string& dir, int finest_level)
+{
+    BL_PROFILE("chk_stage::begin()");
+
+    if (AsyncOut::UseAsyncOut()) {
+        amrex::Abort("castro.checkpoint_stage_dir cannot be combined with amrex.async_out");
+    }
+
+    // Only one checkpoint at a time in the staging area.
+
+    finish();
+
+    writing_src = staged_path(stage_root, dir);
+    writing_dst = final_name(dir);
+
+    if (is_node_leader()) {
+        remove_tree(writing_src);
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            const std::string level_dir = writing_src + "/Level_" + std::to_string(lev);
+            if (!amrex::UtilCreateDirectory(level_dir, 0755)) {
+                amrex::CreateDirectoryFailed(level_dir);
+            }
+        }
+    }
+
+    ParallelDescriptor::Barrier();
+
+    // With one file per rank, the files on each node's staging area are
+    // complete by themselves.
+
+    saved_nfiles = VisMF::GetNOutFiles();
+    VisMF::SetNOutFiles(ParallelDescriptor::NProcs());
+}
+
+void
+end ()
+{
+    VisMF::SetNOutFiles(saved_nfiles);
+
+    ParallelDescriptor::Barrier();
+
+    staged_src = writing_src;
+    staged_dst = writing_dst;
+    writing_src.clear();
+    writing_dst.clear();
+}
+
+void
+poll ()
+{
+    if (complete_copy(false)) {
+        start_copy();
+    }
+}
+
+void
+finish ()
+{
+    BL_PROFILE("chk_stage::finish()");
+
+    complete_copy(true);
+    start_copy();
+    complete_copy(true);
+}
+
+std::string
+latest (const std::string& manifest)
+{
+    if (!amrex::FileExists(manifest)) {
+        return std::string();
+    }
+
+    Vector<char> buf;
+    ParallelDescriptor::ReadAndBcastFile(manifest, buf);
+
+    std::istringstream is(std::string(buf.dataPtr()));
+
+    std::string line, chk;
+    while (std::getline(is, line)) {
+        if (!line.empty()) {
+            chk = line;
+        }
+    }
+
+    return chk;
+}
+
+}
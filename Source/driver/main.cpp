@@ -27,6 +27,7 @@
 
 #include <Castro.H>
 #include <Castro_io.H>
+#include <checkpoint_staging.H>
 
 using namespace amrex;
 
@@ -122,6 +123,26 @@ main (int   argc,
     // Initialize random seed after we're running in parallel.
     //
 
+    // If requested, restart from the newest checkpoint that a staged
+    // checkpoint copy has completely written to its destination.
+
+    {
+        ParmParse ppc("castro");
+        ParmParse ppa("amr");
+        std::string manifest;
+        if (ppc.query("restart_from_manifest", manifest) && !manifest.empty() &&
+            !ppa.contains("restart"))
+        {
+            const std::string chk = chk_stage::latest(manifest);
+            if (!chk.empty()) {
+                ppa.add("restart", chk);
+                amrex::Print() << "Restarting from " << chk << " (from " << manifest << ")" << std::endl;
+            } else {
+                amrex::Print() << "No checkpoint recorded in " << manifest << ", starting from scratch" << std::endl;
+            }
+        }
+    }
+
     Amr* amrptr = new Amr;
 
     amrptr->init(strt_time,stop_time);
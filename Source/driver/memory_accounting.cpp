@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+#include <AMReX_BLProfiler.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+
+#include <memory_accounting.H>
+
+using namespace amrex;
+
+namespace {
+
+    const char* owner_names[mem_acct::NumOwners] =
+        {"state", "hydro", "sources", "fluxes", "retry", "sdc", "gravity", "radiation"};
+
+    struct Watch
+    {
+        const void* key;
+        int lev;
+        mem_acct::Owner owner;
+        std::function<Long()> f;
+    };
+
+    std::vector<Watch> watches;
+
+    // Bytes held on this rank at the last sample, and the high-water
+    // marks, per level and subsystem.
+
+    std::vector<std::vector<Long>> current;
+    std::vector<std::vector<Long>> peak;
+
+    Long current_total = 0;
+    Long peak_total = 0;
+
+    bool enabled = false;
+
+    Real budget = 0.0;
+    bool over_budget = false;
+
+    void grow (int lev)
+    {
+        if (lev >= static_cast<int>(current.size())) {
+            current.resize(lev + 1, std::vector<Long>(mem_acct::NumOwners, 0));
+            peak.resize(lev + 1, std::vector<Long>(mem_acct::NumOwners, 0));
+        }
+    }
+
+    double to_MB (Long n)
+    {
+        return static_cast<double>(n) / (1024.0 * 1024.0);
+    }
+
+}
+
+namespace mem_acct
+{
+
+Long
+bytes (const MultiFab& mf)
+{
+    if (mf.size() == 0) {
+        return 0;
+    }
+
+    Long n = 0;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        n += static_cast<Long>(mf[mfi].nBytes());
+    }
+    return n;
+}
+
+Long
+bytes (const Vector<std::unique_ptr<MultiFab>>& mfs, int start)
+{
+    Long n = 0;
+    for (int i = start; i < static_cast<int>(mfs.size()); ++i) {
+        if (mfs[i]) {
+            n += bytes(*mfs[i]);
+        }
+    }
+    return n;
+}
+
+Long
+bytes (const BoxArray& ba, const DistributionMapping& dm, int ncomp, int ngrow)
+{
+    const int myproc = ParallelDescriptor::MyProc();
+
+    Long n = 0;
+    for (int i = 0; i < static_cast<int>(ba.size()); ++i) {
+        if (dm[i] == myproc) {
+            n += amrex::grow(ba[i], ngrow).numPts();
+        }
+    }
+    return n * ncomp * static_cast<Long>(sizeof(Real));
+}
+
+void
+watch (const void* key, int lev, Owner o, std::function<Long()> f)
+{
+    for (auto& w : watches) {
+        if (w.key == key && w.lev == lev && w.owner == o) {
+            w.f = std::move(f);
+            return;
+        }
+    }
+    watches.push_back({key, lev, o, std::move(f)});
+}
+
+void
+unwatch (const void* key)
+{
+    watches.erase(std::remove_if(watches.begin(), watches.end(),
+                                 [=] (const Watch& w) { return w.key == key; }),
+                  watches.end());
+}
+
+void
+sample ()
+{
+    if (!enabled) {
+        return;
+    }
+
+    for (auto& c : current) {
+        std::fill(c.begin(), c.end(), 0);
+    }
+
+    current_total = 0;
+
+    for (const auto& w : watches) {
+        grow(w.lev);
+        const Long n = w.f();
+        current[w.lev][w.owner] += n;
+        current_total += n;
+    }
+
+    for (int lev = 0; lev < static_cast<int>(current.size()); ++lev) {
+        for (int o = 0; o < NumOwners; ++o) {
+            peak[lev][o] = std::max(peak[lev][o], current[lev][o]);
+        }
+    }
+
+    peak_total = std::max(peak_total, current_total);
+}
+
+void
+init (bool on, Real b)
+{
+    enabled = on;
+    budget = b;
+}
+
+void
+check (Long nbytes, const std::string& what)
+{
+    if (!enabled || budget <= 0.0) {
+        return;
+    }
+
+    // Only warn when we first go over, not on every allocation after.
+
+    const bool over = static_cast<Real>(current_total + nbytes) > budget;
+
+    if (over && !over_budget) {
+        amrex::AllPrint() << "Warning: rank " << ParallelDescriptor::MyProc()
+                          << " is about to allocate " << to_MB(nbytes) << " MB for " << what
+                          << " on top of " << to_MB(current_total) << " MB, over its budget of "
+                          << budget / (1024.0 * 1024.0) << " MB\n";
+    }
+
+    over_budget = over;
+}
+
+void
+report (int finest_level, const std::string& when)
+{
+    BL_PROFILE("mem_acct::report()");
+
+    sample();
+    grow(finest_level);
+
+    const int nlevs = finest_level + 1;
+    const int n = nlevs * NumOwners;
+
+    // Totals over ranks of the current use; the largest current use and
+    // peak of any rank, and the largest rank totals.
+
+    std::vector<Long> sums(n + 1);
+    std::vector<Long> maxes(2 * n + 2);
+
+    for (int lev = 0; lev < nlevs; ++lev) {
+        for (int o = 0; o < NumOwners; ++o) {
+            sums[lev * NumOwners + o] = current[lev][o];
+            maxes[lev * NumOwners + o] = current[lev][o];
+            maxes[n + lev * NumOwners + o] = peak[lev][o];
+        }
+    }
+    sums[n] = current_total;
+    maxes[2 * n] = current_total;
+    maxes[2 * n + 1] = peak_total;
+
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+
+    ParallelDescriptor::ReduceLongSum(sums.data(), n + 1, IOProc);
+    ParallelDescriptor::ReduceLongMax(maxes.data(), 2 * n + 2, IOProc);
+
+    if (!ParallelDescriptor::IOProcessor()) {
+        return;
+    }
+
+    amrex::Print() << "\nMemory use by subsystem after " << when << " (MB):\n"
+                   << "  level  subsystem      total over ranks   max rank now   max rank peak\n";
+
+    for (int lev = 0; lev < nlevs; ++lev) {
+        for (int o = 0; o < NumOwners; ++o) {
+            const int i = lev * NumOwners + o;
+            if (maxes[n + i] == 0) {
+                continue;
+            }
+            amrex::Print() << "  " << std::setw(5) << lev << "  " << std::left << std::setw(12) << owner_names[o]
+                           << std::right << std::fixed << std::setprecision(1)
+                           << std::setw(19) << to_MB(sums[i])
+                           << std::setw(15) << to_MB(maxes[i])
+                           << std::setw(16) << to_MB(maxes[n + i]) << "\n";
+        }
+    }
+
+    amrex::Print() << "         " << std::left << std::setw(12) << "all"
+                   << std::right << std::fixed << std::setprecision(1)
+                   << std::setw(19) << to_MB(sums[n])
+                   << std::setw(15) << to_MB(maxes[2 * n])
+                   << std::setw(16) << to_MB(maxes[2 * n + 1]) << "\n" << std::endl;
+}
+
+}
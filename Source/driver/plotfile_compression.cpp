@@ -0,0 +1,807 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include <AMReX_NFiles.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+#include <AMReX_VisMF.H>
+
+#include <plotfile_compression.H>
+
+using namespace amrex;
+
+namespace {
+
+    // We operate on the bit patterns of the Reals.
+
+    using word_t = std::conditional<sizeof(Real) == 8, std::uint64_t, std::uint32_t>::type;
+
+    static_assert(sizeof(word_t) == sizeof(Real), "unsupported Real size");
+
+    constexpr int word_bytes = sizeof(word_t);
+    constexpr int mant_bits = std::numeric_limits<Real>::digits - 1;
+    constexpr word_t exp_mask = ((word_t(1) << (8 * word_bytes - 1 - mant_bits)) - 1) << mant_bits;
+
+    // The entropy coder alphabet: the nonzero byte values 1-255 are
+    // literals, and symbol 256 + m is a run of L zero bytes with
+    // 2**m <= L < 2**(m+1), followed by the m low bits of L.
+
+    constexpr int nrun = 64;
+    constexpr int nsym = 256 + nrun;
+    constexpr int max_code_len = 24;
+
+    const std::string header_version = "CastroCompressedMultiFab_V1";
+
+    class BitWriter
+    {
+    public:
+
+        explicit BitWriter (std::vector<unsigned char>& out_) : out(out_) {}
+
+        // write the n <= 32 low bits of bits, most significant first
+        void put (std::uint64_t bits, int n)
+        {
+            acc = (acc << n) | (bits & ((std::uint64_t(1) << n) - 1));
+            nacc += n;
+            while (nacc >= 8) {
+                nacc -= 8;
+                out.push_back(static_cast<unsigned char>((acc >> nacc) & 0xff));
+            }
+        }
+
+        void put_long (std::uint64_t bits, int n)
+        {
+            if (n > 32) {
+                put(bits >> 32, n - 32);
+                n = 32;
+            }
+            put(bits, n);
+        }
+
+        void flush ()
+        {
+            if (nacc > 0) {
+                out.push_back(static_cast<unsigned char>((acc << (8 - nacc)) & 0xff));
+                nacc = 0;
+            }
+        }
+
+    private:
+
+        std::vector<unsigned char>& out;
+        std::uint64_t acc = 0;
+        int nacc = 0;
+    };
+
+    class BitReader
+    {
+    public:
+
+        BitReader (const unsigned char* p_, const unsigned char* end_) : p(p_), end(end_) {}
+
+        int bit ()
+        {
+            if (nacc == 0) {
+                if (p >= end) {
+                    amrex::Abort("plt_compress: truncated data");
+                }
+                acc = *p++;
+                nacc = 8;
+            }
+            --nacc;
+            return (acc >> nacc) & 1;
+        }
+
+        std::uint64_t get (int n)
+        {
+            std::uint64_t v = 0;
+            for (int i = 0; i < n; ++i) {
+                v = (v << 1) | static_cast<std::uint64_t>(bit());
+            }
+            return v;
+        }
+
+    private:
+
+        const unsigned char* p;
+        const unsigned char* end;
+        unsigned int acc = 0;
+        int nacc = 0;
+    };
+
+    int floor_log2 (std::uint64_t v)
+    {
+        int m = 0;
+        while (v >>= 1) {
+            ++m;
+        }
+        return m;
+    }
+
+    // Walk the byte stream as a sequence of symbols, calling
+    // f(symbol, run_length) for each.
+
+    template <class F>
+    void tokenize (const std::vector<unsigned char>& bytes, F&& f)
+    {
+        const std::size_t n = bytes.size();
+        std::size_t i = 0;
+        while (i < n) {
+            if (bytes[i] == 0) {
+                std::size_t j = i;
+                while (j < n && bytes[j] == 0) {
+                    ++j;
+                }
+                const std::uint64_t len = j - i;
+                f(256 + floor_log2(len), len);
+                i = j;
+            } else {
+                f(static_cast<int>(bytes[i]), std::uint64_t(0));
+                ++i;
+            }
+        }
+    }
+
+    // Huffman code lengths for the symbol frequencies.  If the longest
+    // code is too long we flatten the frequencies and try again.
+
+    void huffman_lengths (const std::vector<std::uint64_t>& freq, std::vector<unsigned char>& len)
+    {
+        std::vector<std::uint64_t> f(freq);
+
+        using node = std::pair<std::uint64_t, int>;
+
+        while (true) {
+
+            len.assign(nsym, 0);
+
+            std::priority_queue<node, std::vector<node>, std::greater<node>> q;
+            for (int s = 0; s < nsym; ++s) {
+                if (f[s] > 0) {
+                    q.push(node(f[s], s));
+                }
+            }
+
+            if (q.empty()) {
+                return;
+            }
+
+            if (q.size() == 1) {
+                len[q.top().second] = 1;
+                return;
+            }
+
+            std::vector<int> parent(2 * nsym, -1);
+            int nnodes = nsym;
+
+            while (q.size() > 1) {
+                node a = q.top();
+                q.pop();
+                node b = q.top();
+                q.pop();
+                parent[a.second] = nnodes;
+                parent[b.second] = nnodes;
+                q.push(node(a.first + b.first, nnodes));
+                ++nnodes;
+            }
+
+            int maxlen = 0;
+            for (int s = 0; s < nsym; ++s) {
+                if (f[s] > 0) {
+                    int l = 0;
+                    for (int n = s; parent[n] >= 0; n = parent[n]) {
+                        ++l;
+                    }
+                    len[s] = static_cast<unsigned char>(std::min(l, 255));
+                    maxlen = std::max(maxlen, l);
+                }
+            }
+
+            if (maxlen <= max_code_len) {
+                return;
+            }
+
+            for (int s = 0; s < nsym; ++s) {
+                if (f[s] > 0) {
+                    f[s] = (f[s] + 1) / 2;
+                }
+            }
+        }
+    }
+
+    // Canonical codes: within each length, codes are assigned in
+    // increasing symbol order.  first[l] is the first code of length l.
+
+    void canonical_codes (const std::vector<unsigned char>& len,
+                          std::vector<std::uint32_t>& code,
+                          std::vector<std::uint32_t>& first,
+                          std::vector<int>& count)
+    {
+        count.assign(max_code_len + 1, 0);
+        for (int s = 0; s < nsym; ++s) {
+            if (len[s] > max_code_len) {
+                amrex::Abort("plt_compress: invalid code length");
+            }
+            if (len[s] > 0) {
+                count[len[s]]++;
+            }
+        }
+
+        first.assign(max_code_len + 2, 0);
+        std::uint32_t c = 0;
+        for (int l = 1; l <= max_code_len; ++l) {
+            c = (c + count[l-1]) << 1;
+            first[l] = c;
+        }
+
+        std::vector<std::uint32_t> next(first);
+        code.assign(nsym, 0);
+        for (int s = 0; s < nsym; ++s) {
+            if (len[s] > 0) {
+                code[s] = next[len[s]]++;
+            }
+        }
+    }
+
+    template <class T>
+    void append (std::vector<unsigned char>& out, const T& v)
+    {
+        const auto p = reinterpret_cast<const unsigned char*>(&v);
+        out.insert(out.end(), p, p + sizeof(T));
+    }
+
+    template <class T>
+    T extract (const unsigned char*& p, const unsigned char* end)
+    {
+        if (p + sizeof(T) > end) {
+            amrex::Abort("plt_compress: truncated data");
+        }
+        T v;
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return v;
+    }
+
+    // Encode n values, keeping keep mantissa bits, and append them to out.
+
+    void encode_component (const Real* src, Long n, int keep, std::vector<unsigned char>& out)
+    {
+        std::vector<word_t> w(n);
+        std::memcpy(w.data(), src, n * sizeof(Real));
+
+        if (keep < mant_bits) {
+
+            // Round to nearest at the last kept bit.  Infs and NaNs are
+            // left alone, and we truncate instead if rounding would
+            // overflow into them.
+
+            const int drop = mant_bits - keep;
+            const word_t half = word_t(1) << (drop - 1);
+            const word_t mask = ~((word_t(1) << drop) - 1);
+
+            for (auto& x : w) {
+                if ((x & exp_mask) == exp_mask) {
+                    continue;
+                }
+                word_t r = (x + half) & mask;
+                if ((r & exp_mask) == exp_mask) {
+                    r = x & mask;
+                }
+                x = r;
+            }
+        }
+
+        // XOR with the previous value, so that the bytes shared by
+        // neighboring zones become zero, and split into byte planes.
+
+        std::vector<unsigned char> planes(n * word_bytes);
+
+        word_t prev = 0;
+        for (Long i = 0; i < n; ++i) {
+            const word_t x = w[i] ^ prev;
+            prev = w[i];
+            for (int b = 0; b < word_bytes; ++b) {
+                planes[b * n + i] = static_cast<unsigned char>((x >> (8 * b)) & 0xff);
+            }
+        }
+
+        std::vector<std::uint64_t> freq(nsym, 0);
+        tokenize(planes, [&] (int s, std::uint64_t) { freq[s]++; });
+
+        std::vector<unsigned char> len;
+        huffman_lengths(freq, len);
+
+        std::vector<std::uint32_t> code, first;
+        std::vector<int> count;
+        canonical_codes(len, code, first, count);
+
+        std::vector<unsigned char> payload;
+        payload.reserve(planes.size() / 4 + 16);
+
+        BitWriter bw(payload);
+        tokenize(planes, [&] (int s, std::uint64_t run)
+        {
+            bw.put(code[s], len[s]);
+            if (s > 256) {
+                const int m = s - 256;
+                bw.put_long(run - (std::uint64_t(1) << m), m);
+            }
+        });
+        bw.flush();
+
+        append(out, static_cast<std::int64_t>(n));
+        append(out, static_cast<std::int32_t>(keep));
+        out.insert(out.end(), len.begin(), len.end());
+        append(out, static_cast<std::int64_t>(payload.size()));
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+
+    // Decode n values starting at p into dst, returning the position
+    // just past the encoded component.
+
+    const unsigned char* decode_component (const unsigned char* p, const unsigned char* end,
+                                           Real* dst, Long n)
+    {
+        const auto nstored = extract<std::int64_t>(p, end);
+        const auto keep = extract<std::int32_t>(p, end);
+        amrex::ignore_unused(keep);
+
+        if (nstored != n) {
+            amrex::Abort("plt_compress: component size does not match the box");
+        }
+
+        if (p + nsym > end) {
+            amrex::Abort("plt_compress: truncated data");
+        }
+        std::vector<unsigned char> len(p, p + nsym);
+        p += nsym;
+
+        const auto npayload = extract<std::int64_t>(p, end);
+        if (p + npayload > end) {
+            amrex::Abort("plt_compress: truncated data");
+        }
+
+        std::vector<std::uint32_t> code, first;
+        std::vector<int> count;
+        canonical_codes(len, code, first, count);
+
+        // symbols sorted by code length, then value, and the index of
+        // the first symbol of each length
+
+        std::vector<int> sorted;
+        std::vector<int> offset(max_code_len + 1, 0);
+        for (int l = 1; l <= max_code_len; ++l) {
+            offset[l] = static_cast<int>(sorted.size());
+            for (int s = 0; s < nsym; ++s) {
+                if (len[s] == l) {
+                    sorted.push_back(s);
+                }
+            }
+        }
+
+        const std::size_t nbytes = n * word_bytes;
+        std::vector<unsigned char> planes(nbytes, 0);
+
+        BitReader br(p, p + npayload);
+
+        std::size_t pos = 0;
+        while (pos < nbytes) {
+
+            std::uint32_t c = 0;
+            int s = -1;
+            for (int l = 1; l <= max_code_len; ++l) {
+                c = (c << 1) | static_cast<std::uint32_t>(br.bit());
+                if (c >= first[l] && c - first[l] < static_cast<std::uint32_t>(count[l])) {
+                    s = sorted[offset[l] + (c - first[l])];
+                    break;
+                }
+            }
+
+            if (s < 0) {
+                amrex::Abort("plt_compress: invalid code");
+            }
+
+            if (s < 256) {
+                planes[pos++] = static_cast<unsigned char>(s);
+            } else {
+                const int m = s - 256;
+                const std::uint64_t run = (std::uint64_t(1) << m) + br.get(m);
+                if (pos + run > nbytes) {
+                    amrex::Abort("plt_compress: invalid zero run");
+                }
+                pos += run;
+            }
+        }
+
+        word_t prev = 0;
+        for (Long i = 0; i < n; ++i) {
+            word_t x = 0;
+            for (int b = 0; b < word_bytes; ++b) {
+                x |= static_cast<word_t>(planes[b * n + i]) << (8 * b);
+            }
+            prev ^= x;
+            std::memcpy(dst + i, &prev, sizeof(Real));
+        }
+
+        return p + npayload;
+    }
+
+    std::string level_dir (int lev)
+    {
+        return amrex::Concatenate("Level_", lev, 1);
+    }
+
+}
+
+namespace plt_compress
+{
+
+    const int lossless = mant_bits;
+
+    int mantissa_bits (Real rtol)
+    {
+        if (rtol <= 0.0_rt) {
+            return lossless;
+        }
+
+        // Rounding to keep bits gives a relative error of at most 2**-(keep+1).
+
+        int keep = static_cast<int>(std::ceil(-std::log2(rtol))) - 1;
+
+        return std::max(0, std::min(keep, lossless));
+    }
+
+    void write_level (const MultiFab& mf, const Vector<int>& keep_bits, const std::string& mf_name)
+    {
+        BL_PROFILE("plt_compress::write_level()");
+
+        const int ncomp = mf.nComp();
+        const int nfabs = mf.size();
+
+        AMREX_ALWAYS_ASSERT(keep_bits.size() == ncomp);
+
+        // The FABs are encoded as contiguous valid boxes.
+
+        AMREX_ALWAYS_ASSERT(mf.nGrow() == 0);
+
+        const Vector<int>& local = mf.IndexArray();
+        const int nlocal = local.size();
+
+        Vector<std::vector<unsigned char>> buffers(nlocal);
+
+        Vector<Real> fab_min(nfabs * ncomp, std::numeric_limits<Real>::max());
+        Vector<Real> fab_max(nfabs * ncomp, std::numeric_limits<Real>::lowest());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < nlocal; ++i) {
+
+            const int k = local[i];
+            const Box& bx = mf.boxArray()[k];
+            const Long npts = bx.numPts();
+
+            const FArrayBox& fab = mf[k];
+
+#ifdef AMREX_USE_GPU
+            FArrayBox hfab(bx, ncomp, The_Pinned_Arena());
+            Gpu::dtoh_memcpy(hfab.dataPtr(), fab.dataPtr(), hfab.nBytes());
+            const Real* data = hfab.dataPtr();
+#else
+            const Real* data = fab.dataPtr();
+#endif
+
+            for (int n = 0; n < ncomp; ++n) {
+
+                const Real* src = data + n * npts;
+
+                Real lo = std::numeric_limits<Real>::max();
+                Real hi = std::numeric_limits<Real>::lowest();
+                for (Long j = 0; j < npts; ++j) {
+                    lo = std::min(lo, src[j]);
+                    hi = std::max(hi, src[j]);
+                }
+                fab_min[k * ncomp + n] = lo;
+                fab_max[k * ncomp + n] = hi;
+
+                encode_component(src, npts, keep_bits[n], buffers[i]);
+            }
+        }
+
+        // Write the local FABs using the same file grouping as VisMF.
+
+        const int nOutFiles = VisMF::GetNOutFiles();
+        const std::string filePrefix = mf_name + "_Z_";
+
+        Vector<Long> fab_offset(nfabs, 0);
+        Vector<Long> fab_bytes(nfabs, 0);
+
+        for (NFilesIter nfi(nOutFiles, filePrefix, false, true); nfi.ReadyToWrite(); ++nfi) {
+
+            std::fstream& os = nfi.Stream();
+
+            for (int i = 0; i < nlocal; ++i) {
+                const int k = local[i];
+                fab_offset[k] = static_cast<Long>(os.tellp());
+                fab_bytes[k] = static_cast<Long>(buffers[i].size());
+                os.write(reinterpret_cast<const char*>(buffers[i].data()), buffers[i].size());
+            }
+
+            if (!os.good()) {
+                amrex::Abort("plt_compress::write_level: error writing " + mf_name);
+            }
+        }
+
+        const int ioproc = ParallelDescriptor::IOProcessorNumber();
+
+        ParallelDescriptor::ReduceLongSum(fab_offset.dataPtr(), nfabs, ioproc);
+        ParallelDescriptor::ReduceLongSum(fab_bytes.dataPtr(), nfabs, ioproc);
+        ParallelDescriptor::ReduceRealMin(fab_min.dataPtr(), nfabs * ncomp, ioproc);
+        ParallelDescriptor::ReduceRealMax(fab_max.dataPtr(), nfabs * ncomp, ioproc);
+
+        if (ParallelDescriptor::IOProcessor()) {
+
+            const std::string hdr_name = mf_name + "_Z_H";
+
+            std::ofstream hdr(hdr_name.c_str(), std::ios::out | std::ios::trunc);
+            if (!hdr.good()) {
+                amrex::FileOpenFailed(hdr_name);
+            }
+
+            hdr << header_version << '\n';
+            hdr << ncomp << '\n';
+            for (int n = 0; n < ncomp; ++n) {
+                hdr << keep_bits[n] << ' ';
+            }
+            hdr << '\n';
+
+            mf.boxArray().writeOn(hdr);
+            hdr << '\n';
+
+            // the file names are relative to the directory holding the header
+
+            const std::string baseName = filePrefix.substr(filePrefix.rfind('/') + 1);
+
+            hdr << nfabs << '\n';
+            for (int k = 0; k < nfabs; ++k) {
+                hdr << NFilesIter::FileName(nOutFiles, baseName, mf.DistributionMap()[k], false) << ' '
+                    << fab_offset[k] << ' ' << fab_bytes[k] << '\n';
+            }
+
+            hdr << std::setprecision(17);
+            for (int k = 0; k < nfabs; ++k) {
+                for (int n = 0; n < ncomp; ++n) {
+                    hdr << fab_min[k * ncomp + n] << ' ' << fab_max[k * ncomp + n] << ' ';
+                }
+                hdr << '\n';
+            }
+
+            hdr.close();
+        }
+    }
+
+    void read_level (MultiFab& mf, const std::string& mf_name)
+    {
+        BL_PROFILE("plt_compress::read_level()");
+
+        Vector<char> hdr_chars;
+        ParallelDescriptor::ReadAndBcastFile(mf_name + "_Z_H", hdr_chars);
+        std::istringstream hdr(std::string(hdr_chars.dataPtr()), std::istringstream::in);
+
+        std::string version;
+        hdr >> version;
+        if (version != header_version) {
+            amrex::Abort("plt_compress::read_level: unknown header version " + version);
+        }
+
+        int ncomp;
+        hdr >> ncomp;
+
+        Vector<int> keep_bits(ncomp);
+        for (int n = 0; n < ncomp; ++n) {
+            hdr >> keep_bits[n];
+        }
+
+        BoxArray ba;
+        ba.readFrom(hdr);
+
+        int nfabs;
+        hdr >> nfabs;
+        AMREX_ALWAYS_ASSERT(nfabs == ba.size());
+
+        Vector<std::string> fab_file(nfabs);
+        Vector<Long> fab_offset(nfabs);
+        Vector<Long> fab_bytes(nfabs);
+        for (int k = 0; k < nfabs; ++k) {
+            hdr >> fab_file[k] >> fab_offset[k] >> fab_bytes[k];
+        }
+
+        DistributionMapping dm(ba);
+        mf.define(ba, dm, ncomp, 0);
+
+        const std::string dir = mf_name.substr(0, mf_name.rfind('/') + 1);
+
+        std::vector<unsigned char> buffer;
+
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+
+            const int k = mfi.index();
+            const Box& bx = mfi.validbox();
+            const Long npts = bx.numPts();
+
+            const std::string file_name = dir + fab_file[k];
+
+            std::ifstream is(file_name.c_str(), std::ios::in | std::ios::binary);
+            if (!is.good()) {
+                amrex::FileOpenFailed(file_name);
+            }
+
+            buffer.resize(fab_bytes[k]);
+            is.seekg(fab_offset[k], std::ios::beg);
+            is.read(reinterpret_cast<char*>(buffer.data()), fab_bytes[k]);
+            if (!is.good()) {
+                amrex::Abort("plt_compress::read_level: error reading " + file_name);
+            }
+
+#ifdef AMREX_USE_GPU
+            FArrayBox hfab(bx, ncomp, The_Pinned_Arena());
+            Real* data = hfab.dataPtr();
+#else
+            Real* data = mf[mfi].dataPtr();
+#endif
+
+            const unsigned char* p = buffer.data();
+            const unsigned char* end = p + buffer.size();
+
+            for (int n = 0; n < ncomp; ++n) {
+                p = decode_component(p, end, data + n * npts, npts);
+            }
+
+#ifdef AMREX_USE_GPU
+            Gpu::htod_memcpy(mf[mfi].dataPtr(), hfab.dataPtr(), hfab.nBytes());
+#endif
+        }
+    }
+
+    bool is_compressed (const std::string& pltfile)
+    {
+        return amrex::FileExists(pltfile + "/" + level_dir(0) + "/Cell_Z_H");
+    }
+
+    PlotfileData::PlotfileData (const std::string& pltfile)
+    {
+        BL_PROFILE("plt_compress::PlotfileData()");
+
+        Vector<char> hdr_chars;
+        ParallelDescriptor::ReadAndBcastFile(pltfile + "/Header", hdr_chars);
+        std::istringstream hdr(std::string(hdr_chars.dataPtr()), std::istringstream::in);
+
+        std::string file_type;
+        hdr >> file_type;
+
+        int ncomp;
+        hdr >> ncomp;
+        var_names.resize(ncomp);
+        for (int n = 0; n < ncomp; ++n) {
+            hdr >> var_names[n];
+        }
+
+        int dim;
+        hdr >> dim;
+        if (dim != AMREX_SPACEDIM) {
+            amrex::Abort("plt_compress::PlotfileData: " + pltfile + " has the wrong dimensionality");
+        }
+
+        hdr >> time;
+        hdr >> finest_level;
+
+        prob_lo.resize(AMREX_SPACEDIM);
+        prob_hi.resize(AMREX_SPACEDIM);
+        for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+            hdr >> prob_lo[i];
+        }
+        for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+            hdr >> prob_hi[i];
+        }
+
+        ref_ratio.resize(finest_level);
+        for (int lev = 0; lev < finest_level; ++lev) {
+            hdr >> ref_ratio[lev];
+        }
+
+        prob_domain.resize(finest_level + 1);
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            hdr >> prob_domain[lev];
+        }
+
+        int step;
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            hdr >> step;
+        }
+
+        dx_level.resize(finest_level + 1);
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            dx_level[lev].resize(AMREX_SPACEDIM);
+            for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+                hdr >> dx_level[lev][i];
+            }
+        }
+
+        int coord, bndry_width;
+        hdr >> coord >> bndry_width;
+
+        // The level data is read from wherever the Header says it is,
+        // compressed or not.
+
+        level_data.resize(finest_level + 1);
+
+        for (int lev = 0; lev <= finest_level; ++lev) {
+
+            int lev_in, ngrids;
+            Real lev_time;
+            hdr >> lev_in >> ngrids >> lev_time;
+            hdr >> step;
+
+            Real x;
+            for (int k = 0; k < 2 * ngrids * AMREX_SPACEDIM; ++k) {
+                hdr >> x;
+            }
+
+            std::string mf_path;
+            hdr >> mf_path;
+
+            if (!hdr.good()) {
+                amrex::Abort("plt_compress::PlotfileData: error reading " + pltfile + "/Header");
+            }
+
+            const std::string mf_name = pltfile + "/" + mf_path;
+
+            level_data[lev].reset(new MultiFab);
+
+            if (amrex::FileExists(mf_name + "_Z_H")) {
+                read_level(*level_data[lev], mf_name);
+            } else {
+                VisMF::Read(*level_data[lev], mf_name);
+            }
+
+            AMREX_ALWAYS_ASSERT(level_data[lev]->nComp() == ncomp);
+        }
+    }
+
+    int PlotfileData::StateNumber (const std::string& name) const
+    {
+        for (int n = 0; n < NComp(); ++n) {
+            if (var_names[n] == name) {
+                return n;
+            }
+        }
+        return -1;
+    }
+
+    void PlotfileData::FillVar (MultiFab& dest, int lev,
+                                const Vector<std::string>& names,
+                                const Vector<int>& dest_comps) const
+    {
+        AMREX_ALWAYS_ASSERT(names.size() == dest_comps.size());
+        AMREX_ALWAYS_ASSERT(level_data[lev]->boxArray().contains(dest.boxArray()));
+
+        for (int i = 0; i < static_cast<int>(names.size()); ++i) {
+            const int comp = StateNumber(names[i]);
+            if (comp < 0) {
+                amrex::Abort("plt_compress::PlotfileData::FillVar: unknown variable " + names[i]);
+            }
+            dest.ParallelCopy(*level_data[lev], comp, dest_comps[i], 1);
+        }
+    }
+
+}
@@ -0,0 +1,111 @@
+#include <cmath>
+
+#include <AMReX_ParallelDescriptor.H>
+
+#include <radial_bins.H>
+
+using namespace amrex;
+
+RadialBins::RadialBins (int n1d_, int nvals, bool cylindrical)
+    : n1d(n1d_), ncomp(nvals + 1), cyl(cylindrical), data(n1d_ * (nvals + 1), 0.0_rt)
+{
+}
+
+Real
+RadialBins::totalVolume () const
+{
+    Real vol = 0.0_rt;
+    for (int i = 0; i < n1d; ++i) {
+        vol += volume(i);
+    }
+    return vol;
+}
+
+void
+RadialBins::setZero ()
+{
+    for (auto& d : data) {
+        d = 0.0_rt;
+    }
+}
+
+void
+RadialBins::reduce ()
+{
+    reduce({this});
+}
+
+void
+RadialBins::reduce (const Vector<RadialBins*>& bins)
+{
+    BL_PROFILE("RadialBins::reduce()");
+
+    // Pack all of the bins into a single buffer so that we only
+    // pay the latency of one collective.
+
+    std::size_t nbuf = 0;
+    for (const auto b : bins) {
+        nbuf += b->data.size();
+    }
+
+    if (nbuf == 0) {
+        return;
+    }
+
+    Vector<Real> buf(nbuf);
+
+    std::size_t offset = 0;
+    for (const auto b : bins) {
+        std::copy(b->data.begin(), b->data.end(), buf.begin() + offset);
+        offset += b->data.size();
+    }
+
+    ParallelDescriptor::ReduceRealSum(buf.dataPtr(), static_cast<int>(nbuf));
+
+    offset = 0;
+    for (auto b : bins) {
+        std::copy(buf.begin() + offset, buf.begin() + offset + b->data.size(), b->data.begin());
+        offset += b->data.size();
+    }
+}
+
+Real
+RadialBins::octantFactor (const Geometry& geom)
+{
+    const auto dx = geom.CellSizeArray();
+    const auto problo = geom.ProbLoArray();
+
+    // If the center is at the lower corner of the domain, we are only
+    // simulating an octant (or half, in axisymmetric geometry) of the
+    // full object, so scale the volumes accordingly.
+
+    Real octant_factor = 1.0_rt;
+
+#if AMREX_SPACEDIM == 3
+    if (geom.Coord() == 0) {
+
+        if ((std::abs(problem::center[0] - problo[0]) < 1.e-2_rt * dx[0]) &&
+            (std::abs(problem::center[1] - problo[1]) < 1.e-2_rt * dx[1]) &&
+            (std::abs(problem::center[2] - problo[2]) < 1.e-2_rt * dx[2])) {
+
+            octant_factor = 8.0_rt;
+
+        }
+
+    }
+#endif
+
+#if AMREX_SPACEDIM >= 2
+    if (geom.Coord() == 1) {
+
+        if (std::abs(problem::center[1] - problo[1]) < 1.e-2_rt * dx[1]) {
+
+            octant_factor = 2.0_rt;
+
+        }
+
+    }
+#endif
+
+    return octant_factor;
+}
@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <AMReX_BLProfiler.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <telemetry.H>
+
+using namespace amrex;
+
+namespace {
+
+    const char* timer_names[telemetry::NumTimers] =
+        {"hydro", "burn", "gravity", "sources", "fillpatch", "reflux", "io"};
+
+    const char* counter_names[telemetry::NumCounters] =
+        {"zones", "burn_zones", "burn_rhs", "retries", "mlmg_iters",
+         "rad_outer", "rad_inner", "rad_solves"};
+
+    // The burn counters are local to each rank and are summed; the others
+    // are the same on every rank.
+
+    const bool counter_is_local[telemetry::NumCounters] =
+        {false, true, true, false, false, false, false, false};
+
+    // Per-level accumulators since the last record.
+
+    std::vector<std::vector<Real>> times;
+    std::vector<std::vector<Real>> counts;
+
+    Real last_write = -1.0;
+
+    telemetry::ScopedTimer* current = nullptr;
+
+    void grow (int lev)
+    {
+        // The first record covers the time since the first measurement.
+
+        if (last_write < 0.0) {
+            last_write = ParallelDescriptor::second();
+        }
+
+        if (lev >= static_cast<int>(times.size())) {
+            times.resize(lev + 1, std::vector<Real>(telemetry::NumTimers, 0.0));
+            counts.resize(lev + 1, std::vector<Real>(telemetry::NumCounters, 0.0));
+        }
+    }
+
+    // Peak resident set size of this rank, in bytes.
+
+    Real max_rss ()
+    {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0.0;
+        }
+#ifdef __APPLE__
+        return static_cast<Real>(usage.ru_maxrss);
+#else
+        return 1024.0 * static_cast<Real>(usage.ru_maxrss);
+#endif
+    }
+
+#ifdef BL_USE_MPI
+    // The reduction buffer is [sums | maxima], nsum + nmax long.  It is
+    // sent as a single element of a contiguous type so that MPI cannot
+    // split it between calls of the operator.
+
+    int nsum = 0;
+    int nmax = 0;
+
+    void sum_and_max (void* invec, void* inoutvec, int* len, MPI_Datatype*)
+    {
+        const Real* in = static_cast<const Real*>(invec);
+        Real* inout = static_cast<Real*>(inoutvec);
+
+        for (int e = 0; e < *len; ++e) {
+            for (int i = 0; i < nsum; ++i) {
+                inout[i] += in[i];
+            }
+            for (int i = nsum; i < nsum + nmax; ++i) {
+                inout[i] = std::max(inout[i], in[i]);
+            }
+            in += nsum + nmax;
+            inout += nsum + nmax;
+        }
+    }
+#endif
+
+}
+
+namespace telemetry
+{
+
+void
+add_time (int lev, Timer t, Real seconds)
+{
+    grow(lev);
+    times[lev][t] += seconds;
+}
+
+void
+add_count (int lev, Counter c, Real n)
+{
+    grow(lev);
+    counts[lev][c] += n;
+}
+
+ScopedTimer::ScopedTimer (int lev, Timer t)
+    : m_lev(lev), m_timer(t), m_parent(current)
+{
+    m_start = ParallelDescriptor::second();
+
+    // Pause the enclosing timer.
+
+    if (m_parent != nullptr) {
+        add_time(m_parent->m_lev, m_parent->m_timer, m_start - m_parent->m_start);
+    }
+
+    current = this;
+}
+
+ScopedTimer::~ScopedTimer ()
+{
+    const Real now = ParallelDescriptor::second();
+
+    add_time(m_lev, m_timer, now - m_start);
+
+    current = m_parent;
+
+    if (m_parent != nullptr) {
+        m_parent->m_start = now;
+    }
+}
+
+void
+write_step (const std::string& filename, int format,
+            int nstep, Real time, Real dt, int finest_level)
+{
+    BL_PROFILE("telemetry::write_step()");
+
+    grow(finest_level);
+
+    const Real now = ParallelDescriptor::second();
+    const Real wall = now - last_write;
+
+    const int nlevs = finest_level + 1;
+
+    // Sums and then maxima of: per level the times and the counters, and
+    // the step time.  The maxima also hold the memory high-water marks.
+
+    const int nper = NumTimers + NumCounters;
+    const int ns = nlevs * nper + 1;
+    const int nm = nlevs * nper + 3;
+
+    std::vector<Real> buf;
+    buf.reserve(ns + nm);
+
+    for (int lev = 0; lev < nlevs; ++lev) {
+        buf.insert(buf.end(), times[lev].begin(), times[lev].end());
+        buf.insert(buf.end(), counts[lev].begin(), counts[lev].end());
+    }
+    buf.push_back(wall);
+
+    for (int lev = 0; lev < nlevs; ++lev) {
+        buf.insert(buf.end(), times[lev].begin(), times[lev].end());
+        buf.insert(buf.end(), counts[lev].begin(), counts[lev].end());
+    }
+    buf.push_back(wall);
+    buf.push_back(max_rss());
+    buf.push_back(static_cast<Real>(amrex::TotalBytesAllocatedInFabsHWM()));
+
+    std::vector<Real> result(buf);
+
+#ifdef BL_USE_MPI
+    if (ParallelDescriptor::NProcs() > 1) {
+        nsum = ns;
+        nmax = nm;
+
+        MPI_Datatype block;
+        MPI_Type_contiguous(ns + nm, ParallelDescriptor::Mpi_typemap<Real>::type(), &block);
+        MPI_Type_commit(&block);
+
+        MPI_Op op;
+        MPI_Op_create(sum_and_max, 1, &op);
+
+        MPI_Reduce(buf.data(), result.data(), 1, block, op,
+                   ParallelDescriptor::IOProcessorNumber(),
+                   ParallelDescriptor::Communicator());
+
+        MPI_Op_free(&op);
+        MPI_Type_free(&block);
+    }
+#endif
+
+    // Reset for the next step.  The timers still running (if any) keep
+    // their start time, so their time so far goes into the next record.
+
+    for (int lev = 0; lev < static_cast<int>(times.size()); ++lev) {
+        std::fill(times[lev].begin(), times[lev].end(), 0.0);
+        std::fill(counts[lev].begin(), counts[lev].end(), 0.0);
+    }
+    last_write = now;
+
+    if (!ParallelDescriptor::IOProcessor()) {
+        return;
+    }
+
+    const Real nprocs = static_cast<Real>(ParallelDescriptor::NProcs());
+
+    auto avg_time = [&] (int lev, int t) { return result[lev * nper + t] / nprocs; };
+    auto max_time = [&] (int lev, int t) { return result[ns + lev * nper + t]; };
+    auto count = [&] (int lev, int c)
+    {
+        return counter_is_local[c] ? result[lev * nper + NumTimers + c]
+                                   : result[ns + lev * nper + NumTimers + c];
+    };
+    auto burn_rhs_mean = [&] (int lev)
+    {
+        return count(lev, burn_zones) > 0.0 ? count(lev, burn_rhs) / count(lev, burn_zones) : 0.0;
+    };
+
+    const Real wall_avg = result[ns - 1] / nprocs;
+    const Real wall_max = result[ns + nm - 3];
+    const Real rss_max = result[ns + nm - 2];
+    const Real fab_hwm_max = result[ns + nm - 1];
+
+    const bool write_header = format == 1 && !amrex::FileExists(filename);
+
+    std::ofstream out(filename, std::ios::app);
+    if (!out) {
+        amrex::Warning("unable to open the telemetry file " + filename);
+        return;
+    }
+
+    out << std::setprecision(10);
+
+    if (format == 1) {
+
+        if (write_header) {
+            out << "step,time,dt,level,wall_max,wall_avg,rss_max,fab_hwm_max";
+            for (int t = 0; t < NumTimers; ++t) {
+                out << "," << timer_names[t] << "_max," << timer_names[t] << "_avg";
+            }
+            for (int c = 0; c < NumCounters; ++c) {
+                out << "," << counter_names[c];
+            }
+            out << ",burn_rhs_mean\n";
+        }
+
+        for (int lev = 0; lev < nlevs; ++lev) {
+            out << nstep << "," << time << "," << dt << "," << lev << ","
+                << wall_max << "," << wall_avg << "," << rss_max << "," << fab_hwm_max;
+            for (int t = 0; t < NumTimers; ++t) {
+                out << "," << max_time(lev, t) << "," << avg_time(lev, t);
+            }
+            for (int c = 0; c < NumCounters; ++c) {
+                out << "," << count(lev, c);
+            }
+            out << "," << burn_rhs_mean(lev) << "\n";
+        }
+
+    } else {
+
+        out << "{\"step\": " << nstep << ", \"time\": " << time << ", \"dt\": " << dt
+            << ", \"wall_max\": " << wall_max << ", \"wall_avg\": " << wall_avg
+            << ", \"rss_max\": " << rss_max << ", \"fab_hwm_max\": " << fab_hwm_max
+            << ", \"levels\": [";
+
+        for (int lev = 0; lev < nlevs; ++lev) {
+            out << (lev > 0 ? ", " : "") << "{\"level\": " << lev;
+            for (int t = 0; t < NumTimers; ++t) {
+                out << ", \"" << timer_names[t] << "_max\": " << max_time(lev, t)
+                    << ", \"" << timer_names[t] << "_avg\": " << avg_time(lev, t);
+            }
+            for (int c = 0; c < NumCounters; ++c) {
+                out << ", \"" << counter_names[c] << "\": " << count(lev, c);
+            }
+            out << ", \"burn_rhs_mean\": " << burn_rhs_mean(lev) << "}";
+        }
+
+        out << "]}\n";
+
+    }
+}
+
+}
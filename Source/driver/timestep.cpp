@@ -23,6 +23,14 @@ Castro::estdt_cfl(const Real time)
 
 #ifdef ROTATION
   GeometryData geomdata = geom.data();
+
+  // If we need to convert to the rotating frame, we can use the cached
+  // omega x r for this level rather than recomputing it in every zone.
+
+  bool use_rot_cache = false;
+  if (castro::do_rotation == 1 && castro::state_in_rotating_frame != 1) {
+    use_rot_cache = update_rotation_cache();
+  }
 #endif
 
   const auto dx = geom.CellSizeArray();
@@ -41,6 +49,13 @@ Castro::estdt_cfl(const Real time)
 
     auto u = stateMF.array(mfi);
 
+#ifdef ROTATION
+    Array4<Real const> rot_geom;
+    if (use_rot_cache) {
+      rot_geom = rot_cache.const_array(mfi);
+    }
+#endif
+
     reduce_op.eval(box, reduce_data,
     [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
     {
@@ -75,7 +90,13 @@ Castro::estdt_cfl(const Real time)
         vel[1] = uy;
         vel[2] = uz;
 
-        inertial_to_rotational_velocity_c(i, j, k, geomdata, time, vel);
+        if (use_rot_cache) {
+          for (int n = 0; n < 3; n++) {
+            vel[n] -= rot_geom(i,j,k,ROT_CACHE_WXR+n);
+          }
+        } else {
+          inertial_to_rotational_velocity_c(i, j, k, geomdata, time, vel);
+        }
 
         ux = vel[0];
         uy = vel[1];
@@ -132,15 +153,20 @@ Castro::estdt_cfl(const Real time)
 }
 
 #ifdef MHD
-Real
-Castro::estdt_mhd()
+void
+Castro::estdt_mhd(Real& estdt_hydro, Real& estdt_diff, Real& div_B_err)
 {
 
-  // MHD timestep limiter
+  // MHD timestep limiter.  In the same pass over the zones, and with
+  // the same EOS call, we also find the diffusion-limited timestep (if
+  // we are diffusing temperature) and the divergence of B.  We do not
+  // need the hydro CFL timestep, since the fast magnetosonic speed is
+  // never smaller than the sound speed.
+
   const auto dx = geom.CellSizeArray();
 
-  ReduceOps<ReduceOpMin> reduce_op;
-  ReduceData<Real> reduce_data(reduce_op);
+  ReduceOps<ReduceOpMin, ReduceOpMin, ReduceOpMax, ReduceOpMax> reduce_op;
+  ReduceData<Real, Real, Real, Real> reduce_data(reduce_op);
   using ReduceTuple = typename decltype(reduce_data)::Type;
 
   const MultiFab& state = get_new_data(State_Type);
@@ -149,6 +175,14 @@ Castro::estdt_mhd()
   const MultiFab& by = get_new_data(Mag_Type_y);
   const MultiFab& bz = get_new_data(Mag_Type_z);
 
+  const Real lmax_dt = max_dt;
+  const Real lcfl = cfl;
+
+#ifdef DIFFUSION
+  const int ldiffuse_temp = diffuse_temp;
+  const Real ldiffuse_cutoff_density = diffuse_cutoff_density;
+#endif
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -157,9 +191,9 @@ Castro::estdt_mhd()
 
     auto u_arr = state.array(mfi);
 
-    auto bx_arr = bx.array(mfi);
-    auto by_arr = by.array(mfi);
-    auto bz_arr = bz.array(mfi);
+    auto bx_arr = bx.const_array(mfi);
+    auto by_arr = by.const_array(mfi);
+    auto bz_arr = bz.const_array(mfi);
 
     reduce_op.eval(box, reduce_data,
     [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
@@ -215,31 +249,45 @@ Castro::estdt_mhd()
       }
 
       Real dt1 = dx[0]/(cx + std::abs(ux));
+      Real dt2 = dx[1]/(cy + std::abs(uy));
+      Real dt3 = dx[2]/(cz + std::abs(uz));
 
-      Real dt2;
-#if AMREX_SPACEDIM >= 2
-      dt2 = dx[1]/(cy + std::abs(uy));
-#else
-      dt2 = dt1;
-#endif
+      // Diffusion: dt < 0.5 dx**2 / D, where D = k/(rho c_v)
 
-      Real dt3;
-#if AMREX_SPACEDIM == 3
-      dt3 = dx[2]/(cz + std::abs(uz));
-#else
-      dt3 = dt1;
+      Real dt_diff = lmax_dt / lcfl;
+
+#ifdef DIFFUSION
+      if (ldiffuse_temp == 1 && u_arr(i,j,k,URHO) > ldiffuse_cutoff_density) {
+
+        conductivity(eos_state);
+
+        Real D = eos_state.conductivity * rhoInv / eos_state.cv;
+
+        dt_diff = 0.5_rt * amrex::min(dx[0]*dx[0], dx[1]*dx[1], dx[2]*dx[2]) / D;
+      }
 #endif
 
-      return {amrex::min(dt1, dt2, dt3)};
+      // The divergence of B, compared to the largest B on the level.
+
+      Real divB = mhd_div_B(i, j, k, bx_arr, by_arr, bz_arr, dx);
+      Real magB = std::sqrt(bcx*bcx + bcy*bcy + bcz*bcz);
+
+      return {amrex::min(dt1, dt2, dt3), dt_diff, std::abs(divB) * dx[0], magB};
 
     });
 
   }
 
   ReduceTuple hv = reduce_data.value();
-  Real estdt_mhd = amrex::get<0>(hv);
 
-  return estdt_mhd;
+  // Reduce all four over the ranks at once, negating the maxima.
+
+  Real r[4] = {amrex::get<0>(hv), amrex::get<1>(hv), -amrex::get<2>(hv), -amrex::get<3>(hv)};
+  ParallelDescriptor::ReduceRealMin(r, 4);
+
+  estdt_hydro = r[0];
+  estdt_diff = r[1];
+  div_B_err = r[3] < 0.0_rt ? r[2] / r[3] : 0.0_rt;
 
 }
 #endif
@@ -1,5 +1,7 @@
 #include <Castro.H>
 #include <Castro_F.H>
+#include <memory_accounting.H>
+#include <telemetry.H>
 
 #include <Gravity.H>
 
@@ -14,6 +16,7 @@ void
 Castro::construct_old_gravity(int amr_iteration, int amr_ncycle, Real time)
 {
     BL_PROFILE("Castro::construct_old_gravity()");
+    telemetry::ScopedTimer telemetry_timer(level, telemetry::gravity);
 
     MultiFab& grav_old = get_old_data(Gravity_Type);
     MultiFab& phi_old = get_old_data(PhiGrav_Type);
@@ -82,6 +85,8 @@ Castro::construct_old_gravity(int amr_iteration, int amr_ncycle, Real time)
                                                       comp_minus_level_phi,
                                                       comp_minus_level_grad_phi);
 
+            mem_acct::sample();
+
             // Copy the composite data back. This way the forcing
             // uses the most accurate data we have.
 
@@ -115,6 +120,7 @@ void
 Castro::construct_new_gravity(int amr_iteration, int amr_ncycle, Real time)
 {
     BL_PROFILE("Castro::construct_new_gravity()");
+    telemetry::ScopedTimer telemetry_timer(level, telemetry::gravity);
 
     MultiFab& grav_new = get_new_data(Gravity_Type);
     MultiFab& phi_new = get_new_data(PhiGrav_Type);
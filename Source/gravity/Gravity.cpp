@@ -6,6 +6,7 @@
 #endif
 
 #include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
 #include <Gravity.H>
 #include <Castro.H>
 #include <Gravity_F.H>
@@ -21,6 +22,8 @@
 
 #include <Gravity_util.H>
 #include <MGutils.H>
+#include <radial_bins.H>
+#include <telemetry.H>
 
 using namespace amrex;
 
@@ -490,6 +493,7 @@ void
 Gravity::gravity_sync (int crse_level, int fine_level, const Vector<MultiFab*>& drho, const Vector<MultiFab*>& dphi)
 {
     BL_PROFILE("Gravity::gravity_sync()");
+    telemetry::ScopedTimer telemetry_timer(crse_level, telemetry::gravity);
 
     // There is no need to do a synchronization if
     // we didn't solve on the fine levels.
@@ -695,6 +699,7 @@ void
 Gravity::multilevel_solve_for_new_phi (int level, int finest_level_in)
 {
     BL_PROFILE("Gravity::multilevel_solve_for_new_phi()");
+    telemetry::ScopedTimer telemetry_timer(level, telemetry::gravity);
 
     if (gravity::verbose > 1 && ParallelDescriptor::IOProcessor())
       std::cout << "... multilevel solve for new phi at base level " << level << " to finest level " << finest_level_in << std::endl;
@@ -836,6 +841,127 @@ Gravity::actual_multilevel_solve (int crse_level, int finest_level_in,
 
 }
 
+void
+Gravity::write_grad_phi (int level, const std::string& dir, VisMF::How how)
+{
+    BL_PROFILE("Gravity::write_grad_phi()");
+
+    AMREX_ALWAYS_ASSERT(gravity::gravity_type == "PoissonGrav");
+
+    const std::string level_dir = dir + "/Level_" + std::to_string(level);
+
+    for (int n = 0; n < BL_SPACEDIM; ++n) {
+        VisMF::Write(*grad_phi_curr[level][n], level_dir + "/GradPhi_" + std::to_string(n), how);
+    }
+}
+
+bool
+Gravity::read_grad_phi (const std::string& dir, int finest_level_in)
+{
+    BL_PROFILE("Gravity::read_grad_phi()");
+
+    AMREX_ALWAYS_ASSERT(gravity::gravity_type == "PoissonGrav");
+
+    for (int lev = 0; lev <= finest_level_in; ++lev) {
+
+        const std::string level_dir = dir + "/Level_" + std::to_string(lev);
+
+        for (int n = 0; n < BL_SPACEDIM; ++n) {
+
+            const std::string name = level_dir + "/GradPhi_" + std::to_string(n);
+
+            if (!amrex::FileExists(name + "_H")) {
+                amrex::Print() << "... no checkpointed grad_phi at level " << lev
+                               << ", redoing the multilevel gravity solve" << std::endl;
+                return false;
+            }
+
+            MultiFab gp;
+            VisMF::Read(gp, name);
+
+            if (gp.boxArray() != grad_phi_curr[lev][n]->boxArray()) {
+                amrex::Print() << "... checkpointed grad_phi at level " << lev
+                               << " is on different grids, redoing the multilevel gravity solve" << std::endl;
+                return false;
+            }
+
+            grad_phi_curr[lev][n]->setVal(0.0);
+            grad_phi_curr[lev][n]->ParallelCopy(gp, 0, 0, 1);
+
+        }
+
+    }
+
+    // The composite - level corrections only live within a timestep
+    // (they are rebuilt from grad_phi_prev at the start of each one), so
+    // phi and grad_phi are all we need. Check that they are consistent with
+    // the density, using the same tolerance the multilevel solve would.
+
+    const int fine_level = amrex::min(finest_level_in, gravity::max_solve_level);
+
+    const Real tol = gravity::restart_residual_factor *
+                     amrex::max(rel_tol[fine_level], abs_tol[fine_level]) * max_rhs;
+
+    bool passed = true;
+
+    for (int lev = 0; lev <= fine_level; ++lev) {
+
+        MultiFab Rhs(grids[lev], dmap[lev], 1, 0);
+        MultiFab::Copy(Rhs, LevelData[lev]->get_new_data(State_Type), URHO, 0, 1, 0);
+
+        const Geometry& geom = parent->Geom(lev);
+
+        if (geom.isAllPeriodic()) {
+            Rhs.plus(-mass_offset, 0, 1, 0);
+        }
+
+        Rhs.mult(Ggravity);
+
+        auto dx     = geom.CellSizeArray();
+        auto problo = geom.ProbLoArray();
+        const int coord_type = geom.Coord();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(Rhs, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+
+            test_residual(bx,
+                          Rhs.array(mfi),
+                          (*grad_phi_curr[lev][0]).array(mfi),
+#if AMREX_SPACEDIM >= 2
+                          (*grad_phi_curr[lev][1]).array(mfi),
+#endif
+#if AMREX_SPACEDIM == 3
+                          (*grad_phi_curr[lev][2]).array(mfi),
+#endif
+                          dx, problo, coord_type);
+        }
+
+        const Real resnorm = Rhs.norm0();
+
+        if (gravity::verbose > 0) {
+            amrex::Print() << "... norm of residual of checkpointed grad_phi at level "
+                           << lev << "  " << resnorm << " (tolerance " << tol << ")" << std::endl;
+        }
+
+        if (resnorm > tol) {
+            passed = false;
+        }
+
+    }
+
+    if (passed) {
+        amrex::Print() << "... using checkpointed phi and grad_phi, skipping the multilevel gravity solve" << std::endl;
+    } else {
+        amrex::Print() << "... checkpointed grad_phi failed the residual check, redoing the multilevel gravity solve" << std::endl;
+    }
+
+    return passed;
+}
+
 void
 Gravity::get_old_grav_vector(int level, MultiFab& grav_vector, Real time)
 {
@@ -1464,139 +1590,6 @@ Gravity::interpolate_monopole_grav(int level, RealVector& radial_grav, MultiFab&
     }
 }
 
-void
-Gravity::compute_radial_mass(const Box& bx,
-                             Array4<Real const> const u,
-                             RealVector& radial_mass,
-                             RealVector& radial_vol,
-                             int n1d, int level)
-{
-    const Geometry& geom = parent->Geom(level);
-
-    GpuArray<Real, 3> dx, problo;
-    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-        dx[i] = geom.CellSizeArray()[i];
-        problo[i] = geom.ProbLoArray()[i];
-    }
-    for (int i = AMREX_SPACEDIM; i < 3; ++i) {
-        dx[i] = 0.0_rt;
-        problo[i] = 0.0_rt;
-    }
-
-    Real dr = dx[0] / static_cast<Real>(gravity::drdxfac);
-    Real drinv = 1.0_rt / dr;
-
-    const int coord_type = geom.Coord();
-
-    AMREX_ALWAYS_ASSERT(coord_type >= 0 && coord_type <= 2);
-
-    Real octant_factor = 1.0_rt;
-
-    if (coord_type == 0) {
-
-        if ((std::abs(problem::center[0] - problo[0]) < 1.e-2_rt * dx[0]) &&
-            (std::abs(problem::center[1] - problo[1]) < 1.e-2_rt * dx[1]) &&
-            (std::abs(problem::center[2] - problo[2]) < 1.e-2_rt * dx[2])) {
-
-            octant_factor = 8.0_rt;
-
-        }
-
-    } else if (coord_type == 1) {
-
-        if (std::abs(problem::center[1] - problo[1]) < 1.e-2_rt * dx[1]) {
-
-            octant_factor = 2.0_rt;
-
-        }
-
-    }
-
-    Real fac = static_cast<Real>(gravity::drdxfac);
-
-    Real dx_frac = dx[0] / fac;
-    Real dy_frac = dx[1] / fac;
-    Real dz_frac = dx[2] / fac;
-
-    Real* const radial_mass_ptr = radial_mass.dataPtr();
-    Real* const radial_vol_ptr = radial_vol.dataPtr();
-
-    amrex::ParallelFor(bx,
-    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
-    {
-        Real xc = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0];
-        Real lo_i = problo[0] + static_cast<Real>(i) * dx[0] - problem::center[0];
-
-        Real yc = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - problem::center[1];
-        Real lo_j = problo[1] + static_cast<Real>(j) * dx[1] - problem::center[1];
-
-        Real zc = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - problem::center[2];
-        Real lo_k = problo[2] + static_cast<Real>(k) * dx[2] - problem::center[2];
-
-        Real r = std::sqrt(xc * xc + yc * yc + zc * zc);
-        int index = static_cast<int>(r * drinv);
-
-        if (index > n1d - 1) {
-
-#ifndef AMREX_USE_GPU
-            if (level == 0) {
-                std::cout << "   " << "\n";
-                std::cout << ">>> Error: Gravity_nd::ca_compute_radial_mass " << i << " " << j << " " << k << "\n";
-                std::cout << ">>> ... index too big: " << index << " > " << n1d-1 << "\n";
-                std::cout << ">>> ... at (i,j,k)   : " << i << " " << j << " " << k << "\n";
-                amrex::Abort("Error:: Gravity_nd.F90 :: ca_compute_radial_mass");
-            }
-#endif
-
-        } else {
-
-            for (int kk = 0; kk <= dg2 * (gravity::drdxfac - 1); ++kk) {
-                Real zz   = lo_k + (static_cast<Real>(kk) + 0.5_rt) * dz_frac;
-                Real zzsq = zz * zz;
-
-                for (int jj = 0; jj <= dg1 * (gravity::drdxfac - 1); ++jj) {
-                    Real yy   = lo_j + (static_cast<Real>(jj) + 0.5_rt) * dy_frac;
-                    Real yysq = yy * yy;
-
-                    for (int ii = 0; ii <= gravity::drdxfac - 1; ++ii) {
-                        Real xx    = lo_i + (static_cast<Real>(ii) + 0.5_rt) * dx_frac;
-                        Real xxsq  = xx * xx;
-
-                        r     = std::sqrt(xxsq + yysq + zzsq);
-                        index = static_cast<int>(r * drinv);
-
-                        Real vol_frac;
-
-                        if (coord_type == 0) {
-
-                            vol_frac = octant_factor * dx_frac * dy_frac * dz_frac;
-
-                        } else if (coord_type == 1) {
-
-                            vol_frac = 2.0_rt * M_PI * dx_frac * dy_frac * octant_factor * xx;
-
-                        } else if (coord_type == 2) {
-
-                            Real rlo = std::abs(lo_i + static_cast<Real>(ii  ) * dx_frac);
-                            Real rhi = std::abs(lo_i + static_cast<Real>(ii+1) * dx_frac);
-                            vol_frac = (4.0_rt / 3.0_rt) * M_PI * (rhi * rhi * rhi - rlo * rlo * rlo);
-
-                        }
-
-                        if (index <= n1d - 1) {
-                            Gpu::Atomic::Add(&radial_mass_ptr[index], vol_frac * u(i,j,k,URHO));
-                            Gpu::Atomic::Add(&radial_vol_ptr[index], vol_frac);
-                        }
-
-                    }
-                }
-            }
-
-        }
-
-    });
-}
-
 void
 Gravity::init_multipole_grav()
 {
@@ -2981,6 +2974,8 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
 
     Real sum_over_levels = 0.;
 
+    Vector<std::unique_ptr<RadialBins>> bins(level+1);
+
     for (int lev = 0; lev <= level; lev++)
     {
         const Real t_old = LevelData[lev]->get_state_data(State_Type).prevTime();
@@ -3037,85 +3032,81 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
 
         int n1d = radial_mass[lev].size();
 
-#ifdef GR_GRAV
-        for (int i = 0; i < n1d; i++) radial_pres[lev][i] = 0.;
-#endif
-        for (int i = 0; i < n1d; i++) radial_vol[lev][i] = 0.;
-        for (int i = 0; i < n1d; i++) radial_mass[lev][i] = 0.;
-
         const Geometry& geom = parent->Geom(lev);
         const Real* dx   = geom.CellSize();
         Real dr = dx[0] / static_cast<Real>(gravity::drdxfac);
 
-#ifdef _OPENMP
-        int nthreads = omp_get_max_threads();
-#ifdef GR_GRAV
-        Vector< RealVector > priv_radial_pres(nthreads);
-#endif
-        Vector< RealVector > priv_radial_mass(nthreads);
-        Vector< RealVector > priv_radial_vol (nthreads);
-        for (int i=0; i<nthreads; i++) {
+        // Bin the density (and for GR, the pressure) into radial shells. We
+        // may be coming in here with a masked out zone (in a zone on a coarse
+        // level underlying a fine level). We don't want to be calling the EOS
+        // in this case, so we'll skip these masked out zones (which will have
+        // rho exactly equal to zero).
+
 #ifdef GR_GRAV
-            priv_radial_pres[i].resize(n1d,0.0);
-#endif
-            priv_radial_mass[i].resize(n1d,0.0);
-            priv_radial_vol [i].resize(n1d,0.0);
-        }
-#pragma omp parallel
-#endif
+        bins[lev] = std::make_unique<RadialBins>(n1d, 2);
+
+        bins[lev]->accumulate<2>(S, geom, dr, gravity::drdxfac, lev == 0,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, Array4<Real const> const& u,
+                                   GpuArray<Real, 3> const& /*loc*/, Real* vals) noexcept
         {
-#ifdef _OPENMP
-            int tid = omp_get_thread_num();
-#endif
-            for (MFIter mfi(S, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-            {
-                const Box& bx = mfi.tilebox();
-                FArrayBox& fab = S[mfi];
+            vals[0] = u(i,j,k,URHO);
+            vals[1] = 0.0_rt;
 
-                compute_radial_mass(bx,
-                                    fab.array(),
-#ifdef _OPENMP
-                                    priv_radial_mass[tid],
-                                    priv_radial_vol[tid],
-#else
-                                    radial_mass[lev],
-                                    radial_vol[lev],
+            if (u(i,j,k,URHO) == 0.0_rt) {
+                return;
+            }
+
+            Real rhoInv = 1.0_rt / u(i,j,k,URHO);
+
+            eos_t eos_state;
+            eos_state.rho = u(i,j,k,URHO);
+            eos_state.T = u(i,j,k,UTEMP);
+            eos_state.e = u(i,j,k,UEINT) * rhoInv;
+            for (int n = 0; n < NumSpec; n++) {
+                eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+            }
+#if NAUX_NET > 0
+            for (int n = 0; n < NumAux; n++) {
+                eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+            }
 #endif
-                                    n1d, lev);
 
-#ifdef GR_GRAV
-                ca_compute_avgpres(AMREX_ARLIM_ANYD(bx.loVect()), AMREX_ARLIM_ANYD(bx.hiVect()),
-                                   dx, dr,
-                                   BL_TO_FORTRAN_ANYD(fab),
-#ifdef _OPENMP
-                                   priv_radial_pres[tid].dataPtr(),
+            eos(eos_input_re, eos_state);
+
+            vals[1] = eos_state.p;
+        });
 #else
-                                   radial_pres[lev].dataPtr(),
-#endif
-                                   ZFILL(geom.ProbLo()), n1d, gravity::drdxfac, lev);
-#endif
-            }
+        bins[lev] = std::make_unique<RadialBins>(n1d, 1);
 
-#ifdef _OPENMP
-#pragma omp barrier
-#pragma omp for
-            for (int i=0; i<n1d; i++) {
-                for (int it=0; it<nthreads; it++) {
-#ifdef GR_GRAV
-                    radial_pres[lev][i] += priv_radial_pres[it][i];
-#endif
-                    radial_mass[lev][i] += priv_radial_mass[it][i];
-                    radial_vol [lev][i] += priv_radial_vol [it][i];
-                }
-            }
+        bins[lev]->accumulate<1>(S, geom, dr, gravity::drdxfac, lev == 0,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, Array4<Real const> const& u,
+                                   GpuArray<Real, 3> const& /*loc*/, Real* vals) noexcept
+        {
+            vals[0] = u(i,j,k,URHO);
+        });
 #endif
-        }
+    }
+
+    // Sum the bins for all levels over all ranks at once.
+
+    Vector<RadialBins*> all_bins;
+    for (int lev = 0; lev <= level; lev++) {
+        all_bins.push_back(bins[lev].get());
+    }
+
+    RadialBins::reduce(all_bins);
 
-        ParallelDescriptor::ReduceRealSum(radial_mass[lev].dataPtr() ,n1d);
-        ParallelDescriptor::ReduceRealSum(radial_vol[lev].dataPtr()  ,n1d);
+    for (int lev = 0; lev <= level; lev++)
+    {
+        int n1d = radial_mass[lev].size();
+
+        for (int i = 0; i < n1d; i++) {
+            radial_vol[lev][i] = bins[lev]->volume(i);
+            radial_mass[lev][i] = bins[lev]->sum(i, 0);
 #ifdef GR_GRAV
-        ParallelDescriptor::ReduceRealSum(radial_pres[lev].dataPtr()  ,n1d);
+            radial_pres[lev][i] = bins[lev]->sum(i, 1);
 #endif
+        }
 
         if (do_diag > 0)
         {
@@ -3518,6 +3509,8 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
         mlmg.setNSolve(gravity::mlmg_nsolve);
         final_resnorm = mlmg.solve(phi, rhs, rel_eps, abs_eps);
 
+        telemetry::add_count(crse_level, telemetry::mlmg_iters, static_cast<Real>(mlmg.getNumIters()));
+
         mlmg.getGradSolution(grad_phi);
     }
     else if (!res.empty())
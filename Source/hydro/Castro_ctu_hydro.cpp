@@ -2,6 +2,7 @@
 #include <Castro_util.H>
 #include <Castro_F.H>
 #include <Castro_hydro.H>
+#include <telemetry.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -18,6 +19,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 {
 
   BL_PROFILE("Castro::construct_ctu_hydro_source()");
+  telemetry::ScopedTimer telemetry_timer(level, telemetry::hydro);
 
   const Real strt_time = ParallelDescriptor::second();
 
@@ -1,6 +1,7 @@
 #include <Castro.H>
 #include <Castro_F.H>
 #include <Castro_util.H>
+#include <telemetry.H>
 
 #ifdef DIFFUSION
 #include <diffusion_util.H>
@@ -25,6 +26,7 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
 #else
 
   BL_PROFILE("Castro::construct_mol_hydro_source()");
+  telemetry::ScopedTimer telemetry_timer(level, telemetry::hydro);
 
 
   const Real strt_time = ParallelDescriptor::second();
@@ -1,11 +1,17 @@
 #include <Castro.H>
 #include <Castro_F.H>
 
+#include <telemetry.H>
+
 using namespace amrex;
 
 void
 Castro::construct_ctu_mhd_source(Real time, Real dt)
 {
+      BL_PROFILE("Castro::construct_ctu_mhd_source()");
+
+      telemetry::ScopedTimer telemetry_timer(level, telemetry::hydro);
+
       if (verbose && ParallelDescriptor::IOProcessor())
         std::cout << "... mhd ...!!! " << std::endl << std::endl;
 
@@ -29,9 +35,15 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
       BL_ASSERT(NUM_GROW == 6);
 
+      // The work is done tile by tile, with hydro_tile_size, and the
+      // temporaries below are private to each thread and reused from one
+      // tile to the next.  We keep track of the largest amount of
+      // temporary storage any tile needs.
+
+      Long tile_bytes_max = 0;
 
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel reduction(max:tile_bytes_max)
 #endif
     {
 
@@ -74,9 +86,11 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
       FArrayBox div;
 
-      for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
+      for (MFIter mfi(S_new, hydro_tile_size); mfi.isValid(); ++mfi)
         {
 
+          Long fab_size = 0;
+
           const Box& bx = mfi.tilebox();
           const Box& obx = amrex::grow(bx, 1);
           const Box& gbx = amrex::grow(bx, 2);
@@ -133,40 +147,49 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flux[0].resize(nbxf, NUM_STATE+3);
           auto flxx_arr = flux[0].array();
           auto elix_flxx = flux[0].elixir();
+          fab_size += flux[0].nBytes();
 
           E[0].resize(nbxe);
           auto Ex_arr = E[0].array();
           auto elix_Ex = E[0].elixir();
+          fab_size += E[0].nBytes();
 
           flux[1].resize(nbyf, NUM_STATE+3);
           auto flxy_arr = flux[1].array();
           auto elix_flxy = flux[1].elixir();
+          fab_size += flux[1].nBytes();
 
           E[1].resize(nbye);
           auto Ey_arr = E[1].array();
           auto elix_Ey = E[1].elixir();
+          fab_size += E[1].nBytes();
 
           flux[2].resize(nbzf, NUM_STATE+3);
           auto flxz_arr = flux[2].array();
           auto elix_flxz = flux[2].elixir();
+          fab_size += flux[2].nBytes();
 
           E[2].resize(nbze);
           auto Ez_arr = E[2].array();
           auto elix_Ez = E[2].elixir();
+          fab_size += E[2].nBytes();
 
 
           // Calculate primitives based on conservatives
           q.resize(bx_gc, NQ);
           auto q_arr = q.array();
           auto elix_q = q.elixir();
+          fab_size += q.nBytes();
 
           qaux.resize(bx_gc, NQAUX);
           auto qaux_arr = qaux.array();
           auto elix_qaux = qaux.elixir();
+          fab_size += qaux.nBytes();
 
           srcQ.resize(bx_gc, NQSRC);
           auto src_q_arr = srcQ.array();
           auto elix_src_q = srcQ.elixir();
+          fab_size += srcQ.nBytes();
 
           ctoprim(bx_gc, time,
                   u_arr,
@@ -185,10 +208,12 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flatn.resize(bxi, 1);
           auto flatn_arr = flatn.array();
           auto elix_flatn = flatn.elixir();
+          fab_size += flatn.nBytes();
 
           flatg.resize(bxi, 1);
           auto flatg_arr = flatg.array();
           auto elix_flatg = flatg.elixir();
+          fab_size += flatg.nBytes();
 
           if (use_flattening == 0) {
             amrex::ParallelFor(bxi,
@@ -210,30 +235,42 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
           }
 
-          // Interpolate Cell centered values to faces
-          qleft[0].resize(bx_gc, NQ);
+          // Interpolate Cell centered values to faces.  The reconstruction
+          // is done in the zones of bxi, giving the right state on each of
+          // their low faces and the left state on their high faces.
+          const Box& bxqx = amrex::growHi(bxi, 0, 1);
+          const Box& bxqy = amrex::growHi(bxi, 1, 1);
+          const Box& bxqz = amrex::growHi(bxi, 2, 1);
+
+          qleft[0].resize(bxqx, NQ);
           auto qx_left_arr = qleft[0].array();
           auto elix_qx_left = qleft[0].elixir();
+          fab_size += qleft[0].nBytes();
 
-          qright[0].resize(bx_gc, NQ);
+          qright[0].resize(bxqx, NQ);
           auto qx_right_arr = qright[0].array();
           auto elix_qx_right = qright[0].elixir();
+          fab_size += qright[0].nBytes();
 
-          qleft[1].resize(bx_gc, NQ);
+          qleft[1].resize(bxqy, NQ);
           auto qy_left_arr = qleft[1].array();
           auto elix_qy_left = qleft[1].elixir();
+          fab_size += qleft[1].nBytes();
 
-          qright[1].resize(bx_gc, NQ);
+          qright[1].resize(bxqy, NQ);
           auto qy_right_arr = qright[1].array();
           auto elix_qy_right = qright[1].elixir();
+          fab_size += qright[1].nBytes();
 
-          qleft[2].resize(bx_gc, NQ);
+          qleft[2].resize(bxqz, NQ);
           auto qz_left_arr = qleft[2].array();
           auto elix_qz_left = qleft[2].elixir();
+          fab_size += qleft[2].nBytes();
 
-          qright[2].resize(bx_gc, NQ);
+          qright[2].resize(bxqz, NQ);
           auto qz_right_arr = qright[2].array();
           auto elix_qz_right = qright[2].elixir();
+          fab_size += qright[2].nBytes();
 
 
           for (int idir = 0; idir < AMREX_SPACEDIM; idir++) {
@@ -268,6 +305,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flxx1D.resize(bfx, NUM_STATE+3);
           auto flxx1D_arr = flxx1D.array();
           auto elix_flxx1D = flxx1D.elixir();
+          fab_size += flxx1D.nBytes();
 
           hlld(bfx, qleft[0].array(), qright[0].array(), flxx1D_arr, 0);
 
@@ -278,6 +316,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flxy1D.resize(bfy, NUM_STATE+3);
           auto flxy1D_arr = flxy1D.array();
           auto elix_flxy1D = flxy1D.elixir();
+          fab_size += flxy1D.nBytes();
 
           hlld(bfy, qleft[1].array(), qright[1].array(), flxy1D_arr, 1);
 
@@ -288,6 +327,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flxz1D.resize(bfz, NUM_STATE+3);
           auto flxz1D_arr = flxz1D.array();
           auto elix_flxz1D = flxz1D.elixir();
+          fab_size += flxz1D.nBytes();
 
           hlld(bfz, qleft[2].array(), qright[2].array(), flxz1D_arr, 2);
 
@@ -297,10 +337,12 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           ux_left.resize(gbx, NUM_STATE+3);
           auto ux_left_arr = ux_left.array();
           auto elix_ux_left = ux_left.elixir();
+          fab_size += ux_left.nBytes();
 
           ux_right.resize(gbx, NUM_STATE+3);
           auto ux_right_arr = ux_right.array();
           auto elix_ux_right = ux_right.elixir();
+          fab_size += ux_right.nBytes();
 
           PrimToCons(gbx, qx_left_arr, ux_left_arr);
           PrimToCons(gbx, qx_right_arr, ux_right_arr);
@@ -308,10 +350,12 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           uy_left.resize(gbx, NUM_STATE+3);
           auto uy_left_arr = uy_left.array();
           auto elix_uy_left = uy_left.elixir();
+          fab_size += uy_left.nBytes();
 
           uy_right.resize(gbx, NUM_STATE+3);
           auto uy_right_arr = uy_right.array();
           auto elix_uy_right = uy_right.elixir();
+          fab_size += uy_right.nBytes();
 
           PrimToCons(gbx, qy_left_arr, uy_left_arr);
           PrimToCons(gbx, qy_right_arr, uy_right_arr);
@@ -319,10 +363,12 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           uz_left.resize(gbx, NUM_STATE+3);
           auto uz_left_arr = uz_left.array();
           auto elix_uz_left = uz_left.elixir();
+          fab_size += uz_left.nBytes();
 
           uz_right.resize(gbx, NUM_STATE+3);
           auto uz_right_arr = uz_right.array();
           auto elix_uz_right = uz_right.elixir();
+          fab_size += uz_right.nBytes();
 
           PrimToCons(gbx, qz_left_arr, uz_left_arr);
           PrimToCons(gbx, qz_right_arr, uz_right_arr);
@@ -366,10 +412,12 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           qtmp_left.resize(gbx, NQ);
           auto qtmp_left_arr = qtmp_left.array();
           auto elix_qtmp_left = qtmp_left.elixir();
+          fab_size += qtmp_left.nBytes();
 
           qtmp_right.resize(gbx, NQ);
           auto qtmp_right_arr = qtmp_right.array();
           auto elix_qtmp_right = qtmp_right.elixir();
+          fab_size += qtmp_right.nBytes();
 
           corner_couple(ccbx,
                         qtmp_right_arr, qtmp_left_arr,
@@ -382,6 +430,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flx_xy.resize(ccbx, NUM_STATE+3);
           auto flx_xy_arr = flx_xy.array();
           auto elix_flx_xy = flx_xy.elixir();
+          fab_size += flx_xy.nBytes();
 
           hlld(ccbx, qtmp_left_arr, qtmp_right_arr, flx_xy_arr, 0);
 
@@ -396,6 +445,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flx_xz.resize(ccbx, NUM_STATE+3);
           auto flx_xz_arr = flx_xz.array();
           auto elix_flx_xz = flx_xz.elixir();
+          fab_size += flx_xz.nBytes();
 
           hlld(ccbx, qtmp_left_arr, qtmp_right_arr, flx_xz_arr, 0);
 
@@ -416,6 +466,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flx_yx.resize(ccby, NUM_STATE+3);
           auto flx_yx_arr = flx_yx.array();
           auto elix_flx_yx = flx_yx.elixir();
+          fab_size += flx_yx.nBytes();
 
           hlld(ccby, qtmp_left_arr, qtmp_right_arr, flx_yx_arr, 1);
 
@@ -431,6 +482,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flx_yz.resize(ccby, NUM_STATE+3);
           auto flx_yz_arr = flx_yz.array();
           auto elix_flx_yz = flx_yz.elixir();
+          fab_size += flx_yz.nBytes();
 
           hlld(ccby, qtmp_left_arr, qtmp_right_arr, flx_yz_arr, 1);
 
@@ -450,6 +502,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flx_zx.resize(ccbz, NUM_STATE+3);
           auto flx_zx_arr = flx_zx.array();
           auto elix_flx_zx = flx_zx.elixir();
+          fab_size += flx_zx.nBytes();
 
           hlld(ccbz, qtmp_left_arr, qtmp_right_arr, flx_zx_arr, 2);
 
@@ -465,6 +518,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           flx_zy.resize(ccbz, NUM_STATE+3);
           auto flx_zy_arr = flx_zy.array();
           auto elix_flx_zy = flx_zy.elixir();
+          fab_size += flx_zy.nBytes();
 
           hlld(ccbz, qtmp_left_arr, qtmp_right_arr, flx_zy_arr, 2);
 
@@ -569,6 +623,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           q2D.resize(obx, NQ);
           auto q2D_arr = q2D.array();
           auto elix_q2D = q2D.elixir();
+          fab_size += q2D.nBytes();
 
           prim_half(obx, q2D_arr, q_arr,
                     flxx1D_arr, flxy1D_arr, flxz1D_arr, dt);
@@ -600,6 +655,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
           div.resize(obx, 1);
           Elixir elix_div = div.elixir();
+          fab_size += div.nBytes();
           auto div_arr = div.array();
 
           // compute divu -- we'll use this later when doing the artifical viscosity
@@ -636,7 +692,9 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
           Real dtdx = dt / dx[0];
 
-          amrex::ParallelFor(nbx,
+          // The faces on a tile boundary belong to only one of the tiles.
+
+          amrex::ParallelFor(mfi.nodaltilebox(0),
           [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
           {
             Bxo_arr(i,j,k) = Bx_arr(i,j,k) + dtdx *
@@ -649,7 +707,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           dtdx = 0.0_rt;
 #endif
 
-          amrex::ParallelFor(nby,
+          amrex::ParallelFor(mfi.nodaltilebox(1),
           [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
           {
             Byo_arr(i,j,k) = By_arr(i,j,k) + dtdx *
@@ -662,7 +720,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           dtdx = 0.0_rt;
 #endif
 
-          amrex::ParallelFor(nbz,
+          amrex::ParallelFor(mfi.nodaltilebox(2),
           [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
           {
             Bzo_arr(i,j,k) = Bz_arr(i,j,k) + dtdx *
@@ -670,11 +728,51 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           });
 
 
-          // not sure if this is needed
+          // Store the time-integrated electric field on the edges of
+          // this tile, for the EMF register.  As with the fluxes, we add
+          // for normal integration and copy for simplified SDC.
+
+          for (int idir = 0; idir < AMREX_SPACEDIM; idir++) {
+
+            IntVect edge(1, 1, 1);
+            edge[idir] = 0;
+
+            Array4<Real const> const E_fab = (E[idir]).array();
+            Array4<Real> emf_fab = (*emf[idir]).array(mfi);
+
+            if (time_integration_method == SimplifiedSpectralDeferredCorrections) {
+
+              amrex::ParallelFor(mfi.tilebox(edge),
+              [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+              {
+                emf_fab(i,j,k) = dt * E_fab(i,j,k);
+              });
+
+            } else {
+
+              amrex::ParallelFor(mfi.tilebox(edge),
+              [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+              {
+                emf_fab(i,j,k) += dt * E_fab(i,j,k);
+              });
+
+            }
+
+          }
+
+          // Scale the fluxes by dt and the face area, as the hydrodynamics
+          // does, so that they can go into the flux registers.
 
-          //Ex(ex_lo(1):ex_hi(1),ex_lo(2):ex_hi(2), ex_lo(3):ex_hi(3)) = Extemp(ex_lo(1):ex_hi(1),ex_lo(2):ex_hi(2),ex_lo(3):ex_hi(3))
-          //Ey(ey_lo(1):ey_hi(1),ey_lo(2):ey_hi(2), ey_lo(3):ey_hi(3)) = Eytemp(ey_lo(1):ey_hi(1),ey_lo(2):ey_hi(2),ey_lo(3):ey_hi(3))
-          //Ez(ez_lo(1):ez_hi(1),ez_lo(2):ez_hi(2), ez_lo(3):ez_hi(3)) = Eztemp(ez_lo(1):ez_hi(1),ez_lo(2):ez_hi(2),ez_lo(3):ez_hi(3))
+          for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+
+            const Box& nbx = amrex::surroundingNodes(bx, idir);
+
+            Array4<Real> const flux_arr = (flux[idir]).array();
+            Array4<Real const> const area_arr = (area[idir]).array(mfi);
+
+            scale_flux(nbx, flux_arr, area_arr, dt);
+
+          }
 
           // Store the fluxes from this advance.
 
@@ -715,9 +813,19 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
           } // idir loop
 
+          tile_bytes_max = std::max(tile_bytes_max, fab_size);
+
         }
 
     }
 
+    if (verbose) {
+        ParallelDescriptor::ReduceLongMax(tile_bytes_max, ParallelDescriptor::IOProcessorNumber());
+
+        amrex::Print() << "... mhd: level " << level << ", largest temporary storage for a tile: "
+                       << static_cast<Real>(tile_bytes_max) / (1024.0 * 1024.0) << " MB per thread"
+                       << std::endl;
+    }
+
 }
 
@@ -0,0 +1,164 @@
+#include <AMReX_BLProfiler.H>
+
+#include <emf_register.H>
+
+using namespace amrex;
+
+namespace {
+
+    // The index type of the edges along direction idir: cell-centered in
+    // idir and nodal in the other two directions.
+
+    IndexType edge_type (int idir)
+    {
+        IntVect t(1, 1, 1);
+        t[idir] = 0;
+        return IndexType(t);
+    }
+
+}
+
+void
+EMFRegister::define (const BoxArray& fine_ba, const DistributionMapping& fine_dm,
+                     const IntVect& ratio)
+{
+    m_ratio = ratio;
+
+    BoxArray cba = fine_ba;
+    cba.coarsen(ratio);
+
+    for (int idir = 0; idir < 3; ++idir) {
+        m_reg[idir].define(amrex::convert(cba, edge_type(idir)), fine_dm, 1, 0);
+    }
+
+    m_defined = true;
+}
+
+void
+EMFRegister::setVal (Real val)
+{
+    for (int idir = 0; idir < 3; ++idir) {
+        m_reg[idir].setVal(val);
+    }
+}
+
+void
+EMFRegister::CrseInit (const MultiFab& crse_emf, int idir, Real scale)
+{
+    BL_PROFILE("EMFRegister::CrseInit()");
+
+    AMREX_ASSERT(crse_emf.ixType() == edge_type(idir));
+
+    m_reg[idir].ParallelCopy(crse_emf, 0, 0, 1);
+    m_reg[idir].mult(scale);
+}
+
+void
+EMFRegister::FineAdd (const MultiFab& fine_emf, int idir, Real scale)
+{
+    BL_PROFILE("EMFRegister::FineAdd()");
+
+    AMREX_ASSERT(fine_emf.ixType() == edge_type(idir));
+
+    const int r = m_ratio[idir];
+    const IntVect ratio = m_ratio;
+
+    // The coarse edge (i,j,k) along idir is made up of the r fine edges
+    // starting at (r_x i, r_y j, r_z k) along idir.
+
+    const Real fac = scale / static_cast<Real>(r);
+
+    const int di = idir == 0 ? 1 : 0;
+    const int dj = idir == 1 ? 1 : 0;
+    const int dk = idir == 2 ? 1 : 0;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(m_reg[idir], TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+
+        auto reg = m_reg[idir].array(mfi);
+        const auto fine = fine_emf.array(mfi);
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+        {
+            const int ii = ratio[0] * i;
+            const int jj = ratio[1] * j;
+            const int kk = ratio[2] * k;
+
+            Real sum = 0.0_rt;
+            for (int m = 0; m < r; ++m) {
+                sum += fine(ii + m * di, jj + m * dj, kk + m * dk);
+            }
+
+            reg(i,j,k) += fac * sum;
+        });
+    }
+}
+
+void
+EMFRegister::Reflux (MultiFab& Bx, MultiFab& By, MultiFab& Bz,
+                     const Geometry& crse_geom) const
+{
+    BL_PROFILE("EMFRegister::Reflux()");
+
+    // Gather the corrections onto the coarse edges.  An edge on the
+    // boundary between two fine grids is in the register of both, with
+    // the same value, so we copy rather than add.
+
+    BoxArray cba = Bx.boxArray();
+    cba.enclosedCells();
+
+    const DistributionMapping& cdm = Bx.DistributionMap();
+
+    Array<MultiFab, 3> dE;
+
+    for (int idir = 0; idir < 3; ++idir) {
+        dE[idir].define(amrex::convert(cba, edge_type(idir)), cdm, 1, 0);
+        dE[idir].setVal(0.0);
+        dE[idir].ParallelCopy(m_reg[idir], 0, 0, 1, 0, 0, crse_geom.periodicity());
+    }
+
+    // This is the same discrete curl as in the update of the field in
+    // construct_ctu_mhd_source, with the time step already in the EMFs.
+
+    const auto dx = crse_geom.CellSizeArray();
+
+    const Real dxinv = 1.0_rt / dx[0];
+    const Real dyinv = 1.0_rt / dx[1];
+    const Real dzinv = 1.0_rt / dx[2];
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(cba, cdm, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+        const auto Ex = dE[0].const_array(mfi);
+        const auto Ey = dE[1].const_array(mfi);
+        const auto Ez = dE[2].const_array(mfi);
+
+        auto Bx_arr = Bx.array(mfi);
+        auto By_arr = By.array(mfi);
+        auto Bz_arr = Bz.array(mfi);
+
+        amrex::ParallelFor(mfi.tilebox(IntVect(1, 0, 0)),
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+        {
+            Bx_arr(i,j,k) += dxinv * ((Ey(i,j,k+1) - Ey(i,j,k)) - (Ez(i,j+1,k) - Ez(i,j,k)));
+        });
+
+        amrex::ParallelFor(mfi.tilebox(IntVect(0, 1, 0)),
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+        {
+            By_arr(i,j,k) += dyinv * ((Ez(i+1,j,k) - Ez(i,j,k)) - (Ex(i,j,k+1) - Ex(i,j,k)));
+        });
+
+        amrex::ParallelFor(mfi.tilebox(IntVect(0, 0, 1)),
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+        {
+            Bz_arr(i,j,k) += dzinv * ((Ex(i,j+1,k) - Ex(i,j,k)) - (Ey(i+1,j,k) - Ey(i,j,k)));
+        });
+    }
+}
@@ -5,12 +5,12 @@
 
 using namespace amrex;
 
+template <int dir>
 void
-Castro::hlld(const Box& bx,
-             Array4<Real const> const& qleft,
-             Array4<Real const> const& qright,
-             Array4<Real> const& flx,
-             const int dir) {
+Castro::hlld_dir(const Box& bx,
+                 Array4<Real const> const& qleft,
+                 Array4<Real const> const& qright,
+                 Array4<Real> const& flx) {
 
   // Riemann solve:
 
@@ -20,55 +20,20 @@ Castro::hlld(const Box& bx,
 
 
   // `n` here is the normal
-  // `p` are the perpendicular
-
-  int QMAGN, QMAGP1, QMAGP2;
-  int QVELN, QVELP1, QVELP2;
-  int UMN, UMP1, UMP2;
-  int UMAGN, UMAGP1, UMAGP2;
-
-  if (dir == 0) {
-    QMAGN  = QMAGX;
-    QMAGP1 = QMAGY;
-    QMAGP2 = QMAGZ;
-    QVELN  = QU;
-    QVELP1 = QV;
-    QVELP2 = QW;
-    UMN    = UMX;
-    UMP1   = UMY;
-    UMP2   = UMZ;
-    UMAGN  = UMAGX;
-    UMAGP1 = UMAGY;
-    UMAGP2 = UMAGZ;
-
-  } else if (dir == 1) {
-    QMAGN  = QMAGY;
-    QMAGP1 = QMAGZ;
-    QMAGP2 = QMAGX;
-    QVELN  = QV;
-    QVELP1 = QW;
-    QVELP2 = QU;
-    UMN    = UMY;
-    UMP1   = UMZ;
-    UMP2   = UMX;
-    UMAGN  = UMAGY;
-    UMAGP1 = UMAGZ;
-    UMAGP2 = UMAGX;
-
-  } else if (dir == 2) {
-    QMAGN  = QMAGZ;
-    QMAGP1 = QMAGX;
-    QMAGP2 = QMAGY;
-    QVELN  = QW;
-    QVELP1 = QU;
-    QVELP2 = QV;
-    UMN    = UMZ;
-    UMP1   = UMX;
-    UMP2   = UMY;
-    UMAGN  = UMAGZ;
-    UMAGP1 = UMAGX;
-    UMAGP2 = UMAGY;
-  }
+  // `p` are the perpendicular, cyclic from the normal
+
+  constexpr int QMAGN  = dir == 0 ? QMAGX : (dir == 1 ? QMAGY : QMAGZ);
+  constexpr int QMAGP1 = dir == 0 ? QMAGY : (dir == 1 ? QMAGZ : QMAGX);
+  constexpr int QMAGP2 = dir == 0 ? QMAGZ : (dir == 1 ? QMAGX : QMAGY);
+  constexpr int QVELN  = dir == 0 ? QU : (dir == 1 ? QV : QW);
+  constexpr int QVELP1 = dir == 0 ? QV : (dir == 1 ? QW : QU);
+  constexpr int QVELP2 = dir == 0 ? QW : (dir == 1 ? QU : QV);
+  constexpr int UMN    = dir == 0 ? UMX : (dir == 1 ? UMY : UMZ);
+  constexpr int UMP1   = dir == 0 ? UMY : (dir == 1 ? UMZ : UMX);
+  constexpr int UMP2   = dir == 0 ? UMZ : (dir == 1 ? UMX : UMY);
+  constexpr int UMAGN  = dir == 0 ? UMAGX : (dir == 1 ? UMAGY : UMAGZ);
+  constexpr int UMAGP1 = dir == 0 ? UMAGY : (dir == 1 ? UMAGZ : UMAGX);
+  constexpr int UMAGP2 = dir == 0 ? UMAGZ : (dir == 1 ? UMAGX : UMAGY);
 
   amrex::ParallelFor(bx,
   [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
@@ -434,3 +399,24 @@ Castro::hlld(const Box& bx,
   });
 }
 
+
+void
+Castro::hlld(const Box& bx,
+             Array4<Real const> const& qleft,
+             Array4<Real const> const& qright,
+             Array4<Real> const& flx,
+             const int dir) {
+
+  // the solver is specialized on the direction at compile time, so the
+  // state components it works with are known constants in the kernel
+
+  if (dir == 0) {
+    hlld_dir<0>(bx, qleft, qright, flx);
+
+  } else if (dir == 1) {
+    hlld_dir<1>(bx, qleft, qright, flx);
+
+  } else {
+    hlld_dir<2>(bx, qleft, qright, flx);
+  }
+}
@@ -0,0 +1,279 @@
+#include <Castro.H>
+
+#include <mhd_util.H>
+
+#include <AMReX_MultiFabUtil.H>
+
+using namespace amrex;
+
+namespace {
+
+    // Remove the divergence that a seam puts in the fine zones of one coarse
+    // zone whose field was interpolated from the coarse level.  The zone's
+    // fine faces start at lo, and the seam is its face normal to n on the
+    // low (side = 0) or high (side = 1) side.  The fine field on the seam
+    // differs from the (transversely constant) interpolated one by delta,
+    // less its mean.  We carry delta into the zone, decreasing linearly to
+    // zero at the opposite face, and cancel the divergence that leaves in
+    // each slab of fine zones with transverse faces built from running sums
+    // of delta, which vanish on the boundary of the coarse zone.  Only the
+    // faces inside the coarse zone change.
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void correct_seam (GpuArray<Array4<Real>, 3> const& B, const IntVect& lo, const IntVect& r,
+                       GpuArray<Real, 3> const& dx, const int n, const int side)
+    {
+        const int t1 = n == 0 ? 1 : 0;
+        const int t2 = n == 2 ? 1 : 2;
+
+        const int rn = r[n];
+        const int r1 = r[t1];
+        const int r2 = r[t2];
+
+        // B[d] at the face m zones along n, b along t1 and c along t2 from lo.
+
+        auto face = [&] (int d, int m, int b, int c) -> Real&
+        {
+            int idx[3] = {lo[0], lo[1], lo[2]};
+            idx[n] += m;
+            idx[t1] += b;
+            idx[t2] += c;
+            return B[d](idx[0], idx[1], idx[2]);
+        };
+
+        const int ms = side == 0 ? 0 : rn;
+
+        Real mean = 0.0_rt;
+        for (int c = 0; c < r2; ++c) {
+            for (int b = 0; b < r1; ++b) {
+                mean += face(n, ms, b, c);
+            }
+        }
+        mean /= static_cast<Real>(r1 * r2);
+
+        // The normal faces inside the coarse zone.
+
+        for (int m = 1; m < rn; ++m) {
+            const Real w = side == 0 ? 1.0_rt - static_cast<Real>(m) / rn : static_cast<Real>(m) / rn;
+            for (int c = 0; c < r2; ++c) {
+                for (int b = 0; b < r1; ++b) {
+                    face(n, m, b, c) += w * (face(n, ms, b, c) - mean);
+                }
+            }
+        }
+
+        // That leaves -/+ delta / (rn dx_n) in each fine zone, the same in
+        // every slab, which the transverse faces make up: first the
+        // variation along t1 within each row of constant c, then the
+        // variation of the row sums along t2, which sum to zero.
+
+        const Real sigma = side == 0 ? 1.0_rt : -1.0_rt;
+
+        const Real f1 = sigma * dx[t1] / (rn * dx[n]);
+        const Real f2 = sigma * dx[t2] / (rn * dx[n]);
+
+        Real D_below = 0.0_rt;
+
+        for (int c = 0; c < r2; ++c) {
+
+            if (c > 0) {
+                for (int b = 0; b < r1; ++b) {
+                    for (int a = 0; a < rn; ++a) {
+                        face(t2, a, b, c) += f2 * D_below / r1;
+                    }
+                }
+            }
+
+            Real D = 0.0_rt;
+            for (int b = 0; b < r1; ++b) {
+                D += face(n, ms, b, c) - mean;
+            }
+
+            Real g = 0.0_rt;
+            for (int b = 1; b < r1; ++b) {
+                g += (face(n, ms, b-1, c) - mean) - D / r1;
+                for (int a = 0; a < rn; ++a) {
+                    face(t1, a, b, c) += f1 * g;
+                }
+            }
+
+            D_below += D;
+        }
+    }
+
+}
+
+void
+Castro::avgDown_B ()
+{
+    BL_PROFILE("Castro::avgDown_B()");
+
+    if (level == parent->finestLevel()) return;
+
+    Castro& fine_lev = getLevel(level+1);
+
+    Array<const MultiFab*, AMREX_SPACEDIM> B_fine{&fine_lev.get_new_data(Mag_Type_x),
+                                                  &fine_lev.get_new_data(Mag_Type_y),
+                                                  &fine_lev.get_new_data(Mag_Type_z)};
+
+    Array<MultiFab*, AMREX_SPACEDIM> B_crse{&get_new_data(Mag_Type_x),
+                                            &get_new_data(Mag_Type_y),
+                                            &get_new_data(Mag_Type_z)};
+
+    amrex::average_down_faces(B_fine, B_crse, fine_ratio, geom);
+}
+
+void
+Castro::correct_B_regrid_seams (const BoxArray& old_ba,
+                                MultiFab& Bx, MultiFab& By, MultiFab& Bz)
+{
+    BL_PROFILE("Castro::correct_B_regrid_seams()");
+
+    BL_ASSERT(level > 0);
+
+    const IntVect r = crse_ratio;
+
+    // Mark the coarse zones, including one ghost zone around the new
+    // grids, that were under the old grids of this level.
+
+    BoxArray old_cba = old_ba;
+    old_cba.coarsen(r);
+
+    const Periodicity& period = parent->Geom(level-1).periodicity();
+    const std::vector<IntVect>& pshifts = period.shiftIntVect();
+
+    iMultiFab old_mask(amrex::coarsen(grids, r), dmap, 1, 1);
+    old_mask.setVal(0);
+
+    for (MFIter mfi(old_mask); mfi.isValid(); ++mfi) {
+        auto mask = old_mask.array(mfi);
+        const Box& gbx = mfi.fabbox();
+
+        for (const auto& iv : pshifts) {
+            for (const auto& is : old_cba.intersections(Box(gbx).shift(iv))) {
+                const Box ibx = Box(is.second).shift(-iv);
+
+                amrex::ParallelFor(ibx,
+                [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+                {
+                    mask(i,j,k) = 1;
+                });
+            }
+        }
+    }
+
+    const auto dx = geom.CellSizeArray();
+
+    // Each coarse zone is handled by one thread, and only changes the
+    // faces inside of it.
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(old_mask, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& cbx = mfi.tilebox();
+
+        const auto mask = old_mask.const_array(mfi);
+
+        GpuArray<Array4<Real>, 3> B;
+        B[0] = Bx.array(mfi);
+        B[1] = By.array(mfi);
+        B[2] = Bz.array(mfi);
+
+        amrex::ParallelFor(cbx,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+        {
+            if (mask(i,j,k) != 0) {
+                return;
+            }
+
+            const IntVect lo(r[0] * i, r[1] * j, r[2] * k);
+
+            for (int n = 0; n < 3; ++n) {
+                const int di = n == 0 ? 1 : 0;
+                const int dj = n == 1 ? 1 : 0;
+                const int dk = n == 2 ? 1 : 0;
+
+                if (mask(i-di,j-dj,k-dk) != 0) {
+                    correct_seam(B, lo, r, dx, n, 0);
+                }
+                if (mask(i+di,j+dj,k+dk) != 0) {
+                    correct_seam(B, lo, r, dx, n, 1);
+                }
+            }
+        });
+    }
+}
+
+Real
+Castro::div_B_error ()
+{
+    BL_PROFILE("Castro::div_B_error()");
+
+    const MultiFab& S_new = get_new_data(State_Type);
+
+    const MultiFab& Bx = get_new_data(Mag_Type_x);
+    const MultiFab& By = get_new_data(Mag_Type_y);
+    const MultiFab& Bz = get_new_data(Mag_Type_z);
+
+    const auto dx = geom.CellSizeArray();
+
+    ReduceOps<ReduceOpMax, ReduceOpMax> reduce_op;
+    ReduceData<Real, Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+
+        const auto Bx_arr = Bx.const_array(mfi);
+        const auto By_arr = By.const_array(mfi);
+        const auto Bz_arr = Bz.const_array(mfi);
+
+        reduce_op.eval(bx, reduce_data,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
+        {
+            const Real divB = mhd_div_B(i, j, k, Bx_arr, By_arr, Bz_arr, dx);
+
+            const Real bx_cell_c = 0.5_rt * (Bx_arr(i,j,k) + Bx_arr(i+1,j,k));
+            const Real by_cell_c = 0.5_rt * (By_arr(i,j,k) + By_arr(i,j+1,k));
+            const Real bz_cell_c = 0.5_rt * (Bz_arr(i,j,k) + Bz_arr(i,j,k+1));
+
+            const Real magB = std::sqrt(bx_cell_c * bx_cell_c +
+                                        by_cell_c * by_cell_c +
+                                        bz_cell_c * bz_cell_c);
+
+            return {std::abs(divB) * dx[0], magB};
+        });
+    }
+
+    ReduceTuple hv = reduce_data.value();
+
+    Real err[2] = {amrex::get<0>(hv), amrex::get<1>(hv)};
+    ParallelDescriptor::ReduceRealMax(err, 2);
+
+    return err[1] > 0.0_rt ? err[0] / err[1] : 0.0_rt;
+}
+
+void
+Castro::check_div_B_levels (int lbase, const std::string& when)
+{
+    BL_PROFILE("Castro::check_div_B_levels()");
+
+    for (int lev = lbase; lev <= parent->finestLevel(); ++lev) {
+
+        const Real err = getLevel(lev).div_B_error();
+
+        if (verbose > 0) {
+            amrex::Print() << "... div B after " << when << ": level " << lev
+                           << ", max |div B| dx / max |B| = " << err << std::endl;
+        }
+
+        if (err > 1.e-10_rt && ParallelDescriptor::IOProcessor()) {
+            amrex::Warning("the divergence of B on level " + std::to_string(lev) +
+                           " is not zero after " + when);
+        }
+    }
+}
@@ -5,23 +5,44 @@ using namespace amrex;
 
 #include <mhd_eigen.H>
 #include <slope.H>
+template <int idir, bool limit_characteristic>
 void
-Castro::plm(const Box& bx,
-            const int idir,
-            Array4<Real const> const& s,
-            Array4<Real const> const& qaux,
-            Array4<Real const> const& flatn,
-            Array4<Real const> const& Bx,
-            Array4<Real const> const& By,
-            Array4<Real const> const& Bz,
-            Array4<Real> const& qleft,
-            Array4<Real> const& qright,
-            Array4<Real const> const& srcQ,
-            const Real dt) {
+Castro::plm_dir(const Box& bx,
+                Array4<Real const> const& s,
+                Array4<Real const> const& qaux,
+                Array4<Real const> const& flatn,
+                Array4<Real const> const& Bx,
+                Array4<Real const> const& By,
+                Array4<Real const> const& Bz,
+                Array4<Real> const& qleft,
+                Array4<Real> const& qright,
+                Array4<Real const> const& srcQ,
+                const Real dt) {
 
   // these loops are over cell-centers and for each cell-center, we find the left and
   // right interface states
 
+  // the zone offsets along idir
+
+  constexpr int di = idir == 0 ? 1 : 0;
+  constexpr int dj = idir == 1 ? 1 : 0;
+  constexpr int dk = idir == 2 ? 1 : 0;
+
+  // we use a reduced eigensystem, the normal B field component is
+  // omitted.  These are the normal and transverse velocity and B field
+  // components, with the transverse ones in the order of the eigensystem
+
+  constexpr int QVELN = idir == 0 ? QU : (idir == 1 ? QV : QW);
+  constexpr int QVELT = idir == 0 ? QV : QU;
+  constexpr int QVELTT = idir == 2 ? QV : QW;
+  constexpr int QMAGN = idir == 0 ? QMAGX : (idir == 1 ? QMAGY : QMAGZ);
+  constexpr int QMAGT = idir == 0 ? QMAGY : QMAGX;
+  constexpr int QMAGTT = idir == 2 ? QMAGY : QMAGZ;
+
+  // for reflect BCs, we need to know what the normal component of
+  // the velocity is
+  constexpr int QUN = idir == 0 ? IEIGN_U : (idir == 1 ? IEIGN_V : IEIGN_W);
+
   const auto dx = geom.CellSizeArray();
 
   const int* lo_bc = phys_bc.lo();
@@ -30,90 +51,45 @@ Castro::plm(const Box& bx,
   bool lo_symm = lo_bc[idir] == Symmetry;
   bool hi_symm = hi_bc[idir] == Symmetry;
 
-  const auto domlo = geom.Domain().loVect3d();
-  const auto domhi = geom.Domain().hiVect3d();
+  const int domlo = geom.Domain().smallEnd(idir);
+  const int domhi = geom.Domain().bigEnd(idir);
 
   Real dtdx = dt/dx[idir];
 
+  // the normal component of the face-centered field
+  const auto Bn = idir == 0 ? Bx : (idir == 1 ? By : Bz);
+
   amrex::ParallelFor(bx,
   [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
   {
 
-    bool lo_bc_test = lo_symm && ((idir == 0 && i == domlo[0]) ||
-                                  (idir == 1 && j == domlo[1]) ||
-                                  (idir == 2 && k == domlo[2]));
+    const int in = idir == 0 ? i : (idir == 1 ? j : k);
 
-    bool hi_bc_test = hi_symm && ((idir == 0 && i == domhi[0]) ||
-                                  (idir == 1 && j == domhi[1]) ||
-                                  (idir == 2 && k == domhi[2]));
+    bool lo_bc_test = lo_symm && in == domlo;
+    bool hi_bc_test = hi_symm && in == domhi;
 
     // compute the 1-sided differences used for the slopes
 
     Real Q[NEIGN][5];
 
-    // we use a reduced eigensystem, the normal B field component is
-    // omitted
-
-    // for reflect BCs, we need to know what the normal component of
-    // the velocity is
-    int QUN;
-
-    if (idir == 0) {
-
-      QUN = IEIGN_U;
-
-      // component (Bx) is omitted
-
-      for (int n=0; n < 5; n++) {
-        int offset = n - 2;
-        Q[IEIGN_RHO][n] = s(i+offset,j,k,QRHO);
-        Q[IEIGN_U][n] = s(i+offset,j,k,QU);
-        Q[IEIGN_V][n] = s(i+offset,j,k,QV);
-        Q[IEIGN_W][n] = s(i+offset,j,k,QW);
-        Q[IEIGN_P][n] = s(i+offset,j,k,QPRES);
-        Q[IEIGN_BT][n] = s(i+offset,j,k,QMAGY);
-        Q[IEIGN_BTT][n] = s(i+offset,j,k,QMAGZ);
-      }
-
-    } else if (idir == 1) {
-
-      QUN = IEIGN_V;
-
-      // component (By) is omitted
-
-      for (int n=0; n < 5; n++) {
-        int offset = n - 2;
-
-        Q[IEIGN_RHO][n] = s(i,j+offset,k,QRHO);
-        Q[IEIGN_U][n] = s(i,j+offset,k,QU);
-        Q[IEIGN_V][n] = s(i,j+offset,k,QV);
-        Q[IEIGN_W][n] = s(i,j+offset,k,QW);
-        Q[IEIGN_P][n] = s(i,j+offset,k,QPRES);
-        Q[IEIGN_BT][n] = s(i,j+offset,k,QMAGX);
-        Q[IEIGN_BTT][n] = s(i,j+offset,k,QMAGZ);
-      }
-
-    } else {
-
-      QUN = IEIGN_W;
-
-      // component (Bz) is omitted
-
-      for (int n=0; n < 5; n++) {
-        int offset = n - 2;
-
-        Q[IEIGN_RHO][n] = s(i,j,k+offset,QRHO);
-        Q[IEIGN_U][n] = s(i,j,k+offset,QU);
-        Q[IEIGN_V][n] = s(i,j,k+offset,QV);
-        Q[IEIGN_W][n] = s(i,j,k+offset,QW);
-        Q[IEIGN_P][n] = s(i,j,k+offset,QPRES);
-        Q[IEIGN_BT][n] = s(i,j,k+offset,QMAGX);
-        Q[IEIGN_BTT][n] = s(i,j,k+offset,QMAGY);
-      }
-
+    for (int n = 0; n < 5; n++) {
+      int offset = n - 2;
+      int ii = i + offset * di;
+      int jj = j + offset * dj;
+      int kk = k + offset * dk;
+
+      Q[IEIGN_RHO][n] = s(ii,jj,kk,QRHO);
+      Q[IEIGN_U][n] = s(ii,jj,kk,QU);
+      Q[IEIGN_V][n] = s(ii,jj,kk,QV);
+      Q[IEIGN_W][n] = s(ii,jj,kk,QW);
+      Q[IEIGN_P][n] = s(ii,jj,kk,QPRES);
+      Q[IEIGN_BT][n] = s(ii,jj,kk,QMAGT);
+      Q[IEIGN_BTT][n] = s(ii,jj,kk,QMAGTT);
     }
 
-    // compute the eigenvectors and eigenvalues for this coordinate direction
+    // compute the eigenvectors and eigenvalues for this coordinate
+    // direction once -- they are used both for the limiting and the
+    // characteristic projection
 
     Array1D<Real, 0, NQ-1> q_zone;
     for (int n = 0; n < NQ; n++) {
@@ -124,20 +100,12 @@ Castro::plm(const Box& bx,
 
     Array1D<Real, 0, NEIGN-1> lam;
 
-    evals(lam, as, q_zone, idir);
+    evals<idir>(lam, as, q_zone);
 
     Array2D<Real, 0, NEIGN-1, 0, NEIGN-1> leig;
     Array2D<Real, 0, NEIGN-1, 0, NEIGN-1> reig;
 
-    if (idir == 0) {
-      evecx(leig, reig, as, q_zone);
-
-    } else if (idir == 1) {
-      evecy(leig, reig, as, q_zone);
-
-    } else {
-      evecz(leig, reig, as, q_zone);
-    }
+    evecs<idir>(leig, reig, as, q_zone);
 
     // MHD Source Terms -- from the Miniati paper, Eq. 32 and 33
     Real smhd[NEIGN];
@@ -149,39 +117,18 @@ Castro::plm(const Box& bx,
     smhd[IEIGN_P] = q_zone(QMAGX) * q_zone(QU) +
                     q_zone(QMAGY) * q_zone(QV) +
                     q_zone(QMAGZ) * q_zone(QW);
+    smhd[IEIGN_BT] = q_zone(QVELT);
+    smhd[IEIGN_BTT] = q_zone(QVELTT);
 
-    if (idir == 0) {
-      smhd[IEIGN_BT] = q_zone(QV);
-      smhd[IEIGN_BTT] = q_zone(QW);
-
-      // cross-talk of normal magnetic field direction
-      for (int n = 0; n < NEIGN; n++) {
-        smhd[n] = smhd[n] * (Bx(i+1,j,k) - Bx(i,j,k)) / dx[idir];
-      }
-
-    } else if (idir == 1) {
-      smhd[IEIGN_BT] = q_zone(QU);
-      smhd[IEIGN_BTT] = q_zone(QW);
-
-      // cross-talk of normal magnetic field direction
-      for (int n = 0; n < NEIGN; n++) {
-        smhd[n] = smhd[n] * (By(i,j+1,k) - By(i,j,k)) / dx[idir];
-      }
-
-    } else {
-      smhd[IEIGN_BT] = q_zone(QU);
-      smhd[IEIGN_BTT] = q_zone(QV);
-
-      // cross-talk of normal magnetic field direction
-      for (int n = 0; n < NEIGN; n++) {
-        smhd[n] = smhd[n] * (Bz(i,j,k+1) - Bz(i,j,k)) / dx[idir];
-      }
+    // cross-talk of normal magnetic field direction
+    for (int n = 0; n < NEIGN; n++) {
+      smhd[n] = smhd[n] * (Bn(i+di,j+dj,k+dk) - Bn(i,j,k)) / dx[idir];
     }
 
     // compute the slopes
     Real dq[NEIGN] = {};
 
-    if (mhd_limit_characteristic == 1) {
+    if (limit_characteristic) {
 
       // we are limiting on characteristic variables
       for (int ii = 0; ii < NEIGN; ii++) {
@@ -238,45 +185,22 @@ Castro::plm(const Box& bx,
 
     // left state at i+1/2
 
-    if (idir == 0) {
-      qleft(i+1,j,k,QRHO) = amrex::max(small_dens,
-                                       q_zone(QRHO) + 0.5_rt*summ_p[IEIGN_RHO] + 0.5_rt*dt*smhd[IEIGN_RHO]);
-      qleft(i+1,j,k,QU) = q_zone(QU) + 0.5_rt*summ_p[IEIGN_U] + 0.5_rt*dt*smhd[IEIGN_U];
-      qleft(i+1,j,k,QV) = q_zone(QV) + 0.5_rt*summ_p[IEIGN_V] + 0.5_rt*dt*smhd[IEIGN_V];
-      qleft(i+1,j,k,QW) = q_zone(QW) + 0.5_rt*summ_p[IEIGN_W] + 0.5_rt*dt*smhd[IEIGN_W];
-      qleft(i+1,j,k,QPRES) = amrex::max(small_pres,
-                                        q_zone(QPRES) + 0.5_rt*summ_p[IEIGN_P] + 0.5_rt*dt*smhd[IEIGN_P]);
-
-      qleft(i+1,j,k,QMAGX) = Bx(i+1,j,k); // Bx stuff
-      qleft(i+1,j,k,QMAGY) = q_zone(QMAGY) + 0.5_rt*summ_p[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qleft(i+1,j,k,QMAGZ) = q_zone(QMAGZ) + 0.5_rt*summ_p[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-
-    } else if (idir == 1) {
-      qleft(i,j+1,k,QRHO) = amrex::max(small_dens,
-                                       q_zone(QRHO) + 0.5_rt*summ_p[IEIGN_RHO] + 0.5_rt*dt*smhd[IEIGN_RHO]);
-      qleft(i,j+1,k,QU) = q_zone(QU) + 0.5_rt*summ_p[IEIGN_U] + 0.5_rt*dt*smhd[IEIGN_U];
-      qleft(i,j+1,k,QV) = q_zone(QV) + 0.5_rt*summ_p[IEIGN_V] + 0.5_rt*dt*smhd[IEIGN_V];
-      qleft(i,j+1,k,QW) = q_zone(QW) + 0.5_rt*summ_p[IEIGN_W] + 0.5_rt*dt*smhd[IEIGN_W];
-      qleft(i,j+1,k,QPRES) = amrex::max(small_pres,
-                                        q_zone(QPRES) + 0.5_rt*summ_p[IEIGN_P] + 0.5_rt*dt*smhd[IEIGN_P]);
-
-      qleft(i,j+1,k,QMAGX) = q_zone(QMAGX) + 0.5_rt*summ_p[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qleft(i,j+1,k,QMAGY) = By(i,j+1,k); // By stuff
-      qleft(i,j+1,k,QMAGZ) = q_zone(QMAGZ) + 0.5_rt*summ_p[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
+    const int il = i + di;
+    const int jl = j + dj;
+    const int kl = k + dk;
 
-    } else {
-      qleft(i,j,k+1,QRHO) = amrex::max(small_dens,
-                                       q_zone(QRHO) + 0.5_rt*summ_p[IEIGN_RHO] + 0.5_rt*dt*smhd[IEIGN_RHO]);
-      qleft(i,j,k+1,QU) = q_zone(QU) + 0.5_rt*summ_p[IEIGN_U] + 0.5_rt*dt*smhd[IEIGN_U];
-      qleft(i,j,k+1,QV) = q_zone(QV) + 0.5_rt*summ_p[IEIGN_V] + 0.5_rt*dt*smhd[IEIGN_V];
-      qleft(i,j,k+1,QW) = q_zone(QW) + 0.5_rt*summ_p[IEIGN_W] + 0.5_rt*dt*smhd[IEIGN_W];
-      qleft(i,j,k+1,QPRES) = amrex::max(small_pres,
-                                        q_zone(QPRES) + 0.5_rt*summ_p[IEIGN_P] + 0.5_rt*dt*smhd[IEIGN_P]);
-
-      qleft(i,j,k+1,QMAGX) = q_zone(QMAGX) + 0.5_rt*summ_p[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qleft(i,j,k+1,QMAGY) = q_zone(QMAGY) + 0.5_rt*summ_p[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-      qleft(i,j,k+1,QMAGZ) = Bz(i,j,k+1); // Bz stuff
-    }
+    qleft(il,jl,kl,QRHO) = amrex::max(small_dens,
+                                      q_zone(QRHO) + 0.5_rt*summ_p[IEIGN_RHO] + 0.5_rt*dt*smhd[IEIGN_RHO]);
+    qleft(il,jl,kl,QU) = q_zone(QU) + 0.5_rt*summ_p[IEIGN_U] + 0.5_rt*dt*smhd[IEIGN_U];
+    qleft(il,jl,kl,QV) = q_zone(QV) + 0.5_rt*summ_p[IEIGN_V] + 0.5_rt*dt*smhd[IEIGN_V];
+    qleft(il,jl,kl,QW) = q_zone(QW) + 0.5_rt*summ_p[IEIGN_W] + 0.5_rt*dt*smhd[IEIGN_W];
+    qleft(il,jl,kl,QPRES) = amrex::max(small_pres,
+                                       q_zone(QPRES) + 0.5_rt*summ_p[IEIGN_P] + 0.5_rt*dt*smhd[IEIGN_P]);
+
+    // the normal component is the face-centered field
+    qleft(il,jl,kl,QMAGN) = Bn(il,jl,kl);
+    qleft(il,jl,kl,QMAGT) = q_zone(QMAGT) + 0.5_rt*summ_p[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
+    qleft(il,jl,kl,QMAGTT) = q_zone(QMAGTT) + 0.5_rt*summ_p[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
 
     // right state at i-1/2
     qright(i,j,k,QRHO) = amrex::max(small_dens,
@@ -287,109 +211,43 @@ Castro::plm(const Box& bx,
     qright(i,j,k,QPRES) = amrex::max(small_pres,
                                      q_zone(QPRES) + 0.5_rt*summ_m[IEIGN_P] + 0.5_rt*dt*smhd[IEIGN_P]);
 
-    if (idir == 0) {
-      qright(i,j,k,QMAGX) = Bx(i,j,k); // Bx stuff
-      qright(i,j,k,QMAGY) = q_zone(QMAGY) + 0.5_rt*summ_m[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qright(i,j,k,QMAGZ) = q_zone(QMAGZ) + 0.5_rt*summ_m[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-
-    } else if (idir == 1) {
-      qright(i,j,k,QMAGX) = q_zone(QMAGX) + 0.5_rt*summ_m[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qright(i,j,k,QMAGY) = By(i,j,k); // By stuff
-      qright(i,j,k,QMAGZ) = q_zone(QMAGZ) + 0.5_rt*summ_m[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-
-    } else {
-      qright(i,j,k,QMAGX) = q_zone(QMAGX) + 0.5_rt*summ_m[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qright(i,j,k,QMAGY) = q_zone(QMAGY) + 0.5_rt*summ_m[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-      qright(i,j,k,QMAGZ) = Bz(i,j,k); // Bz stuff
-    }
+    qright(i,j,k,QMAGN) = Bn(i,j,k);
+    qright(i,j,k,QMAGT) = q_zone(QMAGT) + 0.5_rt*summ_m[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
+    qright(i,j,k,QMAGTT) = q_zone(QMAGTT) + 0.5_rt*summ_m[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
 
     // species
+    Real un = q_zone(QVELN);
+
     for (int n = 0; n < NumSpec; n++) {
-      Real un;
       Real X[5];
 
-      if (idir == 0) {
-        for (int m = 0; m < 5; m++) {
-          int offset = m - 2;
-          X[m] = s(i+offset,j,k,QFS+n);
-        }
-        un = s(i,j,k,QU);
-
-      } else if (idir == 1) {
-        for (int m = 0; m < 5; m++) {
-          int offset = m - 2;
-          X[m] = s(i,j+offset,k,QFS+n);
-        }
-        un = s(i,j,k,QV);
-
-      } else {
-        for (int m = 0; m < 5; m++) {
-          int offset = m - 2;
-          X[m] = s(i,j,k+offset,QFS+n);
-        }
-        un = s(i,j,k,QW);
+      for (int m = 0; m < 5; m++) {
+        int offset = m - 2;
+        X[m] = s(i+offset*di,j+offset*dj,k+offset*dk,QFS+n);
       }
 
       Real dX = uslope(X, flatn(i,j,k), false, false);
 
-      if (idir == 0) {
-        qleft(i+1,j,k,QFS+n) = q_zone(QFS+n) + 0.5_rt*(1.0_rt - dtdx*un) * dX;
-      } else if (idir == 1) {
-        qleft(i,j+1,k,QFS+n) = q_zone(QFS+n) + 0.5_rt*(1.0_rt - dtdx*un) * dX;
-      } else {
-        qleft(i,j,k+1,QFS+n) = q_zone(QFS+n) + 0.5_rt*(1.0_rt - dtdx*un) * dX;
-      }
+      qleft(il,jl,kl,QFS+n) = q_zone(QFS+n) + 0.5_rt*(1.0_rt - dtdx*un) * dX;
       qright(i,j,k,QFS+n) = q_zone(QFS+n) - 0.5_rt*(1.0_rt + dtdx*un) * dX;
     }
 
     // rho e
     eos_t eos_state;
 
-    if (idir == 0) {
-      eos_state.rho = qleft(i+1,j,k,QRHO);
-      eos_state.p = qleft(i+1,j,k,QPRES);
-      eos_state.T = s(i,j,k,QTEMP); // some initial guess?
-      for (int n = 0; n < NumSpec; n++) {
-        eos_state.xn[n] = qleft(i+1,j,k,QFS+n);
-      }
-#if NAUX_NET > 0
-      for (int n = 0; n < NumAux; n++) {
-        eos_state.aux[n] = qleft(i+1,j,k,QFX+n);
-      }
-#endif
-      eos(eos_input_rp, eos_state);
-      qleft(i+1,j,k,QREINT) = eos_state.e * eos_state.rho;
-
-    } else if (idir == 1) {
-      eos_state.rho = qleft(i,j+1,k,QRHO);
-      eos_state.p = qleft(i,j+1,k,QPRES);
-      eos_state.T = s(i,j,k,QTEMP); // some initial guess?
-      for (int n = 0; n < NumSpec; n++) {
-        eos_state.xn[n] = qleft(i,j+1,k,QFS+n);
-      }
-#if NAUX_NET > 0
-      for (int n = 0; n < NumAux; n++) {
-        eos_state.aux[n] = qleft(i,j+1,k,QFX+n);
-      }
-#endif
-      eos(eos_input_rp, eos_state);
-      qleft(i,j+1,k,QREINT) = eos_state.e * eos_state.rho;
-
-    } else {
-      eos_state.rho = qleft(i,j,k+1,QRHO);
-      eos_state.p = qleft(i,j,k+1,QPRES);
-      eos_state.T = s(i,j,k,QTEMP); // some initial guess?
-      for (int n = 0; n < NumSpec; n++) {
-        eos_state.xn[n] = qleft(i,j,k+1,QFS+n);
-      }
+    eos_state.rho = qleft(il,jl,kl,QRHO);
+    eos_state.p = qleft(il,jl,kl,QPRES);
+    eos_state.T = s(i,j,k,QTEMP); // some initial guess?
+    for (int n = 0; n < NumSpec; n++) {
+      eos_state.xn[n] = qleft(il,jl,kl,QFS+n);
+    }
 #if NAUX_NET > 0
-      for (int n = 0; n < NumAux; n++) {
-        eos_state.aux[n] = qleft(i,j,k+1,QFX+n);
-      }
-#endif
-      eos(eos_input_rp, eos_state);
-      qleft(i,j,k+1,QREINT) = eos_state. e * eos_state.rho;
+    for (int n = 0; n < NumAux; n++) {
+      eos_state.aux[n] = qleft(il,jl,kl,QFX+n);
     }
+#endif
+    eos(eos_input_rp, eos_state);
+    qleft(il,jl,kl,QREINT) = eos_state.e * eos_state.rho;
 
     eos_state.rho = qright(i,j,k,QRHO);
     eos_state.p = qright(i,j,k,QPRES);
@@ -406,32 +264,13 @@ Castro::plm(const Box& bx,
     qright(i,j,k,QREINT) = eos_state.e * eos_state.rho;
 
     // add source terms
-    if (idir == 0) {
-      qleft(i+1,j,k,QRHO) = amrex::max(small_dens,
-                                       qleft(i+1,j,k,QRHO) + 0.5_rt*dt*srcQ(i,j,k,QRHO));
-      qleft(i+1,j,k,QU) = qleft(i+1,j,k,QU) + 0.5_rt*dt*srcQ(i,j,k,QU);
-      qleft(i+1,j,k,QV) = qleft(i+1,j,k,QV) + 0.5_rt*dt*srcQ(i,j,k,QV);
-      qleft(i+1,j,k,QW) = qleft(i+1,j,k,QW) + 0.5_rt*dt*srcQ(i,j,k,QW);
-      qleft(i+1,j,k,QPRES) = qleft(i+1,j,k,QPRES) + 0.5_rt*dt*srcQ(i,j,k,QPRES);
-      qleft(i+1,j,k,QREINT) = qleft(i+1,j,k,QREINT) + 0.5_rt*dt*srcQ(i,j,k,QREINT);
-
-    } else if (idir == 1) {
-      qleft(i,j+1,k,QRHO) = amrex::max(small_dens,
-                                       qleft(i,j+1,k,QRHO) + 0.5_rt*dt*srcQ(i,j,k,QRHO));
-      qleft(i,j+1,k,QU) = qleft(i,j+1,k,QU) + 0.5_rt*dt*srcQ(i,j,k,QU);
-      qleft(i,j+1,k,QV) = qleft(i,j+1,k,QV) + 0.5_rt*dt*srcQ(i,j,k,QV);
-      qleft(i,j+1,k,QW) = qleft(i,j+1,k,QW) + 0.5_rt*dt*srcQ(i,j,k,QW);
-      qleft(i,j+1,k,QPRES) = qleft(i,j+1,k,QPRES) + 0.5_rt*dt*srcQ(i,j,k,QPRES);
-      qleft(i,j+1,k,QREINT) = qleft(i,j+1,k,QREINT) + 0.5_rt*dt*srcQ(i,j,k,QREINT);
-
-    } else {
-      qleft(i,j,k+1,QRHO) = amrex::max(small_dens, qleft(i,j,k+1,QRHO) + 0.5_rt*dt*srcQ(i,j,k,QRHO));
-      qleft(i,j,k+1,QU) = qleft(i,j,k+1,QU) + 0.5_rt*dt*srcQ(i,j,k,QU);
-      qleft(i,j,k+1,QV) = qleft(i,j,k+1,QV) + 0.5_rt*dt*srcQ(i,j,k,QV);
-      qleft(i,j,k+1,QW) = qleft(i,j,k+1,QW) + 0.5_rt*dt*srcQ(i,j,k,QW);
-      qleft(i,j,k+1,QPRES) = qleft(i,j,k+1,QPRES) + 0.5_rt*dt*srcQ(i,j,k,QPRES);
-      qleft(i,j,k+1,QREINT) = qleft(i,j,k+1,QREINT) + 0.5_rt*dt*srcQ(i,j,k,QREINT);
-    }
+    qleft(il,jl,kl,QRHO) = amrex::max(small_dens,
+                                      qleft(il,jl,kl,QRHO) + 0.5_rt*dt*srcQ(i,j,k,QRHO));
+    qleft(il,jl,kl,QU) = qleft(il,jl,kl,QU) + 0.5_rt*dt*srcQ(i,j,k,QU);
+    qleft(il,jl,kl,QV) = qleft(il,jl,kl,QV) + 0.5_rt*dt*srcQ(i,j,k,QV);
+    qleft(il,jl,kl,QW) = qleft(il,jl,kl,QW) + 0.5_rt*dt*srcQ(i,j,k,QW);
+    qleft(il,jl,kl,QPRES) = qleft(il,jl,kl,QPRES) + 0.5_rt*dt*srcQ(i,j,k,QPRES);
+    qleft(il,jl,kl,QREINT) = qleft(il,jl,kl,QREINT) + 0.5_rt*dt*srcQ(i,j,k,QREINT);
 
     qright(i,j,k,QRHO) = amrex::max(small_dens, qright(i,j,k,QRHO) + 0.5_rt*dt*srcQ(i,j,k,QRHO));
     qright(i,j,k,QU) = qright(i,j,k,QU) + 0.5_rt*dt*srcQ(i,j,k,QU);
@@ -443,3 +282,44 @@ Castro::plm(const Box& bx,
   });
 }
 
+
+void
+Castro::plm(const Box& bx,
+            const int idir,
+            Array4<Real const> const& s,
+            Array4<Real const> const& qaux,
+            Array4<Real const> const& flatn,
+            Array4<Real const> const& Bx,
+            Array4<Real const> const& By,
+            Array4<Real const> const& Bz,
+            Array4<Real> const& qleft,
+            Array4<Real> const& qright,
+            Array4<Real const> const& srcQ,
+            const Real dt) {
+
+  // the reconstruction is specialized on the direction and on whether
+  // we limit on the characteristic variables at compile time, so none of
+  // these choices are made per zone
+
+  if (idir == 0) {
+    if (mhd_limit_characteristic == 1) {
+      plm_dir<0, true>(bx, s, qaux, flatn, Bx, By, Bz, qleft, qright, srcQ, dt);
+    } else {
+      plm_dir<0, false>(bx, s, qaux, flatn, Bx, By, Bz, qleft, qright, srcQ, dt);
+    }
+
+  } else if (idir == 1) {
+    if (mhd_limit_characteristic == 1) {
+      plm_dir<1, true>(bx, s, qaux, flatn, Bx, By, Bz, qleft, qright, srcQ, dt);
+    } else {
+      plm_dir<1, false>(bx, s, qaux, flatn, Bx, By, Bz, qleft, qright, srcQ, dt);
+    }
+
+  } else {
+    if (mhd_limit_characteristic == 1) {
+      plm_dir<2, true>(bx, s, qaux, flatn, Bx, By, Bz, qleft, qright, srcQ, dt);
+    } else {
+      plm_dir<2, false>(bx, s, qaux, flatn, Bx, By, Bz, qleft, qright, srcQ, dt);
+    }
+  }
+}
@@ -7,73 +7,54 @@ using namespace amrex;
 
 #include <mhd_eigen.H>
 
+template <int idir>
 void
-Castro::ppm_mhd(const Box& bx,
-                const int idir,
-                Array4<Real const> const& q_arr,
-                Array4<Real const> const& qaux,
-                Array4<Real const> const& flatn,
-                Array4<Real const> const& Bx,
-                Array4<Real const> const& By,
-                Array4<Real const> const& Bz,
-                Array4<Real> const& qleft,
-                Array4<Real> const& qright,
-                Array4<Real const> const& srcQ,
-                const Real dt) {
+Castro::ppm_mhd_dir(const Box& bx,
+                    Array4<Real const> const& q_arr,
+                    Array4<Real const> const& qaux,
+                    Array4<Real const> const& flatn,
+                    Array4<Real const> const& Bx,
+                    Array4<Real const> const& By,
+                    Array4<Real const> const& Bz,
+                    Array4<Real> const& qleft,
+                    Array4<Real> const& qright,
+                    Array4<Real const> const& srcQ,
+                    const Real dt) {
 
   // these loops are over cell-centers and for each cell-center, we find the left and
   // right interface states
 
-  const auto dx = geom.CellSizeArray();
+  // the zone offsets along idir
 
-  Real dtdx = dt/dx[idir];
-
-  // these are the characteristic variables for this direction
-  int cvars[NEIGN];
-
-  if (idir == 0) {
-
-    // component (Bx) is omitted
-
-    cvars[IEIGN_RHO] = QRHO;
-    cvars[IEIGN_U] = QU;
-    cvars[IEIGN_V] = QV;
-    cvars[IEIGN_W] = QW;
-    cvars[IEIGN_P] = QPRES;
-    cvars[IEIGN_BT] = QMAGY;
-    cvars[IEIGN_BTT] = QMAGZ;
+  constexpr int di = idir == 0 ? 1 : 0;
+  constexpr int dj = idir == 1 ? 1 : 0;
+  constexpr int dk = idir == 2 ? 1 : 0;
 
-  } else if (idir == 1) {
-
-    // component (By) is omitted
-
-    cvars[IEIGN_RHO] = QRHO;
-    cvars[IEIGN_U] = QU;
-    cvars[IEIGN_V] = QV;
-    cvars[IEIGN_W] = QW;
-    cvars[IEIGN_P] = QPRES;
-    cvars[IEIGN_BT] = QMAGX;
-    cvars[IEIGN_BTT] = QMAGZ;
+  // the normal velocity and B field components, and the transverse B
+  // field components in the order of the eigensystem (the normal B
+  // field component is omitted from it)
 
-  } else {
-
-    // component (Bz) is omitted
+  constexpr int QVELN = idir == 0 ? QU : (idir == 1 ? QV : QW);
+  constexpr int QVELT = idir == 0 ? QV : QU;
+  constexpr int QVELTT = idir == 2 ? QV : QW;
+  constexpr int QMAGN = idir == 0 ? QMAGX : (idir == 1 ? QMAGY : QMAGZ);
+  constexpr int QMAGT = idir == 0 ? QMAGY : QMAGX;
+  constexpr int QMAGTT = idir == 2 ? QMAGY : QMAGZ;
 
-    cvars[IEIGN_RHO] = QRHO;
-    cvars[IEIGN_U] = QU;
-    cvars[IEIGN_V] = QV;
-    cvars[IEIGN_W] = QW;
-    cvars[IEIGN_P] = QPRES;
-    cvars[IEIGN_BT] = QMAGX;
-    cvars[IEIGN_BTT] = QMAGY;
+  const auto dx = geom.CellSizeArray();
 
-  }
+  Real dtdx = dt/dx[idir];
 
+  // the normal component of the face-centered field
+  const auto Bn = idir == 0 ? Bx : (idir == 1 ? By : Bz);
 
   amrex::ParallelFor(bx,
   [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
   {
 
+    // these are the characteristic variables for this direction
+    const int cvars[NEIGN] = {QRHO, QU, QV, QW, QPRES, QMAGT, QMAGTT};
+
     // compute the eigenvectors and eigenvalues for this coordinate direction
 
     Array1D<Real, 0, NQ-1> q_zone;
@@ -85,20 +66,12 @@ Castro::ppm_mhd(const Box& bx,
 
     Array1D<Real, 0, NEIGN-1> lam;
 
-    evals(lam, as, q_zone, idir);
+    evals<idir>(lam, as, q_zone);
 
     Array2D<Real, 0, NEIGN-1, 0, NEIGN-1> leig;
     Array2D<Real, 0, NEIGN-1, 0, NEIGN-1> reig;
 
-    if (idir == 0) {
-      evecx(leig, reig, as, q_zone);
-
-    } else if (idir == 1) {
-      evecy(leig, reig, as, q_zone);
-
-    } else {
-      evecz(leig, reig, as, q_zone);
-    }
+    evecs<idir>(leig, reig, as, q_zone);
 
     // do the parabolic reconstruction and compute the integrals under
     // the characteristic waves
@@ -118,28 +91,11 @@ Castro::ppm_mhd(const Box& bx,
 
       int v = cvars[n];
 
-      if (idir == 0) {
-        s[im2] = q_arr(i-2,j,k,v);
-        s[im1] = q_arr(i-1,j,k,v);
-        s[i0]  = q_arr(i,j,k,v);
-        s[ip1] = q_arr(i+1,j,k,v);
-        s[ip2] = q_arr(i+2,j,k,v);
-
-      } else if (idir == 1) {
-        s[im2] = q_arr(i,j-2,k,v);
-        s[im1] = q_arr(i,j-1,k,v);
-        s[i0]  = q_arr(i,j,k,v);
-        s[ip1] = q_arr(i,j+1,k,v);
-        s[ip2] = q_arr(i,j+2,k,v);
-
-      } else {
-        s[im2] = q_arr(i,j,k-2,v);
-        s[im1] = q_arr(i,j,k-1,v);
-        s[i0]  = q_arr(i,j,k,v);
-        s[ip1] = q_arr(i,j,k+1,v);
-        s[ip2] = q_arr(i,j,k+2,v);
-
-      }
+      s[im2] = q_arr(i-2*di,j-2*dj,k-2*dk,v);
+      s[im1] = q_arr(i-di,j-dj,k-dk,v);
+      s[i0]  = q_arr(i,j,k,v);
+      s[ip1] = q_arr(i+di,j+dj,k+dk,v);
+      s[ip2] = q_arr(i+2*di,j+2*dj,k+2*dk,v);
 
       ppm_reconstruct(s, flat, sm, sp);
 
@@ -195,33 +151,12 @@ Castro::ppm_mhd(const Box& bx,
     smhd[IEIGN_P] = q_zone(QMAGX) * q_zone(QU) +
                     q_zone(QMAGY) * q_zone(QV) +
                     q_zone(QMAGZ) * q_zone(QW);
+    smhd[IEIGN_BT] = q_zone(QVELT);
+    smhd[IEIGN_BTT] = q_zone(QVELTT);
 
-    if (idir == 0) {
-      smhd[IEIGN_BT] = q_zone(QV);
-      smhd[IEIGN_BTT] = q_zone(QW);
-
-      // cross-talk of normal magnetic field direction
-      for (int n = 0; n < NEIGN; n++) {
-        smhd[n] = smhd[n] * (Bx(i+1,j,k) - Bx(i,j,k)) / dx[idir];
-      }
-
-    } else if (idir == 1) {
-      smhd[IEIGN_BT] = q_zone(QU);
-      smhd[IEIGN_BTT] = q_zone(QW);
-
-      // cross-talk of normal magnetic field direction
-      for (int n = 0; n < NEIGN; n++) {
-        smhd[n] = smhd[n] * (By(i,j+1,k) - By(i,j,k)) / dx[idir];
-      }
-
-    } else {
-      smhd[IEIGN_BT] = q_zone(QU);
-      smhd[IEIGN_BTT] = q_zone(QV);
-
-      // cross-talk of normal magnetic field direction
-      for (int n = 0; n < NEIGN; n++) {
-        smhd[n] = smhd[n] * (Bz(i,j,k+1) - Bz(i,j,k)) / dx[idir];
-      }
+    // cross-talk of normal magnetic field direction
+    for (int n = 0; n < NEIGN; n++) {
+      smhd[n] = smhd[n] * (Bn(i+di,j+dj,k+dk) - Bn(i,j,k)) / dx[idir];
     }
 
     // Perform the characteristic projection.  Since we are using
@@ -264,21 +199,10 @@ Castro::ppm_mhd(const Box& bx,
     qright(i,j,k,QPRES) = amrex::max(small_pres,
                                      q_ref_right[IEIGN_P] - summ_m[IEIGN_P] + 0.5_rt*dt*smhd[IEIGN_P]);
 
-    if (idir == 0) {
-      qright(i,j,k,QMAGX) = Bx(i,j,k); // Bx stuff
-      qright(i,j,k,QMAGY) = q_ref_right[IEIGN_BT] -  summ_m[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qright(i,j,k,QMAGZ) = q_ref_right[IEIGN_BTT] - summ_m[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-
-    } else if (idir == 1) {
-      qright(i,j,k,QMAGX) = q_ref_right[IEIGN_BT] - summ_m[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qright(i,j,k,QMAGY) = By(i,j,k); // By stuff
-      qright(i,j,k,QMAGZ) = q_ref_right[IEIGN_BTT] - summ_m[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-
-    } else {
-      qright(i,j,k,QMAGX) = q_ref_right[IEIGN_BT] - summ_m[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qright(i,j,k,QMAGY) = q_ref_right[IEIGN_BTT] - summ_m[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-      qright(i,j,k,QMAGZ) = Bz(i,j,k); // Bz stuff
-    }
+    // the normal component is the face-centered field
+    qright(i,j,k,QMAGN) = Bn(i,j,k);
+    qright(i,j,k,QMAGT) = q_ref_right[IEIGN_BT] - summ_m[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
+    qright(i,j,k,QMAGTT) = q_ref_right[IEIGN_BTT] - summ_m[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
 
 
     // left state at i+1/2
@@ -309,151 +233,62 @@ Castro::ppm_mhd(const Box& bx,
       }
     }
 
-    if (idir == 0) {
-      qleft(i+1,j,k,QRHO) = amrex::max(small_dens,
-                                       q_ref_left[IEIGN_RHO] - summ_p[IEIGN_RHO] + 0.5_rt*dt*smhd[IEIGN_RHO]);
-      qleft(i+1,j,k,QU) = q_ref_left[IEIGN_U] - summ_p[IEIGN_U] + 0.5_rt*dt*smhd[IEIGN_U];
-      qleft(i+1,j,k,QV) = q_ref_left[IEIGN_V] - summ_p[IEIGN_V] + 0.5_rt*dt*smhd[IEIGN_V];
-      qleft(i+1,j,k,QW) = q_ref_left[IEIGN_W] - summ_p[IEIGN_W] + 0.5_rt*dt*smhd[IEIGN_W];
-      qleft(i+1,j,k,QPRES) = amrex::max(small_pres,
-                                        q_ref_left[IEIGN_P] - summ_p[IEIGN_P] + 0.5_rt*dt*smhd[IEIGN_P]);
-
-      qleft(i+1,j,k,QMAGX) = Bx(i+1,j,k); // Bx stuff
-      qleft(i+1,j,k,QMAGY) = q_ref_left[IEIGN_BT] - summ_p[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qleft(i+1,j,k,QMAGZ) = q_ref_left[IEIGN_BTT] - summ_p[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-
-    } else if (idir == 1) {
-      qleft(i,j+1,k,QRHO) = amrex::max(small_dens,
-                                       q_ref_left[IEIGN_RHO] - summ_p[IEIGN_RHO] + 0.5_rt*dt*smhd[IEIGN_RHO]);
-      qleft(i,j+1,k,QU) = q_ref_left[IEIGN_U] - summ_p[IEIGN_U] + 0.5_rt*dt*smhd[IEIGN_U];
-      qleft(i,j+1,k,QV) = q_ref_left[IEIGN_V] - summ_p[IEIGN_V] + 0.5_rt*dt*smhd[IEIGN_V];
-      qleft(i,j+1,k,QW) = q_ref_left[IEIGN_W] - summ_p[IEIGN_W] + 0.5_rt*dt*smhd[IEIGN_W];
-      qleft(i,j+1,k,QPRES) = amrex::max(small_pres,
-                                        q_ref_left[IEIGN_P] - summ_p[IEIGN_P] + 0.5_rt*dt*smhd[IEIGN_P]);
-
-      qleft(i,j+1,k,QMAGX) = q_ref_left[IEIGN_BT] - summ_p[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qleft(i,j+1,k,QMAGY) = By(i,j+1,k); // By stuff
-      qleft(i,j+1,k,QMAGZ) = q_ref_left[IEIGN_BTT] - summ_p[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-
-    } else {
-      qleft(i,j,k+1,QRHO) = amrex::max(small_dens,
-                                       q_ref_left[IEIGN_RHO] - summ_p[IEIGN_RHO] + 0.5_rt*dt*smhd[IEIGN_RHO]);
-      qleft(i,j,k+1,QU) = q_ref_left[IEIGN_U] - summ_p[IEIGN_U] + 0.5_rt*dt*smhd[IEIGN_U];
-      qleft(i,j,k+1,QV) = q_ref_left[IEIGN_V] - summ_p[IEIGN_V] + 0.5_rt*dt*smhd[IEIGN_V];
-      qleft(i,j,k+1,QW) = q_ref_left[IEIGN_W] - summ_p[IEIGN_W] + 0.5_rt*dt*smhd[IEIGN_W];
-      qleft(i,j,k+1,QPRES) = amrex::max(small_pres,
-                                        q_ref_left[IEIGN_P] - summ_p[IEIGN_P] + 0.5_rt*dt*smhd[IEIGN_P]);
-
-      qleft(i,j,k+1,QMAGX) = q_ref_left[IEIGN_BT] - summ_p[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
-      qleft(i,j,k+1,QMAGY) = q_ref_left[IEIGN_BTT] - summ_p[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
-      qleft(i,j,k+1,QMAGZ) = Bz(i,j,k+1); // Bz stuff
-    }
+    const int il = i + di;
+    const int jl = j + dj;
+    const int kl = k + dk;
+
+    qleft(il,jl,kl,QRHO) = amrex::max(small_dens,
+                                      q_ref_left[IEIGN_RHO] - summ_p[IEIGN_RHO] + 0.5_rt*dt*smhd[IEIGN_RHO]);
+    qleft(il,jl,kl,QU) = q_ref_left[IEIGN_U] - summ_p[IEIGN_U] + 0.5_rt*dt*smhd[IEIGN_U];
+    qleft(il,jl,kl,QV) = q_ref_left[IEIGN_V] - summ_p[IEIGN_V] + 0.5_rt*dt*smhd[IEIGN_V];
+    qleft(il,jl,kl,QW) = q_ref_left[IEIGN_W] - summ_p[IEIGN_W] + 0.5_rt*dt*smhd[IEIGN_W];
+    qleft(il,jl,kl,QPRES) = amrex::max(small_pres,
+                                       q_ref_left[IEIGN_P] - summ_p[IEIGN_P] + 0.5_rt*dt*smhd[IEIGN_P]);
+
+    qleft(il,jl,kl,QMAGN) = Bn(il,jl,kl);
+    qleft(il,jl,kl,QMAGT) = q_ref_left[IEIGN_BT] - summ_p[IEIGN_BT] + 0.5_rt*dt*smhd[IEIGN_BT];
+    qleft(il,jl,kl,QMAGTT) = q_ref_left[IEIGN_BTT] - summ_p[IEIGN_BTT] + 0.5_rt*dt*smhd[IEIGN_BTT];
 
 
     // species
+    Real un = q_zone(QVELN);
+
     for (int n = 0; n < NumSpec; n++) {
 
       int v = QFS+n;
 
-      if (idir == 0) {
-        s[im2] = q_arr(i-2,j,k,v);
-        s[im1] = q_arr(i-1,j,k,v);
-        s[i0]  = q_arr(i,j,k,v);
-        s[ip1] = q_arr(i+1,j,k,v);
-        s[ip2] = q_arr(i+2,j,k,v);
-
-      } else if (idir == 1) {
-        s[im2] = q_arr(i,j-2,k,v);
-        s[im1] = q_arr(i,j-1,k,v);
-        s[i0]  = q_arr(i,j,k,v);
-        s[ip1] = q_arr(i,j+1,k,v);
-        s[ip2] = q_arr(i,j+2,k,v);
-
-      } else {
-        s[im2] = q_arr(i,j,k-2,v);
-        s[im1] = q_arr(i,j,k-1,v);
-        s[i0]  = q_arr(i,j,k,v);
-        s[ip1] = q_arr(i,j,k+1,v);
-        s[ip2] = q_arr(i,j,k+2,v);
-
-      }
+      s[im2] = q_arr(i-2*di,j-2*dj,k-2*dk,v);
+      s[im1] = q_arr(i-di,j-dj,k-dk,v);
+      s[i0]  = q_arr(i,j,k,v);
+      s[ip1] = q_arr(i+di,j+dj,k+dk,v);
+      s[ip2] = q_arr(i+2*di,j+2*dj,k+2*dk,v);
 
       Real Ips;
       Real Ims;
 
-      Real un;
-
-      if (idir == 0) {
-        un = q_arr(i,j,k,QU);
-
-      } else if (idir == 1) {
-        un = q_arr(i,j,k,QV);
-
-      } else {
-        un = q_arr(i,j,k,QW);
-      }
-
       ppm_reconstruct(s, flat, sm, sp);
       ppm_int_profile_single(sm, sp, s[i0], un, dtdx, Ips, Ims);
 
-      if (idir == 0) {
-        qleft(i+1,j,k,QFS+n) = Ips;
-      } else if (idir == 1) {
-        qleft(i,j+1,k,QFS+n) = Ips;
-      } else {
-        qleft(i,j,k+1,QFS+n) = Ips;
-      }
+      qleft(il,jl,kl,QFS+n) = Ips;
       qright(i,j,k,QFS+n) = Ims;
     }
 
     // rho e
     eos_t eos_state;
 
-    if (idir == 0) {
-      eos_state.rho = qleft(i+1,j,k,QRHO);
-      eos_state.p = qleft(i+1,j,k,QPRES);
-      eos_state.T = q_arr(i,j,k,QTEMP); // some initial guess?
-      for (int n = 0; n < NumSpec; n++) {
-        eos_state.xn[n] = qleft(i+1,j,k,QFS+n);
-      }
-#if NAUX_NET > 0
-      for (int n = 0; n < NumAux; n++) {
-        eos_state.aux[n] = qleft(i+1,j,k,QFX+n);
-      }
-#endif
-      eos(eos_input_rp, eos_state);
-      qleft(i+1,j,k,QREINT) = eos_state.e * eos_state.rho;
-
-    } else if (idir == 1) {
-      eos_state.rho = qleft(i,j+1,k,QRHO);
-      eos_state.p = qleft(i,j+1,k,QPRES);
-      eos_state.T = q_arr(i,j,k,QTEMP); // some initial guess?
-      for (int n = 0; n < NumSpec; n++) {
-        eos_state.xn[n] = qleft(i,j+1,k,QFS+n);
-      }
-#if NAUX_NET > 0
-      for (int n = 0; n < NumAux; n++) {
-        eos_state.aux[n] = qleft(i,j+1,k,QFX+n);
-      }
-#endif
-      eos(eos_input_rp, eos_state);
-      qleft(i,j+1,k,QREINT) = eos_state.e * eos_state.rho;
-
-    } else {
-      eos_state.rho = qleft(i,j,k+1,QRHO);
-      eos_state.p = qleft(i,j,k+1,QPRES);
-      eos_state.T = q_arr(i,j,k,QTEMP); // some initial guess?
-      for (int n = 0; n < NumSpec; n++) {
-        eos_state.xn[n] = qleft(i,j,k+1,QFS+n);
-      }
+    eos_state.rho = qleft(il,jl,kl,QRHO);
+    eos_state.p = qleft(il,jl,kl,QPRES);
+    eos_state.T = q_arr(i,j,k,QTEMP); // some initial guess?
+    for (int n = 0; n < NumSpec; n++) {
+      eos_state.xn[n] = qleft(il,jl,kl,QFS+n);
+    }
 #if NAUX_NET > 0
-      for (int n = 0; n < NumAux; n++) {
-        eos_state.aux[n] = qleft(i,j,k+1,QFX+n);
-      }
-#endif
-      eos(eos_input_rp, eos_state);
-      qleft(i,j,k+1,QREINT) = eos_state. e * eos_state.rho;
+    for (int n = 0; n < NumAux; n++) {
+      eos_state.aux[n] = qleft(il,jl,kl,QFX+n);
     }
+#endif
+    eos(eos_input_rp, eos_state);
+    qleft(il,jl,kl,QREINT) = eos_state.e * eos_state.rho;
 
     eos_state.rho = qright(i,j,k,QRHO);
     eos_state.p = qright(i,j,k,QPRES);
@@ -470,32 +305,13 @@ Castro::ppm_mhd(const Box& bx,
     qright(i,j,k,QREINT) = eos_state.e * eos_state.rho;
 
     // add source terms
-    if (idir == 0) {
-      qleft(i+1,j,k,QRHO) = amrex::max(small_dens,
-                                       qleft(i+1,j,k,QRHO) + 0.5_rt*dt*srcQ(i,j,k,QRHO));
-      qleft(i+1,j,k,QU) = qleft(i+1,j,k,QU) + 0.5_rt*dt*srcQ(i,j,k,QU);
-      qleft(i+1,j,k,QV) = qleft(i+1,j,k,QV) + 0.5_rt*dt*srcQ(i,j,k,QV);
-      qleft(i+1,j,k,QW) = qleft(i+1,j,k,QW) + 0.5_rt*dt*srcQ(i,j,k,QW);
-      qleft(i+1,j,k,QPRES) = qleft(i+1,j,k,QPRES) + 0.5_rt*dt*srcQ(i,j,k,QPRES);
-      qleft(i+1,j,k,QREINT) = qleft(i+1,j,k,QREINT) + 0.5_rt*dt*srcQ(i,j,k,QREINT);
-
-    } else if (idir == 1) {
-      qleft(i,j+1,k,QRHO) = amrex::max(small_dens,
-                                       qleft(i,j+1,k,QRHO) + 0.5_rt*dt*srcQ(i,j,k,QRHO));
-      qleft(i,j+1,k,QU) = qleft(i,j+1,k,QU) + 0.5_rt*dt*srcQ(i,j,k,QU);
-      qleft(i,j+1,k,QV) = qleft(i,j+1,k,QV) + 0.5_rt*dt*srcQ(i,j,k,QV);
-      qleft(i,j+1,k,QW) = qleft(i,j+1,k,QW) + 0.5_rt*dt*srcQ(i,j,k,QW);
-      qleft(i,j+1,k,QPRES) = qleft(i,j+1,k,QPRES) + 0.5_rt*dt*srcQ(i,j,k,QPRES);
-      qleft(i,j+1,k,QREINT) = qleft(i,j+1,k,QREINT) + 0.5_rt*dt*srcQ(i,j,k,QREINT);
-
-    } else {
-      qleft(i,j,k+1,QRHO) = amrex::max(small_dens, qleft(i,j,k+1,QRHO) + 0.5_rt*dt*srcQ(i,j,k,QRHO));
-      qleft(i,j,k+1,QU) = qleft(i,j,k+1,QU) + 0.5_rt*dt*srcQ(i,j,k,QU);
-      qleft(i,j,k+1,QV) = qleft(i,j,k+1,QV) + 0.5_rt*dt*srcQ(i,j,k,QV);
-      qleft(i,j,k+1,QW) = qleft(i,j,k+1,QW) + 0.5_rt*dt*srcQ(i,j,k,QW);
-      qleft(i,j,k+1,QPRES) = qleft(i,j,k+1,QPRES) + 0.5_rt*dt*srcQ(i,j,k,QPRES);
-      qleft(i,j,k+1,QREINT) = qleft(i,j,k+1,QREINT) + 0.5_rt*dt*srcQ(i,j,k,QREINT);
-    }
+    qleft(il,jl,kl,QRHO) = amrex::max(small_dens,
+                                      qleft(il,jl,kl,QRHO) + 0.5_rt*dt*srcQ(i,j,k,QRHO));
+    qleft(il,jl,kl,QU) = qleft(il,jl,kl,QU) + 0.5_rt*dt*srcQ(i,j,k,QU);
+    qleft(il,jl,kl,QV) = qleft(il,jl,kl,QV) + 0.5_rt*dt*srcQ(i,j,k,QV);
+    qleft(il,jl,kl,QW) = qleft(il,jl,kl,QW) + 0.5_rt*dt*srcQ(i,j,k,QW);
+    qleft(il,jl,kl,QPRES) = qleft(il,jl,kl,QPRES) + 0.5_rt*dt*srcQ(i,j,k,QPRES);
+    qleft(il,jl,kl,QREINT) = qleft(il,jl,kl,QREINT) + 0.5_rt*dt*srcQ(i,j,k,QREINT);
 
     qright(i,j,k,QRHO) = amrex::max(small_dens, qright(i,j,k,QRHO) + 0.5_rt*dt*srcQ(i,j,k,QRHO));
     qright(i,j,k,QU) = qright(i,j,k,QU) + 0.5_rt*dt*srcQ(i,j,k,QU);
@@ -507,3 +323,30 @@ Castro::ppm_mhd(const Box& bx,
   });
 }
 
+
+void
+Castro::ppm_mhd(const Box& bx,
+                const int idir,
+                Array4<Real const> const& q_arr,
+                Array4<Real const> const& qaux,
+                Array4<Real const> const& flatn,
+                Array4<Real const> const& Bx,
+                Array4<Real const> const& By,
+                Array4<Real const> const& Bz,
+                Array4<Real> const& qleft,
+                Array4<Real> const& qright,
+                Array4<Real const> const& srcQ,
+                const Real dt) {
+
+  // the reconstruction is specialized on the direction at compile time
+
+  if (idir == 0) {
+    ppm_mhd_dir<0>(bx, q_arr, qaux, flatn, Bx, By, Bz, qleft, qright, srcQ, dt);
+
+  } else if (idir == 1) {
+    ppm_mhd_dir<1>(bx, q_arr, qaux, flatn, Bx, By, Bz, qleft, qright, srcQ, dt);
+
+  } else {
+    ppm_mhd_dir<2>(bx, q_arr, qaux, flatn, Bx, By, Bz, qleft, qright, srcQ, dt);
+  }
+}
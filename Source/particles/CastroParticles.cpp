@@ -1,6 +1,10 @@
 #include <iomanip>
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <string>
 #include <Castro.H>
 #include <Castro_F.H>
@@ -23,6 +27,179 @@ namespace {
     std::vector<int>  timestamp_indices;
     //
     const std::string chk_tracer_particle_file("Tracer");
+
+    //
+    // Binary timestamps (particles.timestamp_format = 1).  Each rank appends
+    // to its own file, which starts with a header
+    //
+    //   "CASTROTS" | int32 version | int32 sizeof(Real) | int32 dim | int32 nvars |
+    //   nvars x (int32 length | name)
+    //
+    // followed by one block per level per timestamp
+    //
+    //   Real time | int32 level | int64 nparticles |
+    //   nparticles x (int64 id | int32 cpu | Real pos[dim] | Real vel[dim] | Real vals[nvars])
+    //
+    // The blocks are collected in memory and only written every
+    // particles.timestamp_flush_interval coarse steps.  See
+    // Util/scripts/read_timestamps.py for a reader.
+    //
+    const int         timestamp_version = 1;
+    std::string       timestamp_header;
+    std::vector<char> timestamp_buffer;
+    int               timestamp_nsteps = 0;
+    bool              timestamp_header_checked = false;
+
+    template <typename T>
+    void append_raw (std::vector<char>& buf, const T& v)
+    {
+        const char* c = reinterpret_cast<const char*>(&v);
+        buf.insert(buf.end(), c, c + sizeof(T));
+    }
+
+    std::string timestamp_file ()
+    {
+        std::string name = timestamp_dir;
+        if (name[name.length()-1] != '/') name += '/';
+        return amrex::Concatenate(name + "Timestamp_", ParallelDescriptor::MyProc(), 5) + ".bin";
+    }
+
+    void make_timestamp_header (const std::vector<std::string>& names)
+    {
+        std::vector<char> h;
+        h.insert(h.end(), "CASTROTS", "CASTROTS" + 8);
+        append_raw(h, static_cast<std::int32_t>(timestamp_version));
+        append_raw(h, static_cast<std::int32_t>(sizeof(Real)));
+        append_raw(h, static_cast<std::int32_t>(AMREX_SPACEDIM));
+        append_raw(h, static_cast<std::int32_t>(names.size()));
+        for (const auto& n : names) {
+            append_raw(h, static_cast<std::int32_t>(n.size()));
+            h.insert(h.end(), n.begin(), n.end());
+        }
+        timestamp_header.assign(h.begin(), h.end());
+    }
+
+    void flush_timestamps ()
+    {
+        if (timestamp_buffer.empty()) {
+            return;
+        }
+
+        BL_PROFILE("Castro::flush_timestamps()");
+
+        const std::string name = timestamp_file();
+
+        // A restarted run appends to the existing file, which must have
+        // been written with the same variables.
+
+        if (!timestamp_header_checked) {
+            timestamp_header_checked = true;
+
+            std::ifstream in(name, std::ios::binary);
+            if (in) {
+                std::string existing(timestamp_header.size(), '\0');
+                in.read(&existing[0], existing.size());
+                if (in.gcount() > 0 && existing != timestamp_header) {
+                    amrex::Abort("particle timestamp file " + name +
+                                 " was written with a different set of variables");
+                }
+                if (in.gcount() == 0) {
+                    timestamp_buffer.insert(timestamp_buffer.begin(),
+                                            timestamp_header.begin(), timestamp_header.end());
+                }
+            } else {
+                timestamp_buffer.insert(timestamp_buffer.begin(),
+                                        timestamp_header.begin(), timestamp_header.end());
+            }
+        }
+
+        std::ofstream out(name, std::ios::binary | std::ios::app);
+        if (!out) {
+            amrex::FileOpenFailed(name);
+        }
+        out.write(timestamp_buffer.data(), timestamp_buffer.size());
+        out.close();
+
+        timestamp_buffer.clear();
+        timestamp_nsteps = 0;
+    }
+
+    // Append a block with the particles at level lev and the
+    // state S (with ghost zones) linearly interpolated to their positions.
+
+    void buffer_timestamps (AmrTracerParticleContainer& pc, const MultiFab& S,
+                            const Geometry& geom, int lev, Real time,
+                            const std::vector<int>& indices)
+    {
+        BL_PROFILE("Castro::buffer_timestamps()");
+
+        const auto plo = geom.ProbLoArray();
+        const auto dxi = geom.InvCellSizeArray();
+        const int nvars = indices.size();
+
+        append_raw(timestamp_buffer, time);
+        append_raw(timestamp_buffer, static_cast<std::int32_t>(lev));
+
+        const std::size_t count_pos = timestamp_buffer.size();
+        append_raw(timestamp_buffer, static_cast<std::int64_t>(0));
+
+        std::int64_t np = 0;
+
+        Gpu::synchronize();
+
+        for (ParIter<AMREX_SPACEDIM> pti(pc, lev); pti.isValid(); ++pti)
+        {
+            const auto& particles = pti.GetArrayOfStructs();
+            const auto s = S.const_array(pti);
+            const Box& fbox = S[pti].box();
+
+            for (const auto& p : particles)
+            {
+                if (p.id() <= 0) continue;
+
+                // Cell-centered linear interpolation weights.
+
+                int  lo[3] = {0, 0, 0};
+                Real w[3] = {0.0, 0.0, 0.0};
+
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    const Real x = (p.pos(d) - plo[d]) * dxi[d] - 0.5_rt;
+                    lo[d] = static_cast<int>(std::floor(x));
+                    w[d] = x - lo[d];
+                    lo[d] = amrex::max(fbox.smallEnd(d), amrex::min(lo[d], fbox.bigEnd(d) - 1));
+                }
+
+                append_raw(timestamp_buffer, static_cast<std::int64_t>(p.id()));
+                append_raw(timestamp_buffer, static_cast<std::int32_t>(p.cpu()));
+
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    append_raw(timestamp_buffer, static_cast<Real>(p.pos(d)));
+                }
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    append_raw(timestamp_buffer, static_cast<Real>(p.rdata(d)));
+                }
+
+                for (int n = 0; n < nvars; ++n) {
+                    Real val = 0.0_rt;
+                    for (int kk = 0; kk <= (AMREX_SPACEDIM == 3 ? 1 : 0); ++kk) {
+                        const Real wz = AMREX_SPACEDIM == 3 ? (kk ? w[2] : 1.0_rt - w[2]) : 1.0_rt;
+                        for (int jj = 0; jj <= (AMREX_SPACEDIM >= 2 ? 1 : 0); ++jj) {
+                            const Real wy = AMREX_SPACEDIM >= 2 ? (jj ? w[1] : 1.0_rt - w[1]) : 1.0_rt;
+                            for (int ii = 0; ii <= 1; ++ii) {
+                                const Real wx = ii ? w[0] : 1.0_rt - w[0];
+                                val += wx * wy * wz * s(lo[0] + ii, lo[1] + jj, lo[2] + kk, indices[n]);
+                            }
+                        }
+                    }
+                    append_raw(timestamp_buffer, val);
+                }
+
+                ++np;
+            }
+        }
+
+        std::memcpy(&timestamp_buffer[count_pos], &np, sizeof(np));
+    }
 }
 
 void
@@ -70,9 +247,18 @@ Castro::ParticleCheckPoint(const std::string& dir)
     {
         if (TracerPC)
             TracerPC->Checkpoint(dir, chk_tracer_particle_file);
+
+        // Keep the timestamp files in step with the checkpoint.
+        flush_timestamps();
     }
 }
 
+void
+Castro::FlushParticleTimestamps ()
+{
+    flush_timestamps();
+}
+
 void
 Castro::ParticlePlotFile(const std::string& dir)
 {
@@ -206,15 +392,41 @@ Castro::TimestampParticles (int ngrow)
 
         // have to do it here, not in read_particle_params, because Density, ..., are set after
         // read_particle_params is called.
-        if (timestamp_density) {
-            timestamp_indices.push_back(URHO);
-            std::cout << "Density = " << URHO << std::endl;
-        }
-        if (timestamp_temperature) {
-            timestamp_indices.push_back(UTEMP);
-            std::cout << "Temp = " << UTEMP << std::endl;
+        // An explicit list of state variables takes precedence over
+        // timestamp_density and timestamp_temperature.
+
+        std::vector<std::string> timestamp_names;
+        ParmParse pp("particles");
+        pp.queryarr("timestamp_vars", timestamp_names);
+
+        if (!timestamp_names.empty()) {
+            for (const auto& name : timestamp_names) {
+                int idx = -1;
+                for (int n = 0; n < NUM_STATE; ++n) {
+                    if (desc_lst[State_Type].name(n) == name) {
+                        idx = n;
+                    }
+                }
+                if (idx < 0) {
+                    amrex::Abort("particles.timestamp_vars: unknown state variable " + name);
+                }
+                timestamp_indices.push_back(idx);
+            }
+        } else {
+            if (timestamp_density) {
+                timestamp_indices.push_back(URHO);
+                timestamp_names.push_back(desc_lst[State_Type].name(URHO));
+                std::cout << "Density = " << URHO << std::endl;
+            }
+            if (timestamp_temperature) {
+                timestamp_indices.push_back(UTEMP);
+                timestamp_names.push_back(desc_lst[State_Type].name(UTEMP));
+                std::cout << "Temp = " << UTEMP << std::endl;
+            }
         }
 
+        make_timestamp_header(timestamp_names);
+
         if (!timestamp_indices.empty()) {
             imax = *(std::max_element(timestamp_indices.begin(), timestamp_indices.end()));
         }
@@ -242,9 +454,24 @@ Castro::TimestampParticles (int ngrow)
                 FillPatchIterator fpi(parent->getLevel(lev), S_new,
                                       ng, time, State_Type, 0, imax+1);
                 const MultiFab& S = fpi.get_mf();
-                TracerPC->Timestamp(basename, S    , lev, time, timestamp_indices);
+                if (particles::timestamp_format == 1) {
+                    buffer_timestamps(*TracerPC, S, parent->Geom(lev), lev, time, timestamp_indices);
+                } else {
+                    TracerPC->Timestamp(basename, S    , lev, time, timestamp_indices);
+                }
             } else {
-                TracerPC->Timestamp(basename, S_new, lev, time, timestamp_indices);
+                if (particles::timestamp_format == 1) {
+                    buffer_timestamps(*TracerPC, S_new, parent->Geom(lev), lev, time, timestamp_indices);
+                } else {
+                    TracerPC->Timestamp(basename, S_new, lev, time, timestamp_indices);
+                }
+            }
+        }
+
+        if (particles::timestamp_format == 1 && level == 0) {
+            ++timestamp_nsteps;
+            if (timestamp_nsteps >= particles::timestamp_flush_interval) {
+                flush_timestamps();
             }
         }
     }
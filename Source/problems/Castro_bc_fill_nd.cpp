@@ -127,70 +127,298 @@ void ca_statefill(Box const& bx, FArrayBox& data,
 
 
 #ifdef MHD
-  void ca_face_fillx(Real* var, const int* var_lo, const int* var_hi,
-                     const int* domlo, const int* domhi, const Real* dx, const Real* xlo,
-                     const Real* time, const int* bc)
-  {
-    int lo[3] = {0};
-    int hi[3] = {0};
-
-    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-      lo[i] = var_lo[i];
-      hi[i] = var_hi[i];
-    }
+namespace {
 
-    const int* bc_f = bc;
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+bool is_extrap_bc (const int bc)
+{
+    return bc == FOEXTRAP || bc == HOEXTRAP;
+}
 
+// Extrapolate the face-centered data q in direction d to the ghost
+// face just outside the valid face iv, using the valid faces iv, iv+s
+// (and iv+2s if quadratic is set), where s = +1 on the lower boundary
+// and s = -1 on the upper boundary.  The other indices come from p.
 
-    face_fillx(AMREX_ARLIM_ANYD(lo), AMREX_ARLIM_ANYD(hi),
-               var, AMREX_ARLIM_ANYD(var_lo), AMREX_ARLIM_ANYD(var_hi),
-               AMREX_ARLIM_ANYD(domlo), AMREX_ARLIM_ANYD(domhi),
-               AMREX_ZFILL(dx), AMREX_ZFILL(xlo), *time, bc_f);
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real face_extrap (Array4<Real> const& q, const int* p, const int d,
+                  const int iv, const int s, const bool quadratic)
+{
+    int r[3] = {p[0], p[1], p[2]};
 
-  }
+    r[d] = iv;
+    const Real q0 = q(r[0], r[1], r[2]);
+    r[d] = iv + s;
+    const Real q1 = q(r[0], r[1], r[2]);
 
-  void ca_face_filly(Real* var, const int* var_lo, const int* var_hi,
-                     const int* domlo, const int* domhi, const Real* dx, const Real* xlo,
-                     const Real* time, const int* bc)
-  {
-    int lo[3] = {0};
-    int hi[3] = {0};
+    if (quadratic) {
+        r[d] = iv + 2 * s;
+        const Real q2 = q(r[0], r[1], r[2]);
+        return 0.125_rt * (15.0_rt * q0 - 10.0_rt * q1 + 3.0_rt * q2);
+    }
 
-    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-      lo[i] = var_lo[i];
-      hi[i] = var_hi[i];
+    return 0.5_rt * (3.0_rt * q0 - q1);
+}
+
+}
+
+void
+face_fill(const Box& bx, Array4<Real> const& q, const Geometry& geom,
+          const BCRec& bcr, const int dir)
+{
+    // Fill the ghost faces of the face-centered (in direction dir)
+    // data q.  The valid faces are those of the cell-centered domain
+    // plus the face on the upper boundary in direction dir.  We first
+    // fill the ghost faces one direction at a time (each direction
+    // spanning the full extent of bx in the other directions, so the
+    // later directions see the ghost data from the earlier ones),
+    // and then correct the edges where two extrapolated boundaries
+    // meet.
+
+    BL_PROFILE("face_fill()");
+
+    const Box& domain = geom.Domain();
+
+    GpuArray<int, 3> vlo, vhi, qlo, qhi, lo_bc, hi_bc;
+
+    for (int d = 0; d < 3; ++d) {
+        if (d < AMREX_SPACEDIM) {
+            vlo[d] = domain.smallEnd(d);
+            vhi[d] = domain.bigEnd(d) + (d == dir ? 1 : 0);
+            qlo[d] = bx.smallEnd(d);
+            qhi[d] = bx.bigEnd(d);
+            lo_bc[d] = bcr.lo(d);
+            hi_bc[d] = bcr.hi(d);
+        } else {
+            vlo[d] = 0;
+            vhi[d] = 0;
+            qlo[d] = 0;
+            qhi[d] = 0;
+            lo_bc[d] = INT_DIR;
+            hi_bc[d] = INT_DIR;
+        }
     }
 
-    const int* bc_f = bc;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
 
+        const bool normal = d == dir;
 
-    face_filly(AMREX_ARLIM_ANYD(lo), AMREX_ARLIM_ANYD(hi),
-               var, AMREX_ARLIM_ANYD(var_lo), AMREX_ARLIM_ANYD(var_hi),
-               AMREX_ARLIM_ANYD(domlo), AMREX_ARLIM_ANYD(domhi),
-               AMREX_ZFILL(dx), AMREX_ZFILL(xlo), *time, bc_f);
+        // For interior / periodic boundaries we copy from the other
+        // side of the domain if this box spans it.
 
-  }
+        const bool spans_domain = qlo[d] < vlo[d] && qhi[d] > vhi[d];
+
+        if (qlo[d] < vlo[d]) {
+
+            Box gbx(bx);
+            gbx.setBig(d, vlo[d] - 1);
+
+            const int bc = lo_bc[d];
+
+            if (is_extrap_bc(bc) || bc == REFLECT_EVEN || spans_domain) {
 
-  void ca_face_fillz(Real* var, const int* var_lo, const int* var_hi,
-                     const int* domlo, const int* domhi, const Real* dx, const Real* xlo,
-                     const Real* time, const int* bc)
-  {
-    int lo[3] = {0};
-    int hi[3] = {0};
+                amrex::ParallelFor(gbx,
+                [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+                {
+                    const int p[3] = {i, j, k};
+                    int r[3] = {i, j, k};
+
+                    const int n = vlo[d] - p[d];
+
+                    if (is_extrap_bc(bc)) {
+                        if (normal) {
+                            r[d] = vlo[d];
+                            const Real q0 = q(r[0], r[1], r[2]);
+                            r[d] = vlo[d] + 1;
+                            q(i,j,k) = 2.0_rt * q0 - q(r[0], r[1], r[2]);
+                            return;
+                        }
+                        r[d] = vlo[d];
+                    } else if (bc == REFLECT_EVEN) {
+                        r[d] = normal ? vlo[d] + n : vlo[d] + n - 1;
+                    } else {
+                        r[d] = normal ? vhi[d] - n : vhi[d] - n + 1;
+                    }
+
+                    q(i,j,k) = q(r[0], r[1], r[2]);
+                });
+
+            }
+
+        }
+
+        if (qhi[d] > vhi[d]) {
+
+            Box gbx(bx);
+            gbx.setSmall(d, vhi[d] + 1);
+
+            const int bc = hi_bc[d];
+
+            if (is_extrap_bc(bc) || bc == REFLECT_EVEN || spans_domain) {
+
+                amrex::ParallelFor(gbx,
+                [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+                {
+                    const int p[3] = {i, j, k};
+                    int r[3] = {i, j, k};
+
+                    const int n = p[d] - vhi[d];
+
+                    if (is_extrap_bc(bc)) {
+                        if (normal) {
+                            r[d] = vhi[d];
+                            const Real q0 = q(r[0], r[1], r[2]);
+                            r[d] = vhi[d] - 1;
+                            q(i,j,k) = 2.0_rt * q0 - q(r[0], r[1], r[2]);
+                            return;
+                        }
+                        r[d] = vhi[d];
+                    } else if (bc == REFLECT_EVEN) {
+                        r[d] = normal ? vhi[d] - n : vhi[d] - n + 1;
+                    } else {
+                        r[d] = normal ? vlo[d] + n : vlo[d] + n - 1;
+                    }
+
+                    q(i,j,k) = q(r[0], r[1], r[2]);
+                });
+
+            }
+
+        }
 
-    for (int i = 0; i < AMREX_SPACEDIM; ++i) {
-      lo[i] = var_lo[i];
-      hi[i] = var_hi[i];
     }
 
-    const int* bc_f = bc;
+    // Now correct the first ghost face along the edges where two
+    // extrapolated boundaries meet, averaging the extrapolations
+    // from each of the two directions.  The edges are done in the
+    // order x-y, x-z, y-z, since the later ones use the corrected
+    // data from the earlier ones.  The corners follow filfc's
+    // sequence: a z-extrapolation from the x-y edge, then the x-z and
+    // y-z averages in turn, so the y-z average is what remains.
 
+#if AMREX_SPACEDIM > 1
+    const int edges[3][2] = {{0, 1}, {0, 2}, {1, 2}};
 
-    face_fillz(AMREX_ARLIM_ANYD(lo), AMREX_ARLIM_ANYD(hi),
-               var, AMREX_ARLIM_ANYD(var_lo), AMREX_ARLIM_ANYD(var_hi),
-               AMREX_ARLIM_ANYD(domlo), AMREX_ARLIM_ANYD(domhi),
-               AMREX_ZFILL(dx), AMREX_ZFILL(xlo), *time, bc_f);
+    for (const auto& e : edges) {
 
-  }
-#endif  
+        const int a = e[0];
+        const int b = e[1];
 
+        if (b >= AMREX_SPACEDIM) {
+            continue;
+        }
+
+        for (int sa = -1; sa <= 1; sa += 2) {
+            for (int sb = -1; sb <= 1; sb += 2) {
+
+                // sa = -1 is the lower boundary in direction a, sa = +1 the upper
+
+                const bool ghost_a = sa < 0 ? qlo[a] < vlo[a] && is_extrap_bc(lo_bc[a])
+                                            : qhi[a] > vhi[a] && is_extrap_bc(hi_bc[a]);
+                const bool ghost_b = sb < 0 ? qlo[b] < vlo[b] && is_extrap_bc(lo_bc[b])
+                                            : qhi[b] > vhi[b] && is_extrap_bc(hi_bc[b]);
+
+                if (!(ghost_a && ghost_b)) {
+                    continue;
+                }
+
+                // last valid face on this side, and whether there are
+                // three valid faces in this box to extrapolate from
+
+                const int ia = sa < 0 ? vlo[a] : vhi[a];
+                const int ib = sb < 0 ? vlo[b] : vhi[b];
+
+                const bool quad_a = sa < 0 ? vlo[a] + 2 <= amrex::min(qhi[a], vhi[a])
+                                           : vhi[a] - 2 >= amrex::max(qlo[a], vlo[a]);
+                const bool quad_b = sb < 0 ? vlo[b] + 2 <= amrex::min(qhi[b], vhi[b])
+                                           : vhi[b] - 2 >= amrex::max(qlo[b], vlo[b]);
+
+                Box ebx(bx);
+                ebx.setSmall(a, ia + sa);
+                ebx.setBig(a, ia + sa);
+                ebx.setSmall(b, ib + sb);
+                ebx.setBig(b, ib + sb);
+
+                amrex::ParallelFor(ebx,
+                [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+                {
+                    const int p[3] = {i, j, k};
+
+                    q(i,j,k) = 0.5_rt * (face_extrap(q, p, b, ib, -sb, quad_b) +
+                                         face_extrap(q, p, a, ia, -sa, quad_a));
+                });
+
+                // As in filfc, the x-y pass then sets the corners where
+                // z is extrapolated too from the corrected x-y edge, by
+                // extrapolation in z alone.  The x-z and y-z passes run
+                // over the full extent of the box in y and x, so they
+                // revisit these corners afterwards, again as in filfc.
+
+                if (a == 0 && b == 1) {
+
+                    const int c = 2;
+
+                    for (int sc = -1; sc <= 1; sc += 2) {
+
+                        const bool ghost_c = sc < 0 ? qlo[c] < vlo[c] && is_extrap_bc(lo_bc[c])
+                                                    : qhi[c] > vhi[c] && is_extrap_bc(hi_bc[c]);
+
+                        if (!ghost_c) {
+                            continue;
+                        }
+
+                        const int ic = sc < 0 ? vlo[c] : vhi[c];
+
+                        const bool quad_c = sc < 0 ? vlo[c] + 2 <= amrex::min(qhi[c], vhi[c])
+                                                   : vhi[c] - 2 >= amrex::max(qlo[c], vlo[c]);
+
+                        Box cbx(ebx);
+                        cbx.setSmall(c, ic + sc);
+                        cbx.setBig(c, ic + sc);
+
+                        amrex::ParallelFor(cbx,
+                        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+                        {
+                            const int p[3] = {i, j, k};
+
+                            q(i,j,k) = face_extrap(q, p, c, ic, -sc, quad_c);
+                        });
+
+                    }
+
+                }
+
+            }
+        }
+
+    }
+#endif
+}
+
+void ca_face_fillx(Box const& bx, FArrayBox& data,
+                   const int dcomp, const int /*numcomp*/,
+                   Geometry const& geom, const Real /*time*/,
+                   const Vector<BCRec>& bcr, const int bcomp,
+                   const int /*scomp*/)
+{
+    face_fill(bx, data.array(dcomp), geom, bcr[bcomp], 0);
+}
+
+void ca_face_filly(Box const& bx, FArrayBox& data,
+                   const int dcomp, const int /*numcomp*/,
+                   Geometry const& geom, const Real /*time*/,
+                   const Vector<BCRec>& bcr, const int bcomp,
+                   const int /*scomp*/)
+{
+    face_fill(bx, data.array(dcomp), geom, bcr[bcomp], 1);
+}
+
+void ca_face_fillz(Box const& bx, FArrayBox& data,
+                   const int dcomp, const int /*numcomp*/,
+                   Geometry const& geom, const Real /*time*/,
+                   const Vector<BCRec>& bcr, const int bcomp,
+                   const int /*scomp*/)
+{
+    face_fill(bx, data.array(dcomp), geom, bcr[bcomp], 2);
+}
+#endif
@@ -3,6 +3,9 @@
 #include <runtime_parameters.H>
 #include <ext_bc_types.H>
 
+#include <limits>
+#include <map>
+
 using namespace amrex;
 
 
@@ -10,6 +13,199 @@ using namespace amrex;
 // that the gravitation acceleration is constant
 
 
+// hse_fill is called on every FillPatch of the state, but the
+// integrated ghost zones only change when the interior zone a column is
+// integrated from changes.  So for each fill box and boundary face we
+// save the density and internal energy of every ghost zone along with
+// the interior state (the key) they were integrated from, and skip the
+// Newton iteration for columns whose key has not changed.  Each fill box
+// has its own storage, so the fills of different boxes never touch the
+// same entry.
+//
+// With time interpolation the same box is filled from both the old and
+// the new state, so each box has two slots, tagged with the time they
+// were last filled at.  A fill at a time neither slot has takes over the
+// slot with the earlier time, so the old- and new-time fills each keep
+// their own columns.  Boxes that are not filled within a coarse
+// timestep (FillPatch temporaries that do not recur, boxes of levels
+// that went away) are dropped by hse_fill_prune_cache.
+
+namespace {
+
+// density, temperature, composition, and the temperature of the
+// second interior zone (used if hse_interp_temp = 1)
+
+constexpr int hse_nkey = 3 + NumSpec + NumAux;
+
+struct HSEColumns
+{
+    Real time = std::numeric_limits<Real>::lowest();
+    Gpu::ManagedVector<Real> key;
+    Gpu::ManagedVector<Real> data;
+};
+
+struct HSEEntry
+{
+    HSEColumns slot[2];
+    bool used = true;
+};
+
+std::map<Vector<int>, HSEEntry> hse_cache_map;
+
+struct HSECacheView
+{
+    Real* key = nullptr;
+    Real* data = nullptr;
+    int depth = 0;
+    Real rtol = 0.0_rt;
+    Dim3 clo = {0, 0, 0};
+    Dim3 clen = {1, 1, 1};
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    bool active () const { return key != nullptr; }
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    int column (int i, int j, int k) const {
+        return (i - clo.x) + clen.x * ((j - clo.y) + clen.y * (k - clo.z));
+    }
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    bool matches (int col, const Real* k) const {
+        const Real* ck = key + col * hse_nkey;
+        // the density is negative until the column is first filled
+        if (ck[0] <= 0.0_rt) {
+            return false;
+        }
+        for (int n = 0; n < hse_nkey; n++) {
+            if (std::abs(k[n] - ck[n]) > rtol * std::abs(ck[n])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void set_key (int col, const Real* k) const {
+        for (int n = 0; n < hse_nkey; n++) {
+            key[col * hse_nkey + n] = k[n];
+        }
+    }
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    Real& dens (int col, int m) const { return data[2 * (col * depth + m)]; }
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    Real& eint (int col, int m) const { return data[2 * (col * depth + m) + 1]; }
+};
+
+// Gather the interior state that the column starting at zone (i, j, k),
+// with next interior zone (i2, j2, k2), is integrated from.
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+void
+hse_cache_key (Array4<Real> const& adv, int i, int j, int k,
+               int i2, int j2, int k2, Real* key)
+{
+    key[0] = adv(i,j,k,URHO);
+    key[1] = adv(i,j,k,UTEMP);
+    for (int n = 0; n < NumSpec; n++) {
+        key[2+n] = adv(i,j,k,UFS+n);
+    }
+#if NAUX_NET > 0
+    for (int n = 0; n < NumAux; n++) {
+        key[2+NumSpec+n] = adv(i,j,k,UFX+n);
+    }
+#endif
+    key[hse_nkey-1] = hse_interp_temp == 1 ? adv(i2,j2,k2,UTEMP) : 0.0_rt;
+}
+
+// Get the cache for the columns gbx of face (0 = -x, 1 = +x, ...),
+// which are integrated depth zones out from the boundary, when filling
+// bx in the fab adv_bx with the state at time.
+
+HSECacheView
+get_hse_cache (const Geometry& geom, const Box& bx, const Box& adv_bx,
+               const int face, const Box& gbx, const int depth,
+               const Real time)
+{
+    HSECacheView view;
+
+    if (hse_use_cache == 0 || depth <= 0) {
+        return view;
+    }
+
+    Vector<int> id;
+    id.reserve(6 * AMREX_SPACEDIM + 1);
+    id.push_back(face);
+    for (const Box& b : {geom.Domain(), bx, adv_bx}) {
+        for (int d = 0; d < AMREX_SPACEDIM; d++) {
+            id.push_back(b.smallEnd(d));
+            id.push_back(b.bigEnd(d));
+        }
+    }
+
+    const int ncols = static_cast<int>(gbx.numPts());
+
+#ifdef _OPENMP
+#pragma omp critical (hse_cache)
+#endif
+    {
+        HSEEntry& e = hse_cache_map[id];
+        e.used = true;
+
+        int s = 0;
+        if (e.slot[0].time != time) {
+            if (e.slot[1].time == time || e.slot[1].time < e.slot[0].time) {
+                s = 1;
+            }
+        }
+
+        HSEColumns& c = e.slot[s];
+
+        if (c.key.empty()) {
+            c.key.resize(ncols * hse_nkey, -1.0_rt);
+            c.data.resize(2 * ncols * depth, 0.0_rt);
+        }
+
+        // A slot taken over from an earlier time keeps its columns:
+        // they are still reused wherever the interior has not changed.
+
+        c.time = time;
+
+        view.key = c.key.data();
+        view.data = c.data.data();
+    }
+
+    view.depth = depth;
+    view.rtol = hse_cache_rtol;
+    view.clo = amrex::lbound(gbx);
+    view.clen = amrex::length(gbx);
+
+    return view;
+}
+
+}
+
+void
+hse_fill_clear_cache ()
+{
+    hse_cache_map.clear();
+}
+
+void
+hse_fill_prune_cache ()
+{
+    for (auto it = hse_cache_map.begin(); it != hse_cache_map.end(); ) {
+        if (it->second.used) {
+            it->second.used = false;
+            ++it;
+        } else {
+            it = hse_cache_map.erase(it);
+        }
+    }
+}
+
+
 void
 hse_fill(const Box& bx, Array4<Real> const& adv,
               Geometry const& geom, const Vector<BCRec>& bcr,
@@ -48,6 +244,9 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(D_DECL(domlo[0]-1, lo[1], lo[2])),
                     IntVect(D_DECL(domlo[0]-1, hi[1], hi[2])));
 
+            auto hse_cache = get_hse_cache(geom, bx, adv_bx, 0, gbx,
+                                           domlo[0] - adv_lo[0], time);
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
             {
@@ -83,9 +282,25 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
-                eos(eos_input_rt, eos_state);
+                // if this column was already integrated from the same
+                // interior state, we can reuse the result
 
-                Real pres_above = eos_state.p;
+                const int col = hse_cache.active() ? hse_cache.column(i, j, k) : -1;
+
+                Real cache_key[hse_nkey];
+                bool cached = false;
+
+                if (col >= 0) {
+                    hse_cache_key(adv, domlo[0], j, k, domlo[0]+1, j, k, cache_key);
+                    cached = hse_cache.matches(col, cache_key);
+                }
+
+                Real pres_above = 0.0_rt;
+
+                if (!cached) {
+                    eos(eos_input_rt, eos_state);
+                    pres_above = eos_state.p;
+                }
 
                 for (int ii = domlo[0]-1; ii >= adv_lo[0]; ii--) {
 
@@ -107,12 +322,20 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                         temp_zone = temp_above;
                     }
 
-                    bool converged_hse = false;
+                    // ghost zone number, counting out from the boundary
+
+                    const int m = domlo[0] - 1 - ii;
+
+                    if (cached) {
+                        dens_zone = hse_cache.dens(col, m);
+                    }
+
+                    bool converged_hse = cached;
 
                     Real p_want;
                     Real drho;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                    for (int iter = 0; iter < hse::MAX_ITER && !converged_hse; iter++) {
 
                         // pressure needed from HSE
 
@@ -190,13 +413,26 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                       }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
+                   Real pres_zone;
+                   Real eint;
+
+                   if (cached) {
+                       pres_zone = 0.0_rt;
+                       eint = hse_cache.eint(col, m);
+                   } else {
+                       eos_state.rho = dens_zone;
+                       eos_state.T = temp_zone;
 
-                   eos(eos_input_rt, eos_state);
+                       eos(eos_input_rt, eos_state);
 
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
+                       pres_zone = eos_state.p;
+                       eint = eos_state.e;
+
+                       if (col >= 0) {
+                           hse_cache.dens(col, m) = dens_zone;
+                           hse_cache.eint(col, m) = eint;
+                       }
+                   }
 
                    // store the final state
 
@@ -222,6 +458,10 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_above = pres_zone;
 
                 }
+
+                if (col >= 0 && !cached) {
+                    hse_cache.set_key(col, cache_key);
+                }
             });
 
         }
@@ -238,6 +478,9 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(D_DECL(domhi[0]+1, lo[1], lo[2])),
                     IntVect(D_DECL(domhi[0]+1, hi[1], hi[2])));
 
+            auto hse_cache = get_hse_cache(geom, bx, adv_bx, 1, gbx,
+                                           adv_hi[0] - domhi[0], time);
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
             {
@@ -273,9 +516,25 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
-                eos(eos_input_rt, eos_state);
+                // if this column was already integrated from the same
+                // interior state, we can reuse the result
+
+                const int col = hse_cache.active() ? hse_cache.column(i, j, k) : -1;
+
+                Real cache_key[hse_nkey];
+                bool cached = false;
+
+                if (col >= 0) {
+                    hse_cache_key(adv, domhi[0], j, k, domhi[0]-1, j, k, cache_key);
+                    cached = hse_cache.matches(col, cache_key);
+                }
+
+                Real pres_below = 0.0_rt;
 
-                Real pres_below = eos_state.p;
+                if (!cached) {
+                    eos(eos_input_rt, eos_state);
+                    pres_below = eos_state.p;
+                }
 
                 for (int ii = domhi[0]+1; ii <= adv_hi[0]; ii++) {
 
@@ -293,12 +552,20 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                         temp_zone = temp_below;
                     }
 
-                    bool converged_hse = false;
+                    // ghost zone number, counting out from the boundary
+
+                    const int m = ii - domhi[0] - 1;
+
+                    if (cached) {
+                        dens_zone = hse_cache.dens(col, m);
+                    }
+
+                    bool converged_hse = cached;
 
                     Real p_want;
                     Real drho;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                    for (int iter = 0; iter < hse::MAX_ITER && !converged_hse; iter++) {
 
                         // pressure needed from HSE
                         p_want = pres_below +
@@ -375,13 +642,26 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
+                   Real pres_zone;
+                   Real eint;
 
-                   eos(eos_input_rt, eos_state);
+                   if (cached) {
+                       pres_zone = 0.0_rt;
+                       eint = hse_cache.eint(col, m);
+                   } else {
+                       eos_state.rho = dens_zone;
+                       eos_state.T = temp_zone;
 
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
+                       eos(eos_input_rt, eos_state);
+
+                       pres_zone = eos_state.p;
+                       eint = eos_state.e;
+
+                       if (col >= 0) {
+                           hse_cache.dens(col, m) = dens_zone;
+                           hse_cache.eint(col, m) = eint;
+                       }
+                   }
 
                    //  store the final state
 
@@ -407,6 +687,10 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_below = pres_zone;
 
                 }
+
+                if (col >= 0 && !cached) {
+                    hse_cache.set_key(col, cache_key);
+                }
             });
 
        }
@@ -428,6 +712,9 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(D_DECL(lo[0], domlo[1]-1, lo[2])),
                     IntVect(D_DECL(hi[0], domlo[1]-1, hi[2])));
 
+            auto hse_cache = get_hse_cache(geom, bx, adv_bx, 2, gbx,
+                                           domlo[1] - adv_lo[1], time);
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
             {
@@ -463,9 +750,25 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
-                eos(eos_input_rt, eos_state);
+                // if this column was already integrated from the same
+                // interior state, we can reuse the result
 
-                Real pres_above = eos_state.p;
+                const int col = hse_cache.active() ? hse_cache.column(i, j, k) : -1;
+
+                Real cache_key[hse_nkey];
+                bool cached = false;
+
+                if (col >= 0) {
+                    hse_cache_key(adv, i, domlo[1], k, i, domlo[1]+1, k, cache_key);
+                    cached = hse_cache.matches(col, cache_key);
+                }
+
+                Real pres_above = 0.0_rt;
+
+                if (!cached) {
+                    eos(eos_input_rt, eos_state);
+                    pres_above = eos_state.p;
+                }
 
                 for (int jj = domlo[1]-1; jj >= adv_lo[1]; jj--) {
 
@@ -484,12 +787,20 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                         temp_zone = temp_above;
                     }
 
-                    bool converged_hse = false;
+                    // ghost zone number, counting out from the boundary
+
+                    const int m = domlo[1] - 1 - jj;
+
+                    if (cached) {
+                        dens_zone = hse_cache.dens(col, m);
+                    }
+
+                    bool converged_hse = cached;
 
                     Real p_want;
                     Real drho;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                    for (int iter = 0; iter < hse::MAX_ITER && !converged_hse; iter++) {
 
                         // pressure needed from HSE
 
@@ -567,13 +878,26 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
+                   Real pres_zone;
+                   Real eint;
 
-                   eos(eos_input_rt, eos_state);
+                   if (cached) {
+                       pres_zone = 0.0_rt;
+                       eint = hse_cache.eint(col, m);
+                   } else {
+                       eos_state.rho = dens_zone;
+                       eos_state.T = temp_zone;
+
+                       eos(eos_input_rt, eos_state);
 
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
+                       pres_zone = eos_state.p;
+                       eint = eos_state.e;
+
+                       if (col >= 0) {
+                           hse_cache.dens(col, m) = dens_zone;
+                           hse_cache.eint(col, m) = eint;
+                       }
+                   }
 
                    // store the final state
 
@@ -599,6 +923,10 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_above = pres_zone;
 
                 }
+
+                if (col >= 0 && !cached) {
+                    hse_cache.set_key(col, cache_key);
+                }
             });
 
        }
@@ -616,6 +944,9 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(D_DECL(lo[0], domhi[1]+1, lo[2])),
                     IntVect(D_DECL(hi[0], domhi[1]+1, hi[2])));
 
+            auto hse_cache = get_hse_cache(geom, bx, adv_bx, 3, gbx,
+                                           adv_hi[1] - domhi[1], time);
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
             {
@@ -651,9 +982,25 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
-                eos(eos_input_rt, eos_state);
+                // if this column was already integrated from the same
+                // interior state, we can reuse the result
+
+                const int col = hse_cache.active() ? hse_cache.column(i, j, k) : -1;
 
-                Real pres_below = eos_state.p;
+                Real cache_key[hse_nkey];
+                bool cached = false;
+
+                if (col >= 0) {
+                    hse_cache_key(adv, i, domhi[1], k, i, domhi[1]-1, k, cache_key);
+                    cached = hse_cache.matches(col, cache_key);
+                }
+
+                Real pres_below = 0.0_rt;
+
+                if (!cached) {
+                    eos(eos_input_rt, eos_state);
+                    pres_below = eos_state.p;
+                }
 
                 for (int jj = domhi[1]+1; jj <= adv_hi[1]; jj++) {
 
@@ -671,12 +1018,20 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                         temp_zone = temp_below;
                     }
 
-                    bool converged_hse = false;
+                    // ghost zone number, counting out from the boundary
+
+                    const int m = jj - domhi[1] - 1;
+
+                    if (cached) {
+                        dens_zone = hse_cache.dens(col, m);
+                    }
+
+                    bool converged_hse = cached;
 
                     Real p_want;
                     Real drho;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                    for (int iter = 0; iter < hse::MAX_ITER && !converged_hse; iter++) {
 
                         // pressure needed from HSE
                         p_want = pres_below +
@@ -753,13 +1108,26 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
+                   Real pres_zone;
+                   Real eint;
+
+                   if (cached) {
+                       pres_zone = 0.0_rt;
+                       eint = hse_cache.eint(col, m);
+                   } else {
+                       eos_state.rho = dens_zone;
+                       eos_state.T = temp_zone;
 
-                   eos(eos_input_rt, eos_state);
+                       eos(eos_input_rt, eos_state);
 
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
+                       pres_zone = eos_state.p;
+                       eint = eos_state.e;
+
+                       if (col >= 0) {
+                           hse_cache.dens(col, m) = dens_zone;
+                           hse_cache.eint(col, m) = eint;
+                       }
+                   }
 
                    // store the final state
 
@@ -785,6 +1153,10 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_below = pres_zone;
 
                 }
+
+                if (col >= 0 && !cached) {
+                    hse_cache.set_key(col, cache_key);
+                }
             });
         }
 
@@ -805,6 +1177,9 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(D_DECL(lo[0], lo[1], domlo[2]-1)),
                     IntVect(D_DECL(hi[0], hi[1], domlo[2]-1)));
 
+            auto hse_cache = get_hse_cache(geom, bx, adv_bx, 4, gbx,
+                                           domlo[2] - adv_lo[2], time);
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
             {
@@ -840,9 +1215,25 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
-                eos(eos_input_rt, eos_state);
+                // if this column was already integrated from the same
+                // interior state, we can reuse the result
+
+                const int col = hse_cache.active() ? hse_cache.column(i, j, k) : -1;
+
+                Real cache_key[hse_nkey];
+                bool cached = false;
+
+                if (col >= 0) {
+                    hse_cache_key(adv, i, j, domlo[2], i, j, domlo[2]+1, cache_key);
+                    cached = hse_cache.matches(col, cache_key);
+                }
+
+                Real pres_above = 0.0_rt;
 
-                Real pres_above = eos_state.p;
+                if (!cached) {
+                    eos(eos_input_rt, eos_state);
+                    pres_above = eos_state.p;
+                }
 
                 for (int kk = domlo[2]-1; kk >= adv_lo[2]; kk--) {
 
@@ -861,12 +1252,20 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                         temp_zone = temp_above;
                     }
 
-                    bool converged_hse = false;
+                    // ghost zone number, counting out from the boundary
+
+                    const int m = domlo[2] - 1 - kk;
+
+                    if (cached) {
+                        dens_zone = hse_cache.dens(col, m);
+                    }
+
+                    bool converged_hse = cached;
 
                     Real p_want;
                     Real drho;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                    for (int iter = 0; iter < hse::MAX_ITER && !converged_hse; iter++) {
 
                         // pressure needed from HSE
 
@@ -944,13 +1343,26 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
+                   Real pres_zone;
+                   Real eint;
 
-                   eos(eos_input_rt, eos_state);
+                   if (cached) {
+                       pres_zone = 0.0_rt;
+                       eint = hse_cache.eint(col, m);
+                   } else {
+                       eos_state.rho = dens_zone;
+                       eos_state.T = temp_zone;
 
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
+                       eos(eos_input_rt, eos_state);
+
+                       pres_zone = eos_state.p;
+                       eint = eos_state.e;
+
+                       if (col >= 0) {
+                           hse_cache.dens(col, m) = dens_zone;
+                           hse_cache.eint(col, m) = eint;
+                       }
+                   }
 
                    // store the final state
 
@@ -976,6 +1388,10 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_above = pres_zone;
 
                 }
+
+                if (col >= 0 && !cached) {
+                    hse_cache.set_key(col, cache_key);
+                }
             });
         }
 
@@ -7,6 +7,7 @@
 #include <rad_util.H>
 
 #include <iostream>
+#include <stdexcept>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -50,7 +51,8 @@ HypreABec::HypreABec(const BoxArray& grids,
                      const DistributionMapping& dmap,
                      const Geometry& _geom,
                      int _solver_flag)
-  : geom(_geom), solver_flag(_solver_flag)
+  : geom(_geom), solver_flag(_solver_flag),
+    mlmg_maxiter(0), mlmg_iters(0), mlmg_residual(0.0)
 {
   ParmParse pp("habec");
 
@@ -73,6 +75,27 @@ HypreABec::HypreABec(const BoxArray& grids,
     dx[i] = geom.CellSize(i);
   }
 
+  int ncomp=1;
+  int ngrow=0;
+  acoefs.reset(new MultiFab(grids, dmap, ncomp, ngrow));
+  acoefs->setVal(0.0);
+ 
+  for (int i = 0; i < BL_SPACEDIM; i++) {
+    BoxArray edge_boxes(grids);
+    edge_boxes.surroundingNodes(i);
+    bcoefs[i].reset(new MultiFab(edge_boxes, dmap, ncomp, ngrow));
+  }
+
+  if (solver_flag == 10) {
+    // MLMG works on MultiFabs directly; none of the Hypre grid,
+    // matrix and vectors are needed.
+    mlacoefs.reset(new MultiFab(grids, dmap, ncomp, ngrow));
+    for (int i = 0; i < BL_SPACEDIM; i++) {
+      mlbcoefs[i].reset(new MultiFab(bcoefs[i]->boxArray(), dmap, ncomp, ngrow));
+    }
+    return;
+  }
+
 #if (BL_SPACEDIM == 1)
 
   // Hypre doesn't support 1D directly, so we use 2D Hypre with
@@ -190,21 +213,14 @@ HypreABec::HypreABec(const BoxArray& grids,
   HYPRE_StructVectorInitialize(x);
 
   Gpu::synchronize();
-
-  int ncomp=1;
-  int ngrow=0;
-  acoefs.reset(new MultiFab(grids, dmap, ncomp, ngrow));
-  acoefs->setVal(0.0);
- 
-  for (int i = 0; i < BL_SPACEDIM; i++) {
-    BoxArray edge_boxes(grids);
-    edge_boxes.surroundingNodes(i);
-    bcoefs[i].reset(new MultiFab(edge_boxes, dmap, ncomp, ngrow));
-  }
 }
 
 HypreABec::~HypreABec()
 {
+  if (solver_flag == 10) {
+    return;
+  }
+
   HYPRE_StructVectorDestroy(b);
   HYPRE_StructVectorDestroy(x);
 
@@ -258,103 +274,58 @@ void HypreABec::boundaryFlux(MultiFab* Flux, MultiFab& Soln, int icomp,
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-    {
-        Vector<Real> r;
-        Real foo=1.e200;
-        
-        for (MFIter si(Soln); si.isValid(); ++si) {
-            int i = si.index();
-            const Box &reg = grids[i];
-            for (OrientationIter oitr; oitr; oitr++) {
-                int cdir(oitr());
-                int idim = oitr().coordDir();
-                const RadBoundCond &bct = bd.bndryConds(oitr())[i];
-                const Real      &bcl = bd.bndryLocs(oitr())[i];
-                const FArrayBox       &fs  = bd.bndryValues(oitr())[si];
-                const Mask      &msk = bd.bndryMasks(oitr(),i);
-
-                if (reg[oitr()] == domain[oitr()]) {
-                    const int *tfp = NULL;
-                    int bctype = bct;
-                    if (bd.mixedBndry(oitr())) {
-                        const BaseFab<int> &tf = *(bd.bndryTypes(oitr())[i]);
-                        tfp = tf.dataPtr();
-                        bctype = -1;
-                    }
-                    // In normal code operation only the fluxes at internal
-                    // Dirichlet boundaries are used.  Some diagnostics use the
-                    // fluxes computed at domain boundaries but these do not
-                    // influence the evolution of the interior solution.
-                    Real* pSPa;
-                    Box SPabox; 
-                    if (SPa != 0) {
-                        pSPa = (*SPa)[si].dataPtr();
-                        SPabox = (*SPa)[si].box();
-                    }
-                    else {
-                        pSPa = &foo;
-                        SPabox = Box(IntVect::TheZeroVector(),IntVect::TheZeroVector());
-                    }
-                    getFaceMetric(r, reg, oitr(), geom);
-                    hbflx3(BL_TO_FORTRAN(Flux[idim][si]),
-                           BL_TO_FORTRAN_N(Soln[si], icomp),
-                           ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
-                           cdir, bctype, tfp, bho, bcl,
-                           BL_TO_FORTRAN_N(fs, bdcomp),
-                           BL_TO_FORTRAN(msk),
-                           BL_TO_FORTRAN((*bcoefs[idim])[si]),
-                           beta, dx, flux_factor, r.dataPtr(), inhom,
-                           pSPa, ARLIM(SPabox.loVect()), ARLIM(SPabox.hiVect()));
+    for (MFIter si(Soln); si.isValid(); ++si) {
+        int i = si.index();
+        const Box &reg = grids[i];
+        for (OrientationIter oitr; oitr; oitr++) {
+            int idim = oitr().coordDir();
+            const RadBoundCond &bct = bd.bndryConds(oitr())[i];
+            const Real      &bcl = bd.bndryLocs(oitr())[i];
+            const FArrayBox       &fs  = bd.bndryValues(oitr())[si];
+            const Mask      &msk = bd.bndryMasks(oitr(),i);
+
+            if (reg[oitr()] == domain[oitr()]) {
+                Array4<const int> tfp{};
+                int bctype = bct;
+                if (bd.mixedBndry(oitr())) {
+                    const BaseFab<int> &tf = *(bd.bndryTypes(oitr())[i]);
+                    tfp = tf.array();
+                    bctype = -1;
                 }
-                else {
-                    hbflx(BL_TO_FORTRAN(Flux[idim][si]),
-                          BL_TO_FORTRAN_N(Soln[si], icomp),
-                          ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
-                          cdir, bct, bho, bcl,
-                          BL_TO_FORTRAN_N(fs, bdcomp),
-                          BL_TO_FORTRAN(msk),
-                          BL_TO_FORTRAN((*bcoefs[idim])[si]),
-                          beta, dx, inhom);
+                // In normal code operation only the fluxes at internal
+                // Dirichlet boundaries are used.  Some diagnostics use the
+                // fluxes computed at domain boundaries but these do not
+                // influence the evolution of the interior solution.
+                Array4<const Real> spa{};
+                if (SPa != 0) {
+                    spa = (*SPa)[si].array();
                 }
+                hbflx3(reg,
+                       oitr().isLow(), idim,
+                       Flux[idim][si].array(),
+                       Soln[si].array(icomp),
+                       bctype, tfp, bho, bcl,
+                       fs.array(bdcomp),
+                       msk.array(),
+                       (*bcoefs[idim])[si].array(),
+                       beta, flux_factor, spa,
+                       inhom, geom.data());
+            }
+            else {
+                hbflx(reg,
+                      oitr().isLow(), idim,
+                      Flux[idim][si].array(),
+                      Soln[si].array(icomp),
+                      bct, bho, bcl,
+                      fs.array(bdcomp),
+                      msk.array(),
+                      (*bcoefs[idim])[si].array(),
+                      beta, dx, inhom);
             }
         }
     }
 }
 
-void HypreABec::getFaceMetric(Vector<Real>& r,
-                              const Box& reg,
-                              const Orientation& ori,
-                              const Geometry& geom)
-{
-  if (ori.coordDir() == 0) {
-    if (geom.IsCartesian()) {
-      r.resize(1, 1.0);
-    }
-    else { // RZ or Spherical
-      r.resize(1);
-      if (ori.isLow()) {
-        r[0] = geom.LoEdge(reg.smallEnd(0), 0);
-      }
-      else {
-        r[0] = geom.HiEdge(reg.bigEnd(0), 0);
-      }
-      if (geom.IsSPHERICAL()) {
-        r[0] *= r[0];
-      }
-    }
-  }
-  else {
-    if (geom.IsCartesian()) {
-      r.resize(reg.length(0), 1.0);
-    }
-    else { // RZ
-      // We only support spherical coordinates in 1D
-      BL_ASSERT(geom.IsRZ());
-      geom.GetCellLoc(r, reg, 0);
-    }
-  }
-}
-
 void HypreABec::hacoef (const Box& bx,
                         Array4<GpuArray<Real, AMREX_SPACEDIM+1>> const& mat,
                         Array4<Real const> const& a,
@@ -577,9 +548,9 @@ void HypreABec::hbmat (const Box& bx,
     Gpu::synchronize();
 }
 
-void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
+void HypreABec::loadMatrix()
 {
-  BL_PROFILE("HypreABec::setupSolver");
+  BL_PROFILE("HypreABec::loadMatrix");
 
   const BoxArray& grids = acoefs->boxArray();
 
@@ -664,15 +635,115 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
 
     // initialize matrix
 
-    HYPRE_StructMatrixSetBoxValues(A, loV(reg), hiV(reg),
-                                   size, stencil_indices, mat);
+    if (solver_flag == 10) {
+      loadMLMGCoefficients(ai, matfab.array());
+    }
+    else {
+      HYPRE_StructMatrixSetBoxValues(A, loV(reg), hiV(reg),
+                                     size, stencil_indices, mat);
+    }
     Gpu::synchronize();
   }
 
+  if (solver_flag == 10) {
+    BL_ASSERT(mlabec);
+    mlabec->setScalars(1.0, beta);
+    mlabec->setACoeffs(0, *mlacoefs);
+    mlabec->setBCoeffs(0, Array<MultiFab const*, AMREX_SPACEDIM>{AMREX_D_DECL(mlbcoefs[0].get(),
+                                                                              mlbcoefs[1].get(),
+                                                                              mlbcoefs[2].get())});
+    return;
+  }
+
   HYPRE_StructMatrixAssemble(A);
 
   HYPRE_StructVectorAssemble(b); // currently a no-op
   HYPRE_StructVectorAssemble(x); // currently a no-op
+}
+
+void HypreABec::loadMLMGCoefficients(const MFIter& ai,
+                                     Array4<GpuArray<Real, AMREX_SPACEDIM+1>> const& mat)
+{
+  BL_PROFILE("HypreABec::loadMLMGCoefficients");
+
+  const Box& reg = acoefs->boxArray()[ai.index()];
+  const NGBndry& bd = getBndry();
+
+  for (int idim = 0; idim < BL_SPACEDIM; ++idim) {
+    Array4<Real const> const b = (*bcoefs[idim])[ai].array();
+    Array4<Real> const bml = (*mlbcoefs[idim])[ai].array();
+
+    amrex::ParallelFor(amrex::surroundingNodes(reg, idim),
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+    {
+        bml(i,j,k) = b(i,j,k);
+    });
+  }
+
+  // The faces where the boundary conditions apply are those with a
+  // masked cell (outside the domain or on the coarse side of a
+  // coarse-fine boundary) on the other side.  The matrix has no
+  // coupling across them.
+
+  for (OrientationIter oitr; oitr; oitr++) {
+    const Orientation ori = oitr();
+    const int idim = ori.coordDir();
+
+    const Box fbx = ori.isLow() ? amrex::bdryLo(reg, idim) : amrex::bdryHi(reg, idim);
+
+    // offset from the face to the cell outside the grid
+    const int ioff = (ori.isLow() && idim == 0) ? -1 : 0;
+    const int joff = (ori.isLow() && idim == 1) ? -1 : 0;
+    const int koff = (ori.isLow() && idim == 2) ? -1 : 0;
+
+    Array4<int const> const msk = bd.bndryMasks(ori, ai.index()).array();
+    Array4<Real> const bml = (*mlbcoefs[idim])[ai].array();
+
+    amrex::ParallelFor(fbx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+    {
+        if (msk(i+ioff,j+joff,k+koff) > 0) {
+            bml(i,j,k) = 0.e0_rt;
+        }
+    });
+  }
+
+  Array4<Real> const a = (*mlacoefs)[ai].array();
+
+  amrex::ParallelFor(reg,
+  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+  {
+      a(i,j,k) = mat(i,j,k)[AMREX_SPACEDIM];
+  });
+
+  for (int idim = 0; idim < BL_SPACEDIM; ++idim) {
+    const Real fac = beta / (dx[idim] * dx[idim]);
+
+    const int ioff = idim == 0 ? 1 : 0;
+    const int joff = idim == 1 ? 1 : 0;
+    const int koff = idim == 2 ? 1 : 0;
+
+    Array4<Real const> const bml = (*mlbcoefs[idim])[ai].array();
+
+    amrex::ParallelFor(reg,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+    {
+        a(i,j,k) -= fac * (bml(i,j,k) + bml(i+ioff,j+joff,k+koff));
+    });
+  }
+}
+
+void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
+{
+  BL_PROFILE("HypreABec::setupSolver");
+
+  if (solver_flag == 10) {
+    // loadMatrix hands the coefficients to the MLMG operator, so
+    // that has to exist first.
+    setupMLMG(maxiter);
+  }
+
+  loadMatrix();
 
   reltol = _reltol;
   abstol = _abstol; // may be used to change tolerance for solve
@@ -801,7 +872,7 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
 
     HYPRE_StructHybridSetup(solver, A, b, x);
   }
-  else {
+  else if (solver_flag != 10) {
       amrex::Error("HypreABec: no such solver");
   }
   Gpu::synchronize();
@@ -840,6 +911,56 @@ void HypreABec::clearSolver()
        HYPRE_StructSMGDestroy(precond);
     }
   }
+  else if (solver_flag == 10) {
+    mlmg.reset();
+    mlabec.reset();
+  }
+}
+
+void HypreABec::setupMLMG(int maxiter)
+{
+  BL_PROFILE("HypreABec::setupMLMG");
+
+  const BoxArray& grids = acoefs->boxArray();
+  const DistributionMapping& dmap = acoefs->DistributionMap();
+
+  // The metric factors are in the coefficients already.
+
+  LPInfo info;
+  info.setMetricTerm(false);
+
+  mlabec.reset(new MLABecLaplacian({geom}, {grids}, {dmap}, info));
+
+  // The b coefficients are zero on every face where a boundary
+  // condition applies, so the boundary types and values MLMG is given
+  // here never enter the operator.
+
+  std::array<MLLinOp::BCType, AMREX_SPACEDIM> lobc, hibc;
+  for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+    if (geom.isPeriodic(idim)) {
+      lobc[idim] = MLLinOp::BCType::Periodic;
+      hibc[idim] = MLLinOp::BCType::Periodic;
+    }
+    else {
+      lobc[idim] = MLLinOp::BCType::Neumann;
+      hibc[idim] = MLLinOp::BCType::Neumann;
+    }
+  }
+  mlabec->setDomainBC(lobc, hibc);
+
+  MultiFab bcdata(grids, dmap, 1, 1);
+  bcdata.setVal(0.0);
+  mlabec->setLevelBC(0, &bcdata);
+
+  mlmg.reset(new MLMG(*mlabec));
+  mlmg->setMaxIter(maxiter);
+  mlmg->setVerbose(verbose);
+
+  // Left to itself MLMG aborts when it does not converge; we want to
+  // report that as maxiter iterations instead, as the Hypre solvers
+  // do, so that RadSolve can set the solver up again and retry.
+  mlmg->setThrowException(true);
+  mlmg_maxiter = maxiter;
 }
 
 void HypreABec::hbvec3 (const Box& bx,
@@ -1351,13 +1472,375 @@ void HypreABec::hbvec (const Box& bx,
     Gpu::synchronize();
 }
 
+void HypreABec::hbflx (const Box& bx,
+                       int ori_lo, int idir,
+                       Array4<Real> const& flux,
+                       Array4<Real const> const& er,
+                       int bct, int bho, Real bcl,
+                       Array4<Real const> const& bcval,
+                       Array4<int const> const& mask,
+                       Array4<Real const> const& b,
+                       Real beta, const Real* dx, int inhom)
+{
+    const Real h = dx[idir];
+
+    Real bfv = 0.0_rt;
+    Real bfm = 0.0_rt;
+    Real bfm2 = 0.0_rt;
+
+    if (bct == LO_DIRICHLET) {
+        if (bho >= 1) {
+            Real h2 = 0.5e0_rt * h;
+            Real th2 = 3.e0_rt * h2;
+            bfv = 2.e0_rt * beta * h / ((bcl + h2) * (bcl + th2));
+            bfm = (beta / h) * (th2 - bcl) / (bcl + h2);
+            bfm2 = (beta / h) * (bcl - h2) / (bcl + th2);
+        }
+        else {
+            bfv = beta / (0.5e0_rt * h + bcl);
+            bfm = bfv;
+        }
+    }
+    else {
+        amrex::Error("hbflx: unsupported boundary type");
+    }
+
+    if (inhom == 0) {
+        bfv = 0.e0_rt;
+    }
+
+    // The zones of bx next to the face, the offset from them to the
+    // boundary zones, and the sign of the flux into the grid.
+
+    Box fbx(bx);
+    int s;
+
+    if (ori_lo) {
+        fbx.setBig(idir, bx.smallEnd(idir));
+        s = -1;
+    }
+    else {
+        fbx.setSmall(idir, bx.bigEnd(idir));
+        s = 1;
+    }
+
+    const int di = (idir == 0) ? s : 0;
+    const int dj = (idir == 1) ? s : 0;
+    const int dk = (idir == 2) ? s : 0;
+
+    amrex::ParallelFor(fbx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+    {
+        if (mask(i+di,j+dj,k+dk) > 0) {
+
+            // the face between this zone and the boundary zone
+
+            const int fi = ori_lo ? i : i + di;
+            const int fj = ori_lo ? j : j + dj;
+            const int fk = ori_lo ? k : k + dk;
+
+            Real f = b(fi,fj,fk) * (bfv * bcval(i+di,j+dj,k+dk) - bfm * er(i,j,k));
+
+            if (bho >= 1) {
+                f = f - b(fi,fj,fk) * bfm2 * er(i-di,j-dj,k-dk);
+            }
+
+            flux(fi,fj,fk) = -s * f;
+
+        }
+    });
+
+    Gpu::synchronize();
+}
+
+void HypreABec::hbflx3 (const Box& bx,
+                        int ori_lo, int idir,
+                        Array4<Real> const& flux,
+                        Array4<Real const> const& er,
+                        int bctype,
+                        Array4<int const> const& tf,
+                        int bho, Real bcl,
+                        Array4<Real const> const& bcval,
+                        Array4<int const> const& mask,
+                        Array4<Real const> const& b,
+                        Real beta, Real c,
+                        Array4<Real const> const& spa,
+                        int inhom, const GeometryData& geomdata)
+{
+    const Real h = geomdata.CellSize()[idir];
+
+    Box fbx(bx);
+    int s;
+
+    if (ori_lo) {
+        fbx.setBig(idir, bx.smallEnd(idir));
+        s = -1;
+    }
+    else {
+        fbx.setSmall(idir, bx.bigEnd(idir));
+        s = 1;
+    }
+
+    const int di = (idir == 0) ? s : 0;
+    const int dj = (idir == 1) ? s : 0;
+    const int dk = (idir == 2) ? s : 0;
+
+    amrex::ParallelFor(fbx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+    {
+        if (mask(i+di,j+dj,k+dk) > 0) {
+
+            Real r;
+            face_metric(i, j, k, bx.loVect()[0], bx.hiVect()[0], geomdata, idir, ori_lo, r);
+
+            const int fi = ori_lo ? i : i + di;
+            const int fj = ori_lo ? j : j + dj;
+            const int fk = ori_lo ? k : k + dk;
+
+            int bct;
+            if (bctype == -1) {
+                bct = tf(i+di,j+dj,k+dk);
+            }
+            else {
+                bct = bctype;
+            }
+
+            Real bfv = 0.0_rt;
+            Real bfm = 0.0_rt;
+            Real bfm2 = 0.0_rt;
+
+            if (bct == LO_DIRICHLET) {
+                if (bho >= 1) {
+                    Real h2 = 0.5e0_rt * h;
+                    Real th2 = 3.e0_rt * h2;
+                    bfv = 2.e0_rt * beta * h / ((bcl + h2) * (bcl + th2)) * b(fi,fj,fk);
+                    bfm = (beta / h) * (th2 - bcl) / (bcl + h2) * b(fi,fj,fk);
+                    bfm2 = (beta / h) * (bcl - h2) / (bcl + th2) * b(fi,fj,fk);
+                }
+                else {
+                    bfv = beta / (0.5e0_rt * h + bcl) * b(fi,fj,fk);
+                    bfm = bfv;
+                }
+            }
+            else if (bct == LO_NEUMANN) {
+                bfv = beta * r;
+            }
+            else if (bct == LO_MARSHAK) {
+                bfv = 2.e0_rt * beta * r;
+                if (bho >= 1) {
+                    bfm  =  0.375e0_rt * c * bfv;
+                    bfm2 = -0.125e0_rt * c * bfv;
+                }
+                else {
+                    bfm = 0.25e0_rt * c * bfv;
+                }
+            }
+            else if (bct == LO_SANCHEZ_POMRANING) {
+                bfv = 2.e0_rt * beta * r;
+                if (bho >= 1) {
+                    bfm  =  1.5e0_rt * spa(i,j,k) * c * bfv;
+                    bfm2 = -0.5e0_rt * spa(i,j,k) * c * bfv;
+                }
+                else {
+                    bfm = spa(i,j,k) * c * bfv;
+                }
+            }
+#ifndef AMREX_USE_GPU
+            else {
+                amrex::Error("hbflx3: unsupported boundary type");
+            }
+#endif
+
+            if (inhom == 0) {
+                bfv = 0.e0_rt;
+            }
+
+            Real f = bfv * bcval(i+di,j+dj,k+dk) - bfm * er(i,j,k);
+
+            if (bho >= 1) {
+                f = f - bfm2 * er(i-di,j-dj,k-dk);
+            }
+
+            flux(fi,fj,fk) = -s * f;
+
+        }
+    });
+
+    Gpu::synchronize();
+}
+
+void HypreABec::hdterm (const Box& bx,
+                        int ori_lo, int idir,
+                        Array4<Real> const& dterm,
+                        Array4<Real const> const& er,
+                        int bct, Real bcl,
+                        Array4<Real const> const& bcval,
+                        Array4<int const> const& mask,
+                        Array4<Real const> const& d,
+                        const Real* dx)
+{
+    const Real h = dx[idir];
+
+    if (bct != LO_DIRICHLET) {
+        amrex::Error("hdterm: unsupported boundary type");
+    }
+
+    Box fbx(bx);
+    int s;
+
+    if (ori_lo) {
+        fbx.setBig(idir, bx.smallEnd(idir));
+        s = -1;
+    }
+    else {
+        fbx.setSmall(idir, bx.bigEnd(idir));
+        s = 1;
+    }
+
+    const int di = (idir == 0) ? s : 0;
+    const int dj = (idir == 1) ? s : 0;
+    const int dk = (idir == 2) ? s : 0;
+
+    amrex::ParallelFor(fbx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+    {
+        if (mask(i+di,j+dj,k+dk) > 0) {
+
+            const int fi = ori_lo ? i : i + di;
+            const int fj = ori_lo ? j : j + dj;
+            const int fk = ori_lo ? k : k + dk;
+
+            dterm(fi,fj,fk) = -s * d(fi,fj,fk) *
+                (er(i,j,k) - bcval(i+di,j+dj,k+dk)) / (0.5e0_rt * h + bcl);
+
+        }
+    });
+
+    Gpu::synchronize();
+}
+
+void HypreABec::hdterm3 (const Box& bx,
+                         int ori_lo, int idir,
+                         Array4<Real> const& dterm,
+                         Array4<Real const> const& er,
+                         int bctype,
+                         Array4<int const> const& tf,
+                         Real bcl,
+                         Array4<Real const> const& bcval,
+                         Array4<int const> const& mask,
+                         Array4<Real const> const& d,
+                         const Real* dx)
+{
+    const Real h = dx[idir];
+
+    Box fbx(bx);
+    int s;
+
+    if (ori_lo) {
+        fbx.setBig(idir, bx.smallEnd(idir));
+        s = -1;
+    }
+    else {
+        fbx.setSmall(idir, bx.bigEnd(idir));
+        s = 1;
+    }
+
+    const int di = (idir == 0) ? s : 0;
+    const int dj = (idir == 1) ? s : 0;
+    const int dk = (idir == 2) ? s : 0;
+
+    amrex::ParallelFor(fbx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+    {
+        if (mask(i+di,j+dj,k+dk) > 0) {
+
+            const int fi = ori_lo ? i : i + di;
+            const int fj = ori_lo ? j : j + dj;
+            const int fk = ori_lo ? k : k + dk;
+
+            int bct;
+            if (bctype == -1) {
+                bct = tf(i+di,j+dj,k+dk);
+            }
+            else {
+                bct = bctype;
+            }
+
+            if (bct == LO_DIRICHLET) {
+                dterm(fi,fj,fk) = -s * d(fi,fj,fk) *
+                    (er(i,j,k) - bcval(i+di,j+dj,k+dk)) / (0.5e0_rt * h + bcl);
+            }
+            else if (bct == LO_NEUMANN && bcval(i+di,j+dj,k+dk) == 0.e0_rt) {
+                dterm(fi,fj,fk) = 0.e0_rt;
+            }
+#ifndef AMREX_USE_GPU
+            else {
+                amrex::Error("hdterm3: unsupported boundary type");
+            }
+#endif
+
+        }
+    });
+
+    Gpu::synchronize();
+}
+
+void HypreABec::addBoundaryRhs(const MFIter& di, Array4<Real> const& vec)
+{
+  const int i = di.index();
+  const Box& reg = acoefs->boxArray()[i];
+
+  const NGBndry& bd = getBndry();
+  const Box& domain = bd.getDomain();
+  for (OrientationIter oitr; oitr; oitr++) {
+    int cdir(oitr());
+    int idim = oitr().coordDir();
+    const RadBoundCond &bct = bd.bndryConds(oitr())[i];
+    const Real      &bcl = bd.bndryLocs(oitr())[i];
+    const FArrayBox       &fs  = bd.bndryValues(oitr())[di];
+    const Mask      &msk = bd.bndryMasks(oitr(),i);
+
+    if (reg[oitr()] == domain[oitr()]) {
+      Array4<const int> tfp{};
+      int bctype = bct;
+      if (bd.mixedBndry(oitr())) {
+        const BaseFab<int> &tf = *(bd.bndryTypes(oitr())[i]);
+        tfp = tf.array();
+        bctype = -1;
+      }
+      hbvec3(reg,
+             oitr().isLow(), idim,
+             vec,
+             cdir, bct,
+             tfp,
+             bho, bcl,
+             fs.array(bdcomp),
+             msk.array(),
+             (*bcoefs[idim])[di].array(),
+             beta, geom.data());
+    }
+    else {
+        hbvec(reg, vec,
+              cdir, bct, bho, bcl,
+              fs.array(bdcomp), msk.array(),
+              (*bcoefs[idim])[di].array(),
+              beta, dx);
+    }
+  }
+}
+
 void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
 {
   BL_PROFILE("HypreABec::solve");
 
+  if (solver_flag == 10) {
+    solveMLMG(dest, icomp, rhs, inhom);
+    return;
+  }
+
   const BoxArray& grids = dest.boxArray();
 
-  int i, idim;
+  int i;
 
   Real *vec;
   FArrayBox fnew;
@@ -1402,44 +1885,7 @@ void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
     // add b.c.'s to rhs
 
     if (inhom) {
-      const NGBndry& bd = getBndry();
-      const Box& domain = bd.getDomain();
-      for (OrientationIter oitr; oitr; oitr++) {
-        int cdir(oitr());
-        idim = oitr().coordDir();
-        const RadBoundCond &bct = bd.bndryConds(oitr())[i];
-        const Real      &bcl = bd.bndryLocs(oitr())[i];
-        const FArrayBox       &fs  = bd.bndryValues(oitr())[di];
-        const Mask      &msk = bd.bndryMasks(oitr(),i);
-        const Box &bbox = (*bcoefs[idim])[di].box();
-
-        if (reg[oitr()] == domain[oitr()]) {
-          Array4<const int> tfp{};
-          int bctype = bct;
-          if (bd.mixedBndry(oitr())) {
-            const BaseFab<int> &tf = *(bd.bndryTypes(oitr())[i]);
-            tfp = tf.array();
-            bctype = -1;
-          }
-          hbvec3(reg,
-                 oitr().isLow(), idim,
-                 f->array(fcomp),
-                 cdir, bct,
-                 tfp,
-                 bho, bcl,
-                 fs.array(bdcomp),
-                 msk.array(),
-                 (*bcoefs[idim])[di].array(),
-                 beta, geom.data());
-        }
-        else {
-            hbvec(reg, f->array(fcomp),
-                  cdir, bct, bho, bcl,
-                  fs.array(bdcomp), msk.array(),
-                  (*bcoefs[idim])[di].array(),
-                  beta, dx);
-        }
-      }
+      addBoundaryRhs(di, f->array(fcomp));
     }
 
     Gpu::streamSynchronize();
@@ -1569,10 +2015,84 @@ void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
   Gpu::synchronize();
 }
 
+void HypreABec::solveMLMG(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
+{
+  BL_PROFILE("HypreABec::solveMLMG");
+
+  const BoxArray& grids = acoefs->boxArray();
+  const DistributionMapping& dmap = acoefs->DistributionMap();
+
+  MultiFab soln(grids, dmap, 1, 1);
+  soln.setVal(0.0);
+  MultiFab::Copy(soln, dest, icomp, 0, 1, 0);
+
+  MultiFab mlrhs(grids, dmap, 1, 0);
+  MultiFab::Copy(mlrhs, rhs, 0, 0, 1, 0);
+
+  if (inhom) {
+    for (MFIter di(mlrhs); di.isValid(); ++di) {
+      addBoundaryRhs(di, mlrhs[di].array());
+    }
+  }
+
+  try {
+    mlmg->solve({&soln}, {&mlrhs}, reltol, abstol);
+    mlmg_iters = mlmg->getNumIters();
+    mlmg_residual = mlmg->getFinalResidual();
+  }
+  catch (const std::runtime_error& err) {
+    // Keep the last iterate, as the Hypre solvers do, and measure
+    // its residual ourselves since MLMG did not get to.
+    mlmg_iters = mlmg_maxiter;
+
+    MultiFab res(grids, dmap, 1, 0);
+    mlmg->compResidual({&res}, {&soln}, {&mlrhs});
+    mlmg_residual = res.norminf();
+
+    if (verbose >= 1 && ParallelDescriptor::IOProcessor()) {
+      std::cout << "HypreABec: MLMG did not converge: " << err.what() << std::endl;
+    }
+  }
+
+  MultiFab::Copy(dest, soln, 0, icomp, 1, 0);
+}
+
+int HypreABec::getNumIterations()
+{
+  int num_iterations = 0;
+
+  if (solver_flag == 10) {
+    return mlmg_iters;
+  }
+
+  if (solver_flag == 0) {
+    HYPRE_StructSMGGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 1) {
+    HYPRE_StructPFMGGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 2) {
+    HYPRE_StructJacobiGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 3 || solver_flag == 4) {
+    HYPRE_StructPCGGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 5 || solver_flag == 6) {
+    HYPRE_StructHybridGetNumIterations(solver, &num_iterations);
+  }
+
+  return num_iterations;
+}
+
 Real HypreABec::getAbsoluteResidual()
 {
   BL_PROFILE("HypreABec::getAbsoluteResidual");
 
+  if (solver_flag == 10) {
+    // MLMG measures the residual in the max norm
+    return mlmg_residual;
+  }
+
   Real bnorm;
   bnorm = hypre_StructInnerProd((hypre_StructVector *) b,
                                 (hypre_StructVector *) b);
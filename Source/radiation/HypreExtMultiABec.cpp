@@ -1,6 +1,5 @@
 
 #include <HypreExtMultiABec.H>
-#include <HABEC_F.H>
 #include <AMReX_LO_BCTYPES.H>
 
 #include <_hypre_sstruct_mv.h>
@@ -1032,7 +1031,6 @@ void HypreExtMultiABec::boundaryDterm(int level,
     int i = mfi.index();
     const Box &reg = grids[level][i];
     for (OrientationIter oitr; oitr; oitr++) {
-      int cdir(oitr());
       int idim = oitr().coordDir();
       const RadBoundCond &bct = bd[level]->bndryConds(oitr())[i];
       const Real      &bcl = bd[level]->bndryLocs(oitr())[i];
@@ -1040,31 +1038,33 @@ void HypreExtMultiABec::boundaryDterm(int level,
       const Mask      &msk = bd[level]->bndryMasks(oitr(), i);
 
       if (reg[oitr()] == domain[oitr()]) {
-        const int *tfp = NULL;
+        Array4<const int> tfp{};
         int bctype = bct;
         if (bd[level]->mixedBndry(oitr())) {
           const BaseFab<int> &tf = *(bd[level]->bndryTypes(oitr())[i]);
-          tfp = tf.dataPtr();
+          tfp = tf.array();
           bctype = -1;
         }
-        hdterm3(BL_TO_FORTRAN(Dterm[idim][mfi]),
-                BL_TO_FORTRAN_N(Soln[mfi], icomp),
-                ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
-                cdir, bctype, tfp, bcl,
-                BL_TO_FORTRAN_N(bcv, bdcomp),
-                BL_TO_FORTRAN(msk),
-                BL_TO_FORTRAN((*d2coefs[level])[idim][mfi]),
-                geom[level].CellSize());
+        HypreABec::hdterm3(reg,
+                           oitr().isLow(), idim,
+                           Dterm[idim][mfi].array(),
+                           Soln[mfi].array(icomp),
+                           bctype, tfp, bcl,
+                           bcv.array(bdcomp),
+                           msk.array(),
+                           (*d2coefs[level])[idim][mfi].array(),
+                           geom[level].CellSize());
       }
       else {
-        hdterm(BL_TO_FORTRAN(Dterm[idim][mfi]),
-               BL_TO_FORTRAN_N(Soln[mfi], icomp), 
-               ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
-               cdir, bct, bcl,
-               BL_TO_FORTRAN_N(bcv, bdcomp),
-               BL_TO_FORTRAN(msk),
-               BL_TO_FORTRAN((*d2coefs[level])[idim][mfi]),
-               geom[level].CellSize());
+        HypreABec::hdterm(reg,
+                          oitr().isLow(), idim,
+                          Dterm[idim][mfi].array(),
+                          Soln[mfi].array(icomp),
+                          bct, bcl,
+                          bcv.array(bdcomp),
+                          msk.array(),
+                          (*d2coefs[level])[idim][mfi].array(),
+                          geom[level].CellSize());
       }
     }
   }
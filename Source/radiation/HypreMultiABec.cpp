@@ -2973,6 +2973,58 @@ void HypreMultiABec::solve()
   }
 }
 
+int HypreMultiABec::getNumIterations()
+{
+  int num_iterations = 0;
+
+  if (solver_flag == 100 || solver_flag == 150) {
+    HYPRE_BoomerAMGGetNumIterations(solver, &num_iterations);
+  }
+  else if (solver_flag == 101) {
+    HYPRE_SStructFACGetNumIterations(sstruct_solver, &num_iterations);
+  }
+  else if (solver_flag == 102 || solver_flag == 104 || solver_flag == 105) {
+    HYPRE_ParCSRGMRESGetNumIterations(solver, &num_iterations);
+  }
+  else if (solver_flag == 103 || solver_flag == 107) {
+    HYPRE_SStructGMRESGetNumIterations(sstruct_solver, &num_iterations);
+  }
+  else if (solver_flag == 1002) {
+    HYPRE_ParCSRPCGGetNumIterations(solver, &num_iterations);
+  }
+  else if (solver_flag == 1003) {
+    HYPRE_SStructPCGGetNumIterations(sstruct_solver, &num_iterations);
+  }
+  else if (solver_flag == 106) {
+    HYPRE_SStructSplitGetNumIterations(sstruct_solver, &num_iterations);
+  }
+  else if (solver_flag == 108) {
+    ParmParse pp("hmabec");
+#if (BL_SPACEDIM == 1)
+    int struct_flag = 0;
+#else
+    int struct_flag = 1;
+#endif
+    pp.query("struct_flag", struct_flag);
+    HYPRE_StructSolver& struct_solver = *(HYPRE_StructSolver*)&solver;
+    if (struct_flag == 0) {
+      HYPRE_StructSMGGetNumIterations(struct_solver, &num_iterations);
+    }
+    else {
+      HYPRE_StructPFMGGetNumIterations(struct_solver, &num_iterations);
+    }
+  }
+  else if (solver_flag == 109) {
+    HYPRE_StructSolver& struct_solver = *(HYPRE_StructSolver*)&solver;
+    HYPRE_StructGMRESGetNumIterations(struct_solver, &num_iterations);
+  }
+  else if (solver_flag == 151 || solver_flag == 152 || solver_flag == 153) {
+    HYPRE_PCGGetNumIterations(solver, &num_iterations);
+  }
+
+  return num_iterations;
+}
+
 void HypreMultiABec::getSolution(int level, MultiFab& dest, int icomp)
 {
   int part = level - crse_level;
@@ -3087,68 +3139,52 @@ void HypreMultiABec::boundaryFlux(int level,
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-    {
-        Vector<Real> r;
-        Real foo=1.e200;
-
-        for (MFIter mfi(Soln); mfi.isValid(); ++mfi) {
-            int i = mfi.index();
-            const Box &reg = grids[level][i];
-            for (OrientationIter oitr; oitr; oitr++) {
-                int cdir(oitr());
-                int idim = oitr().coordDir();
-                const RadBoundCond &bct = bd[level]->bndryConds(oitr())[i];
-                const Real      &bcl = bd[level]->bndryLocs(oitr())[i];
-                const FArrayBox       &fs  = bd[level]->bndryValues(oitr())[mfi];
-                const Mask      &msk = bd[level]->bndryMasks(oitr(), i);
-                const Box &fbox = Flux[idim][mfi].box();
-                const Box &sbox = Soln[mfi].box();
-                const Box &msb  = msk.box();
-                const Box &bbox = (*bcoefs[level])[idim][mfi].box();
-                if (reg[oitr()] == domain[oitr()]) {
-                    const int *tfp = NULL;
-                    int bctype = bct;
-                    if (bd[level]->mixedBndry(oitr())) {
-                        const BaseFab<int> &tf = *(bd[level]->bndryTypes(oitr())[i]);
-                        tfp = tf.dataPtr();
-                        bctype = -1;
-                    }
-                    // In normal code operation only the fluxes at internal
-                    // Dirichlet boundaries are used.  Some diagnostics use the
-                    // fluxes computed at domain boundaries but these do not
-                    // influence the evolution of the interior solution.
-                    Real* pSPa;
-                    Box SPabox;
-                    if (SPa[level]) {
-                        pSPa = (*SPa[level])[mfi].dataPtr();
-                        SPabox = (*SPa[level])[mfi].box();
-                    }
-                    else {
-                        pSPa = &foo;
-                        SPabox = Box(IntVect::TheZeroVector(),IntVect::TheZeroVector());
-                    }
-                    getFaceMetric(r, reg, oitr(), geom[level]);
-                    hbflx3(BL_TO_FORTRAN(Flux[idim][mfi]),
-                           BL_TO_FORTRAN_N(Soln[mfi], icomp),
-                           ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
-                           cdir, bctype, tfp, bho, bcl,
-                           BL_TO_FORTRAN_N(fs, bdcomp),
-                           BL_TO_FORTRAN(msk),
-                           BL_TO_FORTRAN((*bcoefs[level])[idim][mfi]),
-                           beta, geom[level].CellSize(),
-                           flux_factor, r.dataPtr(), inhom,
-                           pSPa, ARLIM(SPabox.loVect()), ARLIM(SPabox.hiVect()));
+    for (MFIter mfi(Soln); mfi.isValid(); ++mfi) {
+        int i = mfi.index();
+        const Box &reg = grids[level][i];
+        for (OrientationIter oitr; oitr; oitr++) {
+            int idim = oitr().coordDir();
+            const RadBoundCond &bct = bd[level]->bndryConds(oitr())[i];
+            const Real      &bcl = bd[level]->bndryLocs(oitr())[i];
+            const FArrayBox       &fs  = bd[level]->bndryValues(oitr())[mfi];
+            const Mask      &msk = bd[level]->bndryMasks(oitr(), i);
+            if (reg[oitr()] == domain[oitr()]) {
+                Array4<const int> tfp{};
+                int bctype = bct;
+                if (bd[level]->mixedBndry(oitr())) {
+                    const BaseFab<int> &tf = *(bd[level]->bndryTypes(oitr())[i]);
+                    tfp = tf.array();
+                    bctype = -1;
                 }
-                else {
-                    hbflx(BL_TO_FORTRAN(Flux[idim][mfi]),
-                          BL_TO_FORTRAN_N(Soln[mfi], icomp),
-                          ARLIM(reg.loVect()), ARLIM(reg.hiVect()),
-                          cdir, bct, bho, bcl,
-                          BL_TO_FORTRAN_N(fs, bdcomp),
-                          BL_TO_FORTRAN(msk),
-                          BL_TO_FORTRAN((*bcoefs[level])[idim][mfi]),
-                          beta, geom[level].CellSize(), inhom);
+                // In normal code operation only the fluxes at internal
+                // Dirichlet boundaries are used.  Some diagnostics use the
+                // fluxes computed at domain boundaries but these do not
+                // influence the evolution of the interior solution.
+                Array4<const Real> spa{};
+                if (SPa[level]) {
+                    spa = (*SPa[level])[mfi].array();
                 }
+                HypreABec::hbflx3(reg,
+                                  oitr().isLow(), idim,
+                                  Flux[idim][mfi].array(),
+                                  Soln[mfi].array(icomp),
+                                  bctype, tfp, bho, bcl,
+                                  fs.array(bdcomp),
+                                  msk.array(),
+                                  (*bcoefs[level])[idim][mfi].array(),
+                                  beta, flux_factor, spa,
+                                  inhom, geom[level].data());
+            }
+            else {
+                HypreABec::hbflx(reg,
+                                 oitr().isLow(), idim,
+                                 Flux[idim][mfi].array(),
+                                 Soln[mfi].array(icomp),
+                                 bct, bho, bcl,
+                                 fs.array(bdcomp),
+                                 msk.array(),
+                                 (*bcoefs[level])[idim][mfi].array(),
+                                 beta, geom[level].CellSize(), inhom);
             }
         }
     }
@@ -5,6 +5,7 @@
 #include <blackbody.H>
 #include <opacity.H>
 #include <problem_emissivity.H>
+#include <filter.H>
 
 #include <iostream>
 
@@ -328,6 +329,9 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
           xnu_loc[g] = xnu[g];
       }
 
+      const auto opac = opacity_table.view();
+      const auto planck = planck_table.view();
+
       amrex::ParallelFor(bx,
       [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
       {
@@ -365,7 +369,7 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
 
               Real kp, kr;
 
-              opacity(kp, kr, rho, temp, Ye, nu, comp_kp, comp_kr);
+              tabulated_opacity(opac, g, kp, kr, rho, temp, Ye, nu, comp_kp, comp_kr);
 
               kappa_p_arr(i,j,k,g) = kp;
               kappa_r_arr(i,j,k,g) = kr;
@@ -381,8 +385,8 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
 
                   Real kp1, kr1, kp2, kr2;
 
-                  opacity(kp1, kr1, rho, temp-dT, Ye, nu, comp_kp, comp_kr);
-                  opacity(kp2, kr2, rho, temp+dT, Ye, nu, comp_kp, comp_kr);
+                  tabulated_opacity(opac, g, kp1, kr1, rho, temp-dT, Ye, nu, comp_kp, comp_kr);
+                  tabulated_opacity(opac, g, kp2, kr2, rho, temp+dT, Ye, nu, comp_kp, comp_kr);
 
                   dkdT_arr(i,j,k,g) = (kp2 - kp1) / (2.e0_rt * dT);
               }
@@ -397,27 +401,41 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
           // Integrate the Planck distribution upward from zero frequency.
           // This handles both the single-group and multi-group cases.
 
+          // With a Planck table, interpolate instead wherever it covers T.
+
           Real Teff = amrex::max(temp_new_arr(i,j,k), 1.e-50_rt);
 
-          Real B1, dBdT1;
-          BdBdTIndefInteg(Teff, 0.0_rt, B1, dBdT1);
+          const bool tabulated = planck.contains(Teff);
 
-          for (int g = 0; g < NGROUPS; ++g) {
+          Real B1 = 0.0_rt;
+          Real dBdT1 = 0.0_rt;
+          if (!tabulated) {
+              BdBdTIndefInteg(Teff, 0.0_rt, B1, dBdT1);
+          }
 
-              Real xnup = xnu_loc[g+1];
+          for (int g = 0; g < NGROUPS; ++g) {
 
-              // For the last group, make sure that we complete
-              // the integral up to "infinity".
+              Real Bg, dBdT;
 
-              if (g == NGROUPS - 1) {
-                  xnup = amrex::max(xnup, 1.e25_rt);
+              if (tabulated) {
+                  planck(Teff, g, Bg, dBdT);
               }
+              else {
+                  Real xnup = xnu_loc[g+1];
+
+                  // For the last group, make sure that we complete
+                  // the integral up to "infinity".
 
-              Real B0 = B1;
-              Real dBdT0 = dBdT1;
-              BdBdTIndefInteg(Teff, xnup, B1, dBdT1);
-              Real Bg = B1 - B0;
-              Real dBdT = dBdT1 - dBdT0;
+                  if (g == NGROUPS - 1) {
+                      xnup = amrex::max(xnup, 1.e25_rt);
+                  }
+
+                  Real B0 = B1;
+                  Real dBdT0 = dBdT1;
+                  BdBdTIndefInteg(Teff, xnup, B1, dBdT1);
+                  Bg = B1 - B0;
+                  dBdT = dBdT1 - dBdT0;
+              }
 
               jg_arr(i,j,k,g) = Bg * kappa_p_arr(i,j,k,g);
               djdT_arr(i,j,k,g) = dkdT_arr(i,j,k,g) * Bg + dBdT * kappa_p_arr(i,j,k,g);
@@ -782,22 +800,44 @@ void Radiation::state_energy_update(MultiFab& state, const MultiFab& rhoe,
       }
   }
 
+  ReduceOps<ReduceOpMax, ReduceOpMax> reduce_op;
+  ReduceData<Real, Real> reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-  for (MFIter mfi(state,true); mfi.isValid(); ++mfi) 
+  for (MFIter mfi(state, TilingIfNotGPU()); mfi.isValid(); ++mfi) 
   {
-      const Box& reg  = mfi.tilebox();
+      const Box& bx = mfi.tilebox();
 
-      BL_FORT_PROC_CALL(CA_STATE_UPDATE, ca_state_update)
-          (reg.loVect(), reg.hiVect(),
-           BL_TO_FORTRAN(state[mfi]),
-           BL_TO_FORTRAN(rhoe[mfi]),
-           BL_TO_FORTRAN(temp[mfi]),
-           BL_TO_FORTRAN(msk[mfi]),
-           &derat, &dT);
+      auto S = state[mfi].array();
+      const auto rhoe_arr = rhoe[mfi].array();
+      const auto temp_arr = temp[mfi].array();
+      const auto msk_arr = msk[mfi].array();
+
+      reduce_op.eval(bx, reduce_data,
+      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
+      {
+          Real ei = S(i,j,k,UEINT);
+          Real derat_loc = std::abs((rhoe_arr(i,j,k) - ei) * msk_arr(i,j,k) / amrex::max(ei, 1.e-50_rt));
+          Real ek = S(i,j,k,UEDEN) - S(i,j,k,UEINT);
+          S(i,j,k,UEINT) = rhoe_arr(i,j,k);
+          S(i,j,k,UEDEN) = rhoe_arr(i,j,k) + ek;
+
+          Real Told = S(i,j,k,UTEMP);
+          Real dT_loc = std::abs((temp_arr(i,j,k) - Told) * msk_arr(i,j,k) / amrex::max(Told, 1.e-50_rt));
+          S(i,j,k,UTEMP) = temp_arr(i,j,k);
+
+          return {derat_loc, dT_loc};
+      });
   }
 
+  ReduceTuple hv = reduce_data.value();
+
+  derat = amrex::max(derat, amrex::get<0>(hv));
+  dT = amrex::max(dT, amrex::get<1>(hv));
+
   ParallelDescriptor::ReduceRealMax(derat);
   ParallelDescriptor::ReduceRealMax(dT);
 }
@@ -975,17 +1015,99 @@ void Radiation::compute_limiter(int level, const BoxArray& grids,
     
     Er_wide.FillBoundary(parent->Geom(level).periodicity());
     
-    const Real* dx = parent->Geom(level).CellSize();
+    auto dx = parent->Geom(level).CellSizeArray();
+
+    const int ngroups = nGroups;
+    const int lim = limiter;
+
+    // Er is -1 where it is not known (outside the domain and the
+    // neighboring grids).  Compute lambda everywhere else, with one-sided
+    // differences next to the unknown cells.
 
 #ifdef _OPENMP
 #pragma omp parallel
 #endif    
-    for (MFIter mfi(Er_wide,false); mfi.isValid(); ++mfi) {
-      BL_FORT_PROC_CALL(CA_COMPUTE_LAMBORDER, ca_compute_lamborder)
-        (BL_TO_FORTRAN(Er_wide[mfi]), 
-         BL_TO_FORTRAN(kpr[mfi]),
-         BL_TO_FORTRAN(lamborder[mfi]), 
-         dx, &ngrow, &limiter, &filter_lambda_T, &filter_lambda_S);
+    for (MFIter mfi(lamborder, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.growntilebox();
+
+        const auto Er = Er_wide[mfi].array();
+        const auto kap = kpr[mfi].array();
+        auto lam = lamborder[mfi].array();
+
+        amrex::ParallelFor(bx, ngroups,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int g) noexcept
+        {
+            if (Er(i,j,k,g) == -1.e0_rt) {
+                lam(i,j,k,g) = -1.e50_rt;
+                return;
+            }
+
+            Real r1;
+            if (Er(i-1,j,k,g) == -1.e0_rt) {
+                r1 = (Er(i+1,j,k,g) - Er(i,j,k,g)) / dx[0];
+            } else if (Er(i+1,j,k,g) == -1.e0_rt) {
+                r1 = (Er(i,j,k,g) - Er(i-1,j,k,g)) / dx[0];
+            } else {
+                r1 = (Er(i+1,j,k,g) - Er(i-1,j,k,g)) / (2.e0_rt * dx[0]);
+            }
+
+            Real r2 = 0.e0_rt;
+#if AMREX_SPACEDIM >= 2
+            if (Er(i,j-1,k,g) == -1.e0_rt) {
+                r2 = (Er(i,j+1,k,g) - Er(i,j,k,g)) / dx[1];
+            } else if (Er(i,j+1,k,g) == -1.e0_rt) {
+                r2 = (Er(i,j,k,g) - Er(i,j-1,k,g)) / dx[1];
+            } else {
+                r2 = (Er(i,j+1,k,g) - Er(i,j-1,k,g)) / (2.e0_rt * dx[1]);
+            }
+#endif
+
+            Real r3 = 0.e0_rt;
+#if AMREX_SPACEDIM == 3
+            if (Er(i,j,k-1,g) == -1.e0_rt) {
+                r3 = (Er(i,j,k+1,g) - Er(i,j,k,g)) / dx[2];
+            } else if (Er(i,j,k+1,g) == -1.e0_rt) {
+                r3 = (Er(i,j,k,g) - Er(i,j,k-1,g)) / dx[2];
+            } else {
+                r3 = (Er(i,j,k+1,g) - Er(i,j,k-1,g)) / (2.e0_rt * dx[2]);
+            }
+#endif
+
+            Real r = std::sqrt(r1 * r1 + r2 * r2 + r3 * r3);
+            r = r / (kap(i,j,k,g) * amrex::max(Er(i,j,k,g), 1.e-50_rt));
+
+            lam(i,j,k,g) = FLDlambda(r, lim);
+        });
+    }
+
+    if (filter_lambda_T) {
+        filter_lambda(Er_wide, lamborder);
+    }
+
+    // Where Er is unknown, use lambda from the nearest valid cell.
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(lamborder, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.growntilebox();
+
+        const auto vlo = amrex::lbound(mfi.validbox());
+        const auto vhi = amrex::ubound(mfi.validbox());
+
+        const auto Er = Er_wide[mfi].array();
+        auto lam = lamborder[mfi].array();
+
+        amrex::ParallelFor(bx, ngroups,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int g) noexcept
+        {
+            if (Er(i,j,k,g) == -1.e0_rt) {
+                const int ii = amrex::min(amrex::max(i, vlo.x), vhi.x);
+                const int jj = amrex::min(amrex::max(j, vlo.y), vhi.y);
+                const int kk = amrex::min(amrex::max(k, vlo.z), vhi.z);
+                lam(i,j,k,g) = lam(ii,jj,kk,g);
+            }
+        });
     }
 
     if (filter_lambda_T) {
@@ -995,6 +1117,128 @@ void Radiation::compute_limiter(int level, const BoxArray& grids,
 }
 
 
+void Radiation::filter_lambda(const MultiFab& Er_wide, MultiFab& lamborder)
+{
+    BL_PROFILE("Radiation::filter_lambda (MGFLD)");
+
+    const int ngroups = nGroups;
+    const int ngrow = lamborder.nGrow();
+    const int T = filter_lambda_T;
+    const int S = filter_lambda_S;
+
+    // Each direction filters the result of the one before, over the
+    // zones of the tile grown in the directions still to come.  The
+    // tiles start from a copy of the unfiltered lambda, so they do not
+    // see each other's results.
+
+    MultiFab lam_raw(lamborder.boxArray(), lamborder.DistributionMap(), ngroups, ngrow);
+    MultiFab::Copy(lam_raw, lamborder, 0, 0, ngroups, ngrow);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        FArrayBox lamfil[AMREX_SPACEDIM];
+
+        for (MFIter mfi(lamborder, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            const Box& bx = mfi.tilebox();
+
+            const auto vlo = amrex::lbound(mfi.validbox());
+            const auto vhi = amrex::ubound(mfi.validbox());
+
+            const auto Er = Er_wide[mfi].array();
+
+            Elixir elix_lamfil[AMREX_SPACEDIM];
+
+            Array4<Real const> src = lam_raw[mfi].const_array();
+
+            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+
+                const bool last = dir == AMREX_SPACEDIM - 1;
+
+                Box obx(bx);
+                for (int d = dir + 1; d < AMREX_SPACEDIM; ++d) {
+                    obx.grow(d, ngrow);
+                }
+
+                Array4<Real> dst;
+                if (last) {
+                    dst = lamborder[mfi].array();
+                }
+                else {
+                    lamfil[dir].resize(obx, ngroups);
+                    elix_lamfil[dir] = lamfil[dir].elixir();
+                    dst = lamfil[dir].array();
+                }
+
+                const int di = dir == 0 ? 1 : 0;
+                const int dj = dir == 1 ? 1 : 0;
+                const int dk = dir == 2 ? 1 : 0;
+
+                amrex::ParallelFor(obx, ngroups,
+                [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int g) noexcept
+                {
+                    const int rlo[3] = {vlo.x, vlo.y, vlo.z};
+                    const int rhi[3] = {vhi.x, vhi.y, vhi.z};
+
+                    // Er at the low end of the grid in this and the
+                    // earlier directions tells whether the line is
+                    // outside the domain; nothing uses those lines.
+
+                    int e[3] = {i, j, k};
+                    for (int d = 0; d <= dir; ++d) {
+                        e[d] = rlo[d];
+                    }
+
+                    if (Er(e[0],e[1],e[2],g) == -1.e0_rt) {
+                        dst(i,j,k,g) = src(i,j,k,g);
+                        return;
+                    }
+
+                    e[dir] = rlo[dir] - 1;
+                    const bool lo_unknown = Er(e[0],e[1],e[2],g) == -1.e0_rt;
+
+                    e[dir] = rhi[dir] + 1;
+                    const bool hi_unknown = Er(e[0],e[1],e[2],g) == -1.e0_rt;
+
+                    const int ii[3] = {i, j, k};
+                    const int m_lo = ii[dir] - rlo[dir];
+                    const int m_hi = rhi[dir] - ii[dir];
+
+                    Real lf = 0.e0_rt;
+
+                    if (hi_unknown && m_hi < T) {
+                        for (int n = -m_hi; n <= T; ++n) {
+                            lf += filter::ffb(T, m_hi, n) * src(i-n*di,j-n*dj,k-n*dk,g);
+                        }
+                    }
+                    else if (lo_unknown && m_lo < T) {
+                        for (int n = -m_lo; n <= T; ++n) {
+                            lf += filter::ffb(T, m_lo, n) * src(i+n*di,j+n*dj,k+n*dk,g);
+                        }
+                    }
+                    else {
+                        lf = filter::ff(T, S, 0) * src(i,j,k,g);
+                        for (int n = 1; n <= T; ++n) {
+                            lf += filter::ff(T, S, n) *
+                                (src(i-n*di,j-n*dj,k-n*dk,g) + src(i+n*di,j+n*dj,k+n*dk,g));
+                        }
+                    }
+
+                    if (last) {
+                        lf = amrex::min(1.e0_rt/3.e0_rt, amrex::max(1.e-25_rt, lf));
+                    }
+
+                    dst(i,j,k,g) = lf;
+                });
+
+                src = dst;
+            }
+        }
+    }
+}
+
+
 void Radiation::estimate_gamrPr(const FArrayBox& state, const FArrayBox& Er, 
                                 FArrayBox& gPr, const Real*dx, const Box& box)
 {
@@ -1147,6 +1391,12 @@ void Radiation::bisect_matter(MultiFab& rhoe_new, MultiFab& temp_new,
   temp_new.plus(temp_star, 0, 1, 0);
   temp_new.mult(0.5, 0);
 
+  rhoe_from_temp(rhoe_new, temp_new, S_new);
+}
+
+void Radiation::rhoe_from_temp(MultiFab& rhoe_new, const MultiFab& temp_new,
+                               const MultiFab& S_new)
+{
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
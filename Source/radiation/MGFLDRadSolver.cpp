@@ -9,6 +9,8 @@
 
 #include <RAD_F.H>
 
+#include <telemetry.H>
+
 #include <iostream>
 #include <iomanip>
 
@@ -125,6 +127,14 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
     
   }
 
+  // Tabulate the opacities over this level's densities and temperatures
+  // for the iterations below.
+
+  if (use_opacity_table) {
+      opacity_table.build(rho, temp_new, 1, nugroup, opacity_table_nrho, opacity_table_nT,
+                          opacity_table_T_margin);
+  }
+
   // Planck mean and Rosseland 
   MultiFab kappa_p(grids,dmap,nGroups,1);
   MultiFab kappa_r(grids,dmap,nGroups,1); 
@@ -162,6 +172,20 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
 
   RadSolve* const solver = castro->rad_solver.get();
 
+  // Anderson acceleration of the outer iteration works on the
+  // temperature, and that of the inner iteration on Er.
+
+  std::unique_ptr<AndersonAccel> anderson_out;
+  std::unique_ptr<AndersonAccel> anderson_in;
+  if (anderson_outer_depth > 0) {
+      anderson_out.reset(new AndersonAccel(grids, dmap, 1, anderson_outer_depth));
+  }
+  if (anderson_inner_depth > 0) {
+      anderson_in.reset(new AndersonAccel(grids, dmap, nGroups, anderson_inner_depth));
+  }
+
+  int total_inner = 0;
+
   Real relative_in, absolute_in, error_er;
   Real rel_rhoe, abs_rhoe;
   Real rel_T, abs_T;
@@ -171,9 +195,29 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
   FluxRegister* flux_in = (level < fine_level) ? flux_trial[level+1].get() : nullptr;
   FluxRegister* flux_out = (level > 0) ? flux_trial[level].get() : nullptr;
 
+  // With batch_groups, the A and B coefficients of all the groups are
+  // computed together, and the fluxes of all the groups are computed
+  // after all the solves, with one exchange of ghost cells and one
+  // update of the flux registers.  The Sanchez-Pomraning boundary
+  // coefficients are set one group at a time, so that case is not
+  // batched.
+
+  const bool batch = batch_groups && !have_Sanchez_Pomraning;
+
+  const int nflux = batch ? nGroups : 1;
+
   Array<MultiFab, BL_SPACEDIM> Flux;
   for (int n = 0; n < BL_SPACEDIM; n++) {
-      Flux[n].define(castro->getEdgeBoxArray(n), dmap, 1, 0);
+      Flux[n].define(castro->getEdgeBoxArray(n), dmap, nflux, 0);
+  }
+
+  MultiFab acoefs;
+  Array<MultiFab, BL_SPACEDIM> bcoefs;
+  if (batch) {
+      acoefs.define(grids, dmap, nGroups, 0);
+      for (int n = 0; n < BL_SPACEDIM; n++) {
+          bcoefs[n].define(castro->getEdgeBoxArray(n), dmap, nGroups, 0);
+      }
   }
 
   std::unique_ptr<MultiFab> flxsave;
@@ -238,11 +282,20 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
 
     // After this, djdT contains mugT.
 
+    if (batch) {
+      // kappa_p does not change in the inner iterations
+      solver->levelACoeffsAllGroups(level, kappa_p, acoefs, delta_t, c, ptc_tau);
+    }
+
     // The inner loops does not update rhoe and T
     int innerIteration = 0;
     inner_converged = false;
     Real relative_in_prev = 1.e200, absolute_in_prev = 1.e200;
     bool accel_allowed = true;
+    if (anderson_in) {
+      // the coefficients have changed
+      anderson_in->reset();
+    }
     do {
       innerIteration++;
 
@@ -263,6 +316,10 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
 
       compute_coupling(coupT, kappa_p, Er_pi, jg);
 
+      if (batch) {
+        solver->levelBCoeffsAllGroups(level, lambda, kappa_r, bcoefs, c, limiter != 0);
+      }
+
       for (int igroup=0; igroup<nGroups; ++igroup) {
 
         set_current_group(igroup);
@@ -271,11 +328,19 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
 
         // set boundary condition
         solver->levelBndry(mgbd, igroup);
-        
-        solver->levelACoeffs(level, kappa_p, delta_t, c, igroup, ptc_tau);
 
-        int lamcomp = (limiter==0) ? 0 : igroup;
-        solver->levelBCoeffs(level, lambda, kappa_r, igroup, c, lamcomp);
+        if (batch) {
+          solver->setLevelACoeffs(level, MultiFab(acoefs, amrex::make_alias, igroup, 1));
+          for (int n = 0; n < BL_SPACEDIM; n++) {
+            solver->setLevelBCoeffs(level, MultiFab(bcoefs[n], amrex::make_alias, igroup, 1), n);
+          }
+        }
+        else {
+          solver->levelACoeffs(level, kappa_p, delta_t, c, igroup, ptc_tau);
+
+          int lamcomp = (limiter==0) ? 0 : igroup;
+          solver->levelBCoeffs(level, lambda, kappa_r, igroup, c, lamcomp);
+        }
 
         if (have_Sanchez_Pomraning) {
           solver->levelSPas(level, lambda, igroup, lo_bc, hi_bc);
@@ -294,13 +359,30 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
           solver->levelSolve(level, Er_new, igroup, rhs, 0.01);
         } // end src and rhs block
 
-        solver->levelFlux(level, Flux, Er_new, igroup);
-        solver->levelFluxReg(level, flux_in, flux_out, Flux, igroup);
-          
-        if (icomp_flux >= 0) 
-            solver->levelFluxFaceToCenter(level, Flux, *flxcc, icomp_flux+igroup);
+        if (!batch) {
+          solver->levelFlux(level, Flux, Er_new, igroup);
+          solver->levelFluxReg(level, flux_in, flux_out, Flux, igroup);
+
+          if (icomp_flux >= 0) 
+              solver->levelFluxFaceToCenter(level, Flux, *flxcc, icomp_flux+igroup);
+        }
 
       } // end loop over groups
+
+      if (batch) {
+        solver->levelFluxAllGroups(level, Flux, Er_new, bcoefs, mgbd);
+        solver->levelFluxReg(level, flux_in, flux_out, Flux, 0);
+
+        if (icomp_flux >= 0) {
+          for (int igroup=0; igroup<nGroups; ++igroup) {
+            Array<MultiFab, BL_SPACEDIM> Flux_g;
+            for (int n = 0; n < BL_SPACEDIM; n++) {
+              Flux_g[n] = MultiFab(Flux[n], amrex::make_alias, igroup, 1);
+            }
+            solver->levelFluxFaceToCenter(level, Flux_g, *flxcc, icomp_flux+igroup);
+          }
+        }
+      }
       
       // Check for convergence *before* acceleration step:
       check_convergence_er(relative_in, absolute_in, error_er, Er_new, Er_pi,
@@ -326,6 +408,7 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
       }
 
       if (!inner_converged) {
+        bool restarted = false;
         Real accel_fac=1.+1.e-6;
         if (skipAccelAllowed &&
             relative_in>accel_fac*relative_in_prev && 
@@ -334,6 +417,7 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
           if (relative_in>10.*relative_in_prev && 
               absolute_in>10.*absolute_in_prev) {
             MultiFab::Copy(Er_new, Er_star, 0, 0, nGroups, 0);
+            restarted = true;
           }
         }
         relative_in_prev = relative_in;
@@ -350,10 +434,21 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
                        lambda, solver, mgbd, grids, level, time, delta_t, ptc_tau);
           } 
         }
+
+        if (anderson_in) {
+          if (restarted) {
+            anderson_in->reset();
+          }
+          else {
+            anderson_in->mix(Er_pi, Er_new);
+          }
+        }
       }
 
     } while(!inner_converged && innerIteration < maxInIter); 
 
+    total_inner += innerIteration;
+
     if (verbose == 1) {
       int oldprec = std::cout.precision(3);
       amrex::Print() << "Outer = " << it << ", Inner = " << innerIteration
@@ -481,11 +576,31 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
                              kappa_p, kappa_r, jg, 
                              djdT, dkdT, dedT, // output
                              level, it+1, 0);
+
+      if (anderson_out) {
+        anderson_out->reset();
+      }
+    }
+    else if (!converged && it < maxiter && anderson_out) {
+      // temp_new is the result of this iteration from temp_star.  The
+      // accelerated temperature only sets where the next iteration
+      // starts, so the final update is still the conservative one.
+      if (anderson_out->mix(temp_star, temp_new) > 0) {
+        rhoe_from_temp(rhoe_new, temp_new, S_new);
+
+        eos_opacity_emissivity(S_new, temp_new,
+                               temp_star, // input
+                               kappa_p, kappa_r, jg, 
+                               djdT, dkdT, dedT, // output
+                               level, it+1, 0);
+      }
     }
    
   } while ( ((!converged || !inner_converged) && it<maxiter)
             || !conservative_update);
 
+  opacity_table.clear();
+
   if (verbose == 1) {
     int oldprec = std::cout.precision(4);
     amrex::Print() << "Update Errors for      rhoe,        FT,         T" 
@@ -499,10 +614,20 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
     std::cout.precision(oldprec);
   }
 
+  if (verbose >= 1) {
+      amrex::Print() << "MGFLD level " << level << ": " << it << " outer iterations, "
+                     << total_inner << " inner iterations" << std::endl;
+  }
+
+  telemetry::add_count(level, telemetry::rad_outer, static_cast<Real>(it));
+  telemetry::add_count(level, telemetry::rad_inner, static_cast<Real>(total_inner));
+
   if (!converged) {
       amrex::Abort("Implicit Update Failed to Converge");
   }
 
+  solver->reportSolveTimes(level);
+
   // update flux registers
 
   flux_in = (level < fine_level) ? flux_trial[level+1].get() : nullptr;
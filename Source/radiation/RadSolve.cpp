@@ -10,6 +10,8 @@
 
 #include <rad_util.H>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #ifdef _OPENMP
@@ -18,6 +20,8 @@
 
 #include <RAD_F.H>
 
+#include <telemetry.H>
+
 #include <HABEC_F.H>    // only for nonsymmetric flux; may be changed?
 
 using namespace amrex;
@@ -49,6 +53,11 @@ RadSolve::RadSolve (Amr* Parent, int level, const BoxArray& grids, const Distrib
     }
 }
 
+RadSolve::~RadSolve ()
+{
+    clearSetup();
+}
+
 void
 RadSolve::read_params ()
 {
@@ -169,6 +178,10 @@ void RadSolve::cellCenteredApplyMetrics(int level, MultiFab& cc)
 
 void RadSolve::setLevelACoeffs(int level, const MultiFab& acoefs)
 {
+    if (radsolve::reuse_setup) {
+        coef_norm[0] = acoefs.norm1();
+    }
+
     if (hd) {
         hd->aCoefficients(acoefs);
     }
@@ -182,6 +195,10 @@ void RadSolve::setLevelACoeffs(int level, const MultiFab& acoefs)
 
 void RadSolve::setLevelBCoeffs(int level, const MultiFab& bcoefs, int dir)
 {
+    if (radsolve::reuse_setup) {
+        coef_norm[dir+1] = bcoefs.norm1();
+    }
+
     if (hd) {
         hd->bCoefficients(bcoefs, dir);
     }
@@ -246,15 +263,7 @@ void RadSolve::levelACoeffs(int level,
       });
   }
 
-  if (hd) {
-    hd->aCoefficients(acoefs);
-  }
-  else if (hm) {
-    hm->aCoefficients(level, acoefs);
-  }
-  else if (hem) {
-    hem->aCoefficients(level, acoefs);
-  }
+  setLevelACoeffs(level, acoefs);
 }
 
 void RadSolve::levelSPas(int level, Array<MultiFab, BL_SPACEDIM>& lambda, int igroup, 
@@ -265,14 +274,16 @@ void RadSolve::levelSPas(int level, Array<MultiFab, BL_SPACEDIM>& lambda, int ig
   const Geometry& geom = parent->Geom(level);
   const Box& domainBox = geom.Domain();
 
+  const int limiter = Radiation::limiter;
+
   MultiFab spa(grids, dmap, 1, 0);
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-  for (MFIter mfi(spa,true); mfi.isValid(); ++mfi) {
+  for (MFIter mfi(spa, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
       const Box& reg  = mfi.tilebox();
     
-      spa[mfi].setVal<RunOn::Host>(1.e210,reg,0);
+      spa[mfi].setVal<RunOn::Device>(1.e210,reg,0);
     
       bool nexttoboundary=false;
       for (int idim=0; idim<BL_SPACEDIM; idim++) {
@@ -289,12 +300,46 @@ void RadSolve::levelSPas(int level, Array<MultiFab, BL_SPACEDIM>& lambda, int ig
       }
     
       if (nexttoboundary) {
-          ca_spalpha(reg.loVect(), reg.hiVect(),
-                     BL_TO_FORTRAN(spa[mfi]),
-                     D_DECL(BL_TO_FORTRAN(lambda[0][mfi]),
-                            BL_TO_FORTRAN(lambda[1][mfi]),
-                            BL_TO_FORTRAN(lambda[2][mfi])),
-                     &igroup);
+
+          // Only the cells on the edge of the grid get alpha.
+
+          const auto vlo = amrex::lbound(mfi.validbox());
+          const auto vhi = amrex::ubound(mfi.validbox());
+
+          auto spa_arr = spa[mfi].array();
+          auto lamx = lambda[0][mfi].array();
+#if AMREX_SPACEDIM >= 2
+          auto lamy = lambda[1][mfi].array();
+#endif
+#if AMREX_SPACEDIM == 3
+          auto lamz = lambda[2][mfi].array();
+#endif
+
+          amrex::ParallelFor(reg,
+          [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+          {
+#if AMREX_SPACEDIM == 1
+              if (i == vlo.x) {
+                  spa_arr(i,j,k) = FLDalpha(lamx(i,j,k,igroup), limiter);
+              }
+              if (i == vhi.x) {
+                  spa_arr(i,j,k) = FLDalpha(lamx(i+1,j,k,igroup), limiter);
+              }
+#elif AMREX_SPACEDIM == 2
+              if (i == vlo.x || i == vhi.x || j == vlo.y || j == vhi.y) {
+                  Real lam = 0.25e0_rt * (lamx(i,j,k,igroup) + lamx(i+1,j,k,igroup) +
+                                          lamy(i,j,k,igroup) + lamy(i,j+1,k,igroup));
+                  spa_arr(i,j,k) = FLDalpha(lam, limiter);
+              }
+#else
+              if (i == vlo.x || i == vhi.x || j == vlo.y || j == vhi.y || k == vlo.z || k == vhi.z) {
+                  Real lam = (lamx(i,j,k,igroup) + lamx(i+1,j,k,igroup) +
+                              lamy(i,j,k,igroup) + lamy(i,j+1,k,igroup) +
+                              lamz(i,j,k,igroup) + lamz(i,j,k+1,igroup)) / 6.e0_rt;
+                  spa_arr(i,j,k) = FLDalpha(lam, limiter);
+              }
+#endif
+          });
       }
   }
 
@@ -382,15 +427,7 @@ void RadSolve::levelBCoeffs(int level,
         });
     }
 
-    if (hd) {
-        hd->bCoefficients(bcoefs, idim);
-    }
-    else if (hm) {
-      hm->bCoefficients(level, bcoefs, idim);
-    }
-    else if (hem) {
-      hem->bCoefficients(level, bcoefs, idim);
-    }
+    setLevelBCoeffs(level, bcoefs, idim);
   } // -->> over dimension
 }
 
@@ -400,8 +437,8 @@ void RadSolve::levelDCoeffs(int level, Array<MultiFab, BL_SPACEDIM>& lambda,
     BL_PROFILE("RadSolve::levelDCoeffs");
     const Castro *castro = dynamic_cast<Castro*>(&parent->getLevel(level));
     const DistributionMapping& dm = castro->DistributionMap();
-    const Geometry& geom = parent->Geom(level);
-    const Real* dx       = geom.CellSize();
+
+    auto geomdata = parent->Geom(level).data();
 
     for (int idim=0; idim<BL_SPACEDIM; idim++) {
 
@@ -414,14 +451,42 @@ void RadSolve::levelDCoeffs(int level, Array<MultiFab, BL_SPACEDIM>& lambda,
 
             const Box& bx = mfi.tilebox();
 
-#pragma gpu box(bx)
-            ca_compute_dcoefs(AMREX_INT_ANYD(bx.loVect()), AMREX_INT_ANYD(bx.hiVect()),
-                              BL_TO_FORTRAN_ANYD(dcoefs[mfi]),
-                              BL_TO_FORTRAN_ANYD(lambda[idim][mfi]),
-                              BL_TO_FORTRAN_ANYD(vel[mfi]),
-                              BL_TO_FORTRAN_ANYD(dcf[mfi]), 
-                              AMREX_REAL_ANYD(dx), idim);
+            auto d = dcoefs[mfi].array();
+            auto lam = lambda[idim][mfi].array();
+            auto v = vel[mfi].array();
+            auto dcf_arr = dcf[mfi].array();
+
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+            {
+                // Upwind the velocity onto the face.
+
+                int il = i, jl = j, kl = k;
+                if (idim == 0) {
+                    il = i - 1;
+                }
+                else if (idim == 1) {
+                    jl = j - 1;
+                }
+                else {
+                    kl = k - 1;
+                }
+
+                const Real vsum = v(il,jl,kl,idim) + v(i,j,k,idim);
+
+                Real r, s;
+                edge_center_metric(i, j, k, idim, geomdata, r, s);
 
+                if (vsum > 0.e0_rt) {
+                    d(i,j,k) = dcf_arr(il,jl,kl) * v(il,jl,kl,idim) * lam(i,j,k) * r;
+                }
+                else if (vsum < 0.e0_rt) {
+                    d(i,j,k) = dcf_arr(i,j,k) * v(i,j,k,idim) * lam(i,j,k) * r;
+                }
+                else {
+                    d(i,j,k) = 0.e0_rt;
+                }
+            });
         }
 
         hem->d2Coefficients(level, dcoefs, idim);
@@ -441,8 +506,7 @@ void RadSolve::levelRhs(int level, MultiFab& rhs,
   BL_PROFILE("RadSolve::levelRhs");
   BL_ASSERT(rhs.nGrow() == 0);
 
-  const Geometry& geom = parent->Geom(level);
-  const Real* dx       = geom.CellSize();
+  auto geomdata = parent->Geom(level).data();
 
   rhs.setVal(0.0);
   if (fine_corr) {
@@ -466,19 +530,40 @@ void RadSolve::levelRhs(int level, MultiFab& rhs,
   for (MFIter mfi(rhs, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
       const Box& bx = mfi.tilebox();
 
-#pragma gpu box(bx)
-      lrhs(AMREX_INT_ANYD(bx.loVect()), AMREX_INT_ANYD(bx.hiVect()),
-           BL_TO_FORTRAN_ANYD(rhs[mfi]), 
-           BL_TO_FORTRAN_ANYD(temp[mfi]),
-           BL_TO_FORTRAN_ANYD(fkp[mfi]),
-           BL_TO_FORTRAN_ANYD(eta[mfi]),
-           BL_TO_FORTRAN_ANYD(etainv[mfi]),
-           BL_TO_FORTRAN_ANYD(rhoem[mfi]),
-           BL_TO_FORTRAN_ANYD(rhoes[mfi]),
-           BL_TO_FORTRAN_ANYD(dflux_old[mfi]),
-           BL_TO_FORTRAN_N_ANYD(Er_old[mfi], 0), 
-           BL_TO_FORTRAN_ANYD(Edot[mfi]),
-           delta_t, AMREX_REAL_ANYD(dx), sigma, c, theta);
+      auto rhs_arr = rhs[mfi].array();
+      auto temp_arr = temp[mfi].array();
+      auto fkp_arr = fkp[mfi].array();
+      auto eta_arr = eta[mfi].array();
+      auto etainv_arr = etainv[mfi].array();
+      auto frhoem = rhoem[mfi].array();
+      auto frhoes = rhoes[mfi].array();
+      auto dfo = dflux_old[mfi].array();
+      auto ero = Er_old[mfi].array();
+      auto edot = Edot[mfi].array();
+
+      const Real dtm = 1.e0_rt / delta_t;
+
+      amrex::ParallelFor(bx,
+      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+      {
+          const Real ek = fkp_arr(i,j,k) * eta_arr(i,j,k);
+          const Real bs = etainv_arr(i,j,k) * 4.e0_rt * sigma * fkp_arr(i,j,k) *
+                          std::pow(temp_arr(i,j,k), 4);
+          const Real es = eta_arr(i,j,k) * (frhoem(i,j,k) - frhoes(i,j,k));
+          const Real ekt = (1.e0_rt - theta) * eta_arr(i,j,k);
+
+          Real r, s;
+          cell_center_metric(i, j, k, geomdata, r, s);
+
+          if (AMREX_SPACEDIM == 1) {
+              s = 1.e0_rt;
+          }
+
+          rhs_arr(i,j,k) = (rhs_arr(i,j,k) + r * s *
+                            (bs + dtm * (ero(i,j,k,0) + es) +
+                             ek * c * edot(i,j,k) -
+                             ekt * dfo(i,j,k))) / (1.e0_rt - ekt);
+      });
   }
 }
 
@@ -489,63 +574,188 @@ void RadSolve::levelSolve(int level,
 {
   BL_PROFILE("RadSolve::levelSolve");
 
+  // hm and hem are driven the same way here
+  HypreMultiABec* hmp = hm ? hm.get() : hem.get();
+
   // Set coeffs, build solver, solve
   if (hd) {
     hd->setScalars(radsolve::alpha, radsolve::beta);
   }
-  else if (hm) {
-    hm->setScalars(radsolve::alpha, radsolve::beta);
+  else {
+    hmp->setScalars(radsolve::alpha, radsolve::beta);
   }
-  else if (hem) {
-    hem->setScalars(radsolve::alpha, radsolve::beta);
+
+  // A solver kept from an earlier solve only has its matrix values
+  // reloaded; its multigrid hierarchy is the one built for the matrix
+  // it was set up with.
+
+  if (have_setup && (!canReuseSetup() || setupIsStale())) {
+    clearSetup();
   }
 
+  bool fresh_setup = !have_setup;
+
+  auto setup = [&] () {
+    if (hd) {
+      hd->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+    }
+    else {
+      hmp->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+    }
+    have_setup = true;
+    num_setups++;
+  };
+
+  auto solve = [&] () {
+    if (hd) {
+      hd->solve(Er, igroup, rhs, Inhomogeneous_BC);
+    }
+    else {
+      hmp->solve();
+    }
+    num_solves++;
+    return hd ? hd->getNumIterations() : hmp->getNumIterations();
+  };
+
+  Real strt_time = ParallelDescriptor::second();
+
   if (hd) {
-    hd->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
-    hd->solve(Er, igroup, rhs, Inhomogeneous_BC);
-    Real res = hd->getAbsoluteResidual();
-    if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
-      int oldprec = std::cout.precision(20);
-      std::cout << "Absolute residual = " << res << std::endl;
-      std::cout.precision(oldprec);
+    if (fresh_setup) {
+      setup();
+    }
+    else {
+      hd->loadMatrix();
     }
-    res *= sync_absres_factor;
-    hd->clearSolver();
   }
-  else if (hm) {
-    hm->loadMatrix();
-    hm->finalizeMatrix();
-    hm->loadLevelVectors(level, Er, igroup, rhs, Inhomogeneous_BC);
-    hm->finalizeVectors();
-    hm->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
-    hm->solve();
-    hm->getSolution(level, Er, igroup);
-    Real res = hm->getAbsoluteResidual();
-    if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
-      int oldprec = std::cout.precision(20);
-      std::cout << "Absolute residual = " << res << std::endl;
-      std::cout.precision(oldprec);
-    }
-    res *= sync_absres_factor;
-    hm->clearSolver();
+  else {
+    hmp->loadMatrix();
+    hmp->finalizeMatrix();
+    hmp->loadLevelVectors(level, Er, igroup, rhs, Inhomogeneous_BC);
+    hmp->finalizeVectors();
+    if (fresh_setup) {
+      setup();
+    }
   }
-  else if (hem) {
-    hem->loadMatrix();
-    hem->finalizeMatrix();
-    hem->loadLevelVectors(level, Er, igroup, rhs, Inhomogeneous_BC);
-    hem->finalizeVectors();
-    hem->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
-    hem->solve();
-    hem->getSolution(level, Er, igroup);
-    Real res = hem->getAbsoluteResidual();
-    if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
-      int oldprec = std::cout.precision(20);
-      std::cout << "Absolute residual = " << res << std::endl;
-      std::cout.precision(oldprec);
+
+  Real setup_end = ParallelDescriptor::second();
+  setup_time += setup_end - strt_time;
+
+  int iters = solve();
+
+  solve_time += ParallelDescriptor::second() - setup_end;
+
+  if (!fresh_setup && iters >= radsolve::maxiter) {
+
+    // The kept solver did not converge.  Set it up again for the
+    // current matrix and carry on from where it got to.
+
+    strt_time = ParallelDescriptor::second();
+
+    clearSetup();
+    setup();
+    fresh_setup = true;
+
+    setup_end = ParallelDescriptor::second();
+    setup_time += setup_end - strt_time;
+
+    iters = solve();
+
+    solve_time += ParallelDescriptor::second() - setup_end;
+  }
+
+  if (!hd) {
+    hmp->getSolution(level, Er, igroup);
+  }
+
+  Real res = hd ? hd->getAbsoluteResidual() : hmp->getAbsoluteResidual();
+  if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
+    int oldprec = std::cout.precision(20);
+    std::cout << "Absolute residual = " << res << std::endl;
+    std::cout.precision(oldprec);
+  }
+  res *= sync_absres_factor;
+
+  if (!canReuseSetup()) {
+    clearSetup();
+  }
+  else if (fresh_setup) {
+    setup_stale = false;
+    setup_iters = iters;
+    for (int n = 0; n <= BL_SPACEDIM; n++) {
+      setup_coef_norm[n] = coef_norm[n];
+    }
+  }
+  else {
+    setup_stale = iters > radsolve::reuse_max_iter_growth * std::max(setup_iters, 1);
+  }
+}
+
+bool RadSolve::canReuseSetup() const
+{
+  // The tolerance set from abstol is only ever loosened by solve, so
+  // a kept solver could carry a loose tolerance into the next solve.
+  // hem has its C and D terms switched on and off between solves.
+
+  return radsolve::reuse_setup != 0 && radsolve::abstol <= 0.0 &&
+         (hd || (hm && hm->setupIsReusable()));
+}
+
+bool RadSolve::setupIsStale() const
+{
+  if (setup_stale) {
+    return true;
+  }
+
+  if (radsolve::reuse_max_coef_change > 0.0) {
+    Real change = 0.0;
+    Real norm = 0.0;
+    for (int n = 0; n <= BL_SPACEDIM; n++) {
+      change += std::abs(coef_norm[n] - setup_coef_norm[n]);
+      norm += setup_coef_norm[n];
+    }
+    if (change > radsolve::reuse_max_coef_change * norm) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void RadSolve::clearSetup()
+{
+  if (have_setup) {
+    if (hd) {
+      hd->clearSolver();
+    }
+    else if (hm) {
+      hm->clearSolver();
+    }
+    else if (hem) {
+      hem->clearSolver();
     }
-    res *= sync_absres_factor;
-    hem->clearSolver();
   }
+
+  have_setup = false;
+  setup_stale = false;
+}
+
+void RadSolve::reportSolveTimes(int level)
+{
+  if (radsolve::verbose >= 1) {
+    Real times[2] = {setup_time, solve_time};
+    ParallelDescriptor::ReduceRealMax(times, 2, ParallelDescriptor::IOProcessorNumber());
+
+    amrex::Print() << "RadSolve level " << level << ": " << num_solves << " solves, "
+                   << num_setups << " setups, setup time = " << times[0]
+                   << ", solve time = " << times[1] << std::endl;
+  }
+
+  telemetry::add_count(level, telemetry::rad_solves, static_cast<Real>(num_solves));
+
+  setup_time = 0.0;
+  solve_time = 0.0;
+  num_setups = 0;
+  num_solves = 0;
 }
 
 void RadSolve::levelFluxFaceToCenter(int level, const Array<MultiFab, BL_SPACEDIM>& Flux,
@@ -660,20 +870,22 @@ void RadSolve::levelFluxReg(int level,
 
   const Real volume = D_TERM(dx[0], * dx[1], * dx[2]);
 
+  const int ncomp = Flux[0].nComp();
+
   if (flux_in) {
     for (int n = 0; n < BL_SPACEDIM; n++) {
       const Real scale = volume / dx[n];
-      flux_in->CrseInit(Flux[n], n, 0, igroup, 1, scale);
+      flux_in->CrseInit(Flux[n], n, 0, igroup, ncomp, scale);
     }
   }
   if (flux_out) {
     for (OrientationIter face; face; ++face) {
       Orientation ori = face();
-      (*flux_out)[ori].setVal(0.0, igroup, 1);
+      (*flux_out)[ori].setVal(0.0, igroup, ncomp);
     }
     for (int n = 0; n < BL_SPACEDIM; n++) {
       const Real scale = volume / dx[n];
-      flux_out->FineAdd(Flux[n], n, 0, igroup, 1, scale);
+      flux_out->FineAdd(Flux[n], n, 0, igroup, ncomp, scale);
     }
   }
 }
@@ -854,7 +1066,8 @@ void RadSolve::levelACoeffs(int level, MultiFab& kpp,
   BL_PROFILE("RadSolve::levelACoeffs (MGFLD)");
   const BoxArray& grids = parent->boxArray(level);
   const DistributionMapping& dmap = parent->DistributionMap(level);
-  const Real* dx = parent->Geom(level).CellSize();
+
+  auto geomdata = parent->Geom(level).data();
 
   // allocate space for ABecLaplacian acoeffs, fill with values
 
@@ -868,28 +1081,195 @@ void RadSolve::levelACoeffs(int level, MultiFab& kpp,
   for (MFIter mfi(kpp, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
       const Box& bx = mfi.tilebox();
-          
-      Real dt_ptc = delta_t / (1.0 + ptc_tau);
 
-#pragma gpu box(bx)
-      lacoefmgfld(AMREX_INT_ANYD(bx.loVect()), AMREX_INT_ANYD(bx.hiVect()),
-                  BL_TO_FORTRAN_ANYD(acoefs[mfi]), 
-                  BL_TO_FORTRAN_N_ANYD(kpp[mfi], igroup), 
-                  AMREX_REAL_ANYD(dx), dt_ptc, c);
+      auto a = acoefs[mfi].array();
+      auto kpp_arr = kpp[mfi].array();
+
+      const Real dt_ptc = delta_t / (1.0 + ptc_tau);
+      const Real dtm = 1.e0_rt / dt_ptc;
+
+      amrex::ParallelFor(bx,
+      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+      {
+          Real r, s;
+          cell_center_metric(i, j, k, geomdata, r, s);
+
+          a(i,j,k) = r * s * (c * kpp_arr(i,j,k,igroup) + dtm);
+      });
   }
 
   // set a coefficients
-  if (hd) {
-    hd->aCoefficients(acoefs);
-  }
-  else if (hm) {
-    hm->aCoefficients(level,acoefs);
+  setLevelACoeffs(level, acoefs);
+}
+
+
+void RadSolve::levelACoeffsAllGroups(int level, const MultiFab& kpp, MultiFab& acoefs,
+                                     Real delta_t, Real c, Real ptc_tau)
+{
+  BL_PROFILE("RadSolve::levelACoeffsAllGroups");
+
+  auto geomdata = parent->Geom(level).data();
+
+  const int ngroups = acoefs.nComp();
+  const Real dt_ptc = delta_t / (1.0 + ptc_tau);
+  const Real dtm = 1.e0_rt / dt_ptc;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  for (MFIter mfi(acoefs, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+      const Box& bx = mfi.tilebox();
+
+      auto a = acoefs[mfi].array();
+      auto kpp_arr = kpp[mfi].array();
+
+      amrex::ParallelFor(bx, ngroups,
+      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int g) noexcept
+      {
+          Real r, s;
+          cell_center_metric(i, j, k, geomdata, r, s);
+
+          a(i,j,k,g) = r * s * (c * kpp_arr(i,j,k,g) + dtm);
+      });
   }
-  else if (hem) {
-    hem->aCoefficients(level,acoefs);
+}
+
+void RadSolve::levelBCoeffsAllGroups(int level, const Array<MultiFab, BL_SPACEDIM>& lambda,
+                                     const MultiFab& kappa_r,
+                                     Array<MultiFab, BL_SPACEDIM>& bcoefs,
+                                     Real c, bool lambda_per_group)
+{
+  BL_PROFILE("RadSolve::levelBCoeffsAllGroups");
+  BL_ASSERT(kappa_r.nGrow() == 1);
+
+  auto geomdata = parent->Geom(level).data();
+  auto dx = parent->Geom(level).CellSizeArray();
+
+  for (int idim = 0; idim < BL_SPACEDIM; ++idim) {
+
+    const int ngroups = bcoefs[idim].nComp();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(bcoefs[idim], TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+
+        auto bcoefs_arr = bcoefs[idim][mfi].array();
+        auto lambda_arr = lambda[idim][mfi].array();
+        auto kappa_r_arr = kappa_r[mfi].array();
+
+        amrex::ParallelFor(bx, ngroups,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int g) noexcept
+        {
+            Real r, s;
+            edge_center_metric(i, j, k, idim, geomdata, r, s);
+
+            if (AMREX_SPACEDIM == 1) {
+                s = 1.e0_rt;
+            }
+
+            const int lg = lambda_per_group ? g : 0;
+
+            Real kap;
+            if (idim == 0) {
+                kap = kavg(kappa_r_arr(i-1,j,k,g), kappa_r_arr(i,j,k,g), dx[0], -1);
+            }
+            else if (idim == 1) {
+                kap = kavg(kappa_r_arr(i,j-1,k,g), kappa_r_arr(i,j,k,g), dx[1], -1);
+            }
+            else {
+                kap = kavg(kappa_r_arr(i,j,k-1,g), kappa_r_arr(i,j,k,g), dx[2], -1);
+            }
+
+            bcoefs_arr(i,j,k,g) = r * s * c * lambda_arr(i,j,k,lg) / kap;
+        });
+    }
   }
 }
 
+void RadSolve::levelFluxAllGroups(int level, Array<MultiFab, BL_SPACEDIM>& Flux,
+                                  MultiFab& Er,
+                                  const Array<MultiFab, BL_SPACEDIM>& bcoefs,
+                                  MGRadBndry& mgbd)
+{
+  BL_PROFILE("RadSolve::levelFluxAllGroups");
+  const BoxArray& grids = parent->boxArray(level);
+  const DistributionMapping& dmap = parent->DistributionMap(level);
+
+  const int ngroups = Flux[0].nComp();
+
+  // grow a larger MultiFab to hold Er so we can difference across faces
+  MultiFab Erborder(grids, dmap, ngroups, 1);
+  Erborder.setVal(0.0);
+  MultiFab::Copy(Erborder, Er, 0, 0, ngroups, 0);
+
+  Erborder.FillBoundary(parent->Geom(level).periodicity()); // zeroes left in off-level boundaries
+
+  auto dx = parent->Geom(level).CellSizeArray();
+
+  for (int n = 0; n < BL_SPACEDIM; n++) {
+
+      const Real fac = -radsolve::beta / dx[n];
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      for (MFIter mfi(Flux[n], TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+          const Box& bx = mfi.tilebox();
+
+          auto flux = Flux[n][mfi].array();
+          auto bcoef = bcoefs[n][mfi].array();
+          auto er = Erborder[mfi].array();
+
+          amrex::ParallelFor(bx, ngroups,
+          [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int g) noexcept
+          {
+              if (n == 0) {
+                  flux(i,j,k,g) = bcoef(i,j,k,g) * (er(i,j,k,g) - er(i-1,j,k,g)) * fac;
+              }
+              else if (n == 1) {
+                  flux(i,j,k,g) = bcoef(i,j,k,g) * (er(i,j,k,g) - er(i,j-1,k,g)) * fac;
+              }
+              else {
+                  flux(i,j,k,g) = bcoef(i,j,k,g) * (er(i,j,k,g) - er(i,j,k-1,g)) * fac;
+              }
+          });
+      }
+  }
+
+  // Correct fluxes at physical and coarse-fine boundaries, as in
+  // levelFlux.  This needs the boundary data and b coefficients of
+  // each group in the solver.
+
+  if (hd || hm) {
+    for (int g = 0; g < ngroups; g++) {
+
+      levelBndry(mgbd, g);
+
+      Array<MultiFab, BL_SPACEDIM> Flux_g;
+
+      for (int n = 0; n < BL_SPACEDIM; n++) {
+        Flux_g[n] = MultiFab(Flux[n], amrex::make_alias, g, 1);
+
+        MultiFab bcoefs_g(bcoefs[n], amrex::make_alias, g, 1);
+        if (hd) {
+          hd->bCoefficients(bcoefs_g, n);
+        }
+        else {
+          hm->bCoefficients(level, bcoefs_g, n);
+        }
+      }
+
+      if (hd) {
+        hd->boundaryFlux(&Flux_g[0], Er, g, Inhomogeneous_BC);
+      }
+      else {
+        hm->boundaryFlux(level, &Flux_g[0], Er, g, Inhomogeneous_BC);
+      }
+    }
+  }
+}
 
 void RadSolve::levelRhs(int level, MultiFab& rhs, const MultiFab& jg, 
                         const MultiFab& mugT,
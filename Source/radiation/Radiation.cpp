@@ -11,6 +11,7 @@
 #include <AMReX_PROB_AMR_F.H>
 
 #include <opacity.H>
+#include <problem_filter_prim.H>
 
 #include <iostream>
 
@@ -369,6 +370,38 @@ Radiation::Radiation(Amr* Parent, Castro* castro, int restart)
   inner_update_limiter = 0;
   pp.query("inner_update_limiter", inner_update_limiter);
 
+  batch_groups = 0;
+  pp.query("batch_groups", batch_groups);
+
+  use_planck_table = 0;
+  pp.query("use_planck_table", use_planck_table);
+
+  use_opacity_table = 0;
+  pp.query("use_opacity_table", use_opacity_table);
+  opacity_table_nrho = 32;
+  pp.query("opacity_table_nrho", opacity_table_nrho);
+  opacity_table_nT = 64;
+  pp.query("opacity_table_nT", opacity_table_nT);
+  opacity_table_T_margin = 2.0;
+  pp.query("opacity_table_T_margin", opacity_table_T_margin);
+
+  anderson_outer_depth = 0;
+  pp.query("anderson_outer_depth", anderson_outer_depth);
+  anderson_inner_depth = 0;
+  pp.query("anderson_inner_depth", anderson_inner_depth);
+
+  if (anderson_outer_depth > AndersonAccel::max_depth ||
+      anderson_inner_depth > AndersonAccel::max_depth) {
+      amrex::Print() << "Warning: radiation.anderson_*_depth is limited to "
+                     << AndersonAccel::max_depth << std::endl;
+  }
+
+  if (use_opacity_table && NumAux > 0) {
+      // The table does not know about Ye.
+      amrex::Print() << "Warning: radiation.use_opacity_table is ignored with auxiliary variables" << std::endl;
+      use_opacity_table = 0;
+  }
+
   update_opacity    = 1000;
 
   if (SolverType == SGFLDSolver || SolverType == MGFLDSolver) {
@@ -513,6 +546,17 @@ Radiation::Radiation(Amr* Parent, Castro* castro, int restart)
     nugroup.resize(1, 1.0);
   }
 
+  if (use_planck_table && SolverType == MGFLDSolver) {
+      Real Tmin = 1.e3;
+      Real Tmax = 1.e10;
+      int npts = 512;
+      pp.query("planck_table_Tmin", Tmin);
+      pp.query("planck_table_Tmax", Tmax);
+      pp.query("planck_table_npts", npts);
+
+      planck_table.init(xnu, Tmin, Tmax, npts);
+  }
+
   // current implementation of the Radiation boundary condition reads
   // incoming flux information in the RadBndry constructor.  we just
   // set the boundary condition type here:
@@ -2648,11 +2692,6 @@ void Radiation::filter_prim(int level, MultiFab& State)
   const DistributionMapping& dmap = castro->DistributionMap();
   const Geometry& geom = parent->Geom(level);
 
-  const int*  domain_lo = geom.Domain().loVect();
-  const int*  domain_hi = geom.Domain().hiVect();
-  const Real* dx        = geom.CellSize();
-  const Real* prob_lo   = geom.ProbLo();
-
   int ngrow = filter_prim_T;
   int ncomp = State.nComp();
   Real time = castro->get_state_data(Rad_Type).curTime();
@@ -2686,23 +2725,26 @@ void Radiation::filter_prim(int level, MultiFab& State)
   FillPatchIterator fpi(*castro,State,ngrow,time,State_Type,0,ncomp);
   MultiFab& S_fp = fpi.get_mf();
 
+  const auto geomdata = geom.data();
+  const int filter_T = filter_prim_T;
+  const int filter_S = filter_prim_S;
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-  for (MFIter mfi(State,true); mfi.isValid(); ++mfi)
+  for (MFIter mfi(State, TilingIfNotGPU()); mfi.isValid(); ++mfi)
   {
       const Box& bx = mfi.tilebox();
 
-      const RealBox& gridloc = RealBox(bx, dx, prob_lo);
-      const Real* xlo = gridloc.lo();
-
-      ca_filt_prim(bx.loVect(), bx.hiVect(),
-                   BL_TO_FORTRAN( S_fp[mfi]),
-                   BL_TO_FORTRAN(State[mfi]),
-                   BL_TO_FORTRAN( mask[mfi]),
-                   &filter_prim_T, &filter_prim_S,
-                   domain_lo, domain_hi,
-                   dx, xlo, prob_lo,
-                   &time, &level);
+      auto Stmp = S_fp[mfi].const_array();
+      auto Snew = State[mfi].array();
+      auto mask_arr = mask[mfi].const_array();
+
+      amrex::ParallelFor(bx,
+      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+      {
+          problem_filter_prim(i, j, k, Stmp, Snew, mask_arr,
+                              filter_T, filter_S, geomdata, time, level);
+      });
   }
 }
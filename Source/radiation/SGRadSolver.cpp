@@ -319,6 +319,8 @@ void Radiation::single_group_update(int level, int iteration, int ncycle)
     }
   }
 
+  solver->reportSolveTimes(level);
+
   // update flux registers:
   if (flux_in) {
     for (OrientationIter face; face; ++face) {
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cmath>
+
+#include <AMReX_BLProfiler.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <anderson.H>
+
+using namespace amrex;
+
+constexpr int AndersonAccel::max_depth;
+
+AndersonAccel::AndersonAccel (const BoxArray& ba, const DistributionMapping& dm,
+                              int ncomp, int depth)
+    : m_depth(amrex::min(depth, max_depth)), m_ncomp(ncomp)
+{
+    AMREX_ALWAYS_ASSERT(depth > 0 && ncomp > 0);
+
+    dF.resize(m_depth);
+    dG.resize(m_depth);
+    for (int j = 0; j < m_depth; ++j) {
+        dF[j].define(ba, dm, ncomp, 0);
+        dG[j].define(ba, dm, ncomp, 0);
+    }
+
+    f_prev.define(ba, dm, ncomp, 0);
+    g_prev.define(ba, dm, ncomp, 0);
+    f.define(ba, dm, ncomp, 0);
+}
+
+void
+AndersonAccel::reset ()
+{
+    m_size = 0;
+    m_next = 0;
+    m_have_prev = false;
+    weight.clear();
+}
+
+Real
+AndersonAccel::local_dot (const MultiFab& a, const MultiFab& b) const
+{
+    ReduceOps<ReduceOpSum> reduce_op;
+    ReduceData<Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    const Real* const w = weight.dataPtr();
+    const int nc = m_ncomp;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(a, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+
+        const auto aa = a[mfi].array();
+        const auto bb = b[mfi].array();
+
+        reduce_op.eval(bx, reduce_data,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
+        {
+            Real s = 0.0;
+            for (int n = 0; n < nc; ++n) {
+                s += w[n] * aa(i,j,k,n) * bb(i,j,k,n);
+            }
+            return {s};
+        });
+    }
+
+    ReduceTuple hv = reduce_data.value();
+    return amrex::get<0>(hv);
+}
+
+int
+AndersonAccel::mix (const MultiFab& x, MultiFab& gx)
+{
+    BL_PROFILE("AndersonAccel::mix()");
+
+    if (m_depth == 0) {
+        return 0;
+    }
+
+    MultiFab::LinComb(f, 1.0, gx, 0, -1.0, x, 0, 0, m_ncomp, 0);
+
+    if (weight.empty()) {
+
+        // Weight each component by the inverse of its squared norm, with
+        // components that are (nearly) zero counting as much as a small
+        // fraction of the largest one.
+
+        Vector<Real> norm(m_ncomp);
+        Real norm_max = 0.0;
+        for (int n = 0; n < m_ncomp; ++n) {
+            norm[n] = gx.norm2(n);
+            norm_max = amrex::max(norm_max, norm[n]);
+        }
+
+        weight.resize(m_ncomp);
+        for (int n = 0; n < m_ncomp; ++n) {
+            if (norm_max > 0.0) {
+                const Real nrm = amrex::max(norm[n], 1.e-12_rt * norm_max);
+                weight[n] = 1.0 / (nrm * nrm);
+            } else {
+                weight[n] = 1.0;
+            }
+        }
+    }
+
+    if (m_have_prev) {
+        MultiFab::LinComb(dF[m_next], 1.0, f, 0, -1.0, f_prev, 0, 0, m_ncomp, 0);
+        MultiFab::LinComb(dG[m_next], 1.0, gx, 0, -1.0, g_prev, 0, 0, m_ncomp, 0);
+        m_next = (m_next + 1) % m_depth;
+        m_size = amrex::min(m_size + 1, m_depth);
+    }
+
+    MultiFab::Copy(f_prev, f, 0, 0, m_ncomp, 0);
+    MultiFab::Copy(g_prev, gx, 0, 0, m_ncomp, 0);
+    m_have_prev = true;
+
+    const int m = m_size;
+
+    if (m == 0) {
+        return 0;
+    }
+
+    // The normal equations of the least squares problem, A gamma = b with
+    // A_ij = (dF_i, dF_j) and b_i = (dF_i, f).  All of the dot products
+    // are reduced over the ranks together.
+
+    Vector<Real> dots(m * m + m, 0.0);
+
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            dots[i * m + j] = local_dot(dF[i], dF[j]);
+        }
+        dots[m * m + i] = local_dot(dF[i], f);
+    }
+
+    ParallelDescriptor::ReduceRealSum(dots.dataPtr(), m * m + m);
+
+    Real A[max_depth][max_depth];
+    Real gamma[max_depth];
+
+    Real diag_max = 0.0;
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            A[i][j] = dots[i * m + j];
+            A[j][i] = dots[i * m + j];
+        }
+        gamma[i] = dots[m * m + i];
+        diag_max = amrex::max(diag_max, A[i][i]);
+    }
+
+    // A small regularization keeps nearly dependent differences from
+    // blowing up the coefficients.
+
+    for (int i = 0; i < m; ++i) {
+        A[i][i] += 1.e-12_rt * diag_max;
+    }
+
+    // Gaussian elimination with partial pivoting.  The result is the same
+    // on all ranks, since they all have the same A and b.
+
+    bool singular = !(diag_max > 0.0);
+
+    for (int k = 0; k < m && !singular; ++k) {
+        int p = k;
+        for (int i = k + 1; i < m; ++i) {
+            if (std::abs(A[i][k]) > std::abs(A[p][k])) {
+                p = i;
+            }
+        }
+
+        if (!(std::abs(A[p][k]) > 1.e-14_rt * diag_max)) {
+            singular = true;
+            break;
+        }
+
+        if (p != k) {
+            for (int j = 0; j < m; ++j) {
+                std::swap(A[k][j], A[p][j]);
+            }
+            std::swap(gamma[k], gamma[p]);
+        }
+
+        for (int i = k + 1; i < m; ++i) {
+            const Real fac = A[i][k] / A[k][k];
+            for (int j = k; j < m; ++j) {
+                A[i][j] -= fac * A[k][j];
+            }
+            gamma[i] -= fac * gamma[k];
+        }
+    }
+
+    if (singular) {
+        // Start the history over from this iterate.
+        m_size = 0;
+        m_next = 0;
+        return 0;
+    }
+
+    for (int i = m - 1; i >= 0; --i) {
+        for (int j = i + 1; j < m; ++j) {
+            gamma[i] -= A[i][j] * gamma[j];
+        }
+        gamma[i] /= A[i][i];
+    }
+
+    // The accelerated iterate, in f, which is no longer needed.
+
+    MultiFab::Copy(f, gx, 0, 0, m_ncomp, 0);
+    for (int j = 0; j < m; ++j) {
+        MultiFab::Saxpy(f, -gamma[j], dG[j], 0, 0, m_ncomp, 0);
+    }
+
+    const int nc = m_ncomp;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(gx, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+
+        const auto xa = f[mfi].array();
+        auto ga = gx[mfi].array();
+
+        amrex::ParallelFor(bx, nc,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            if (xa(i,j,k,n) > 0.0) {
+                ga(i,j,k,n) = xa(i,j,k,n);
+            }
+        });
+    }
+
+    return m;
+}
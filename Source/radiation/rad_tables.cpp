@@ -0,0 +1,192 @@
+#include <cmath>
+
+#include <AMReX_BLProfiler.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <blackbody.H>
+#include <rad_tables.H>
+
+using namespace amrex;
+
+void
+PlanckTable::init (const Vector<Real>& xnu, Real Tmin, Real Tmax, int npts_in)
+{
+    BL_PROFILE("PlanckTable::init()");
+
+    AMREX_ALWAYS_ASSERT(npts_in >= 2 && Tmin > 0.0 && Tmax > Tmin);
+
+    ngroups = xnu.size() - 1;
+    npts = npts_in;
+    lnTlo = std::log(Tmin);
+    dlnT = (std::log(Tmax) - lnTlo) / static_cast<Real>(npts - 1);
+
+    lnB.resize(ngroups * npts);
+    dlnB.resize(ngroups * npts);
+
+    for (int i = 0; i < npts; ++i) {
+
+        const Real T = std::exp(lnTlo + i * dlnT);
+
+        // Integrate upward from zero frequency, as in the direct evaluation.
+
+        Real B1, dBdT1;
+        BdBdTIndefInteg(T, 0.0_rt, B1, dBdT1);
+
+        for (int g = 0; g < ngroups; ++g) {
+
+            Real xnup = xnu[g+1];
+            if (g == ngroups - 1) {
+                xnup = amrex::max(xnup, 1.e25_rt);
+            }
+
+            const Real B0 = B1;
+            const Real dBdT0 = dBdT1;
+            BdBdTIndefInteg(T, xnup, B1, dBdT1);
+
+            const Real B = B1 - B0;
+            const Real dBdT = dBdT1 - dBdT0;
+
+            // A group far out in the Wien tail can come out as zero (or
+            // as roundoff); treat it as negligible.
+
+            if (B > 1.e-300_rt) {
+                lnB[g * npts + i] = std::log(B);
+                dlnB[g * npts + i] = T * dBdT / B;
+            } else {
+                lnB[g * npts + i] = std::log(1.e-300_rt);
+                dlnB[g * npts + i] = 0.0;
+            }
+        }
+    }
+}
+
+PlanckTable::View
+PlanckTable::view () const
+{
+    View v;
+    v.lnB = lnB.dataPtr();
+    v.dlnB = dlnB.dataPtr();
+    v.ngroups = ngroups;
+    v.npts = npts;
+    v.lnTlo = lnTlo;
+    v.dlnT = dlnT;
+    return v;
+}
+
+void
+OpacityTable::build (const MultiFab& rho, const MultiFab& temp, int ngrow,
+                     const Vector<Real>& nugroup, int nrho_in, int nT_in, Real T_margin)
+{
+    BL_PROFILE("OpacityTable::build()");
+
+    AMREX_ALWAYS_ASSERT(nrho_in >= 2 && nT_in >= 2 && T_margin >= 1.0);
+
+    ReduceOps<ReduceOpMin, ReduceOpMax, ReduceOpMin, ReduceOpMax> reduce_op;
+    ReduceData<Real, Real, Real, Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(rho, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.growntilebox(ngrow);
+
+        const auto r = rho[mfi].array();
+        const auto t = temp[mfi].array();
+
+        reduce_op.eval(bx, reduce_data,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
+        {
+            return {r(i,j,k), r(i,j,k), t(i,j,k), t(i,j,k)};
+        });
+    }
+
+    ReduceTuple hv = reduce_data.value();
+
+    Real lo[2] = {amrex::get<0>(hv), amrex::get<2>(hv)};
+    Real hi[2] = {amrex::get<1>(hv), amrex::get<3>(hv)};
+
+    ParallelDescriptor::ReduceRealMin(lo, 2);
+    ParallelDescriptor::ReduceRealMax(hi, 2);
+
+    if (!(lo[0] > 0.0 && lo[1] > 0.0)) {
+        // Nothing sensible to tabulate; fall back to direct evaluation.
+        clear();
+        return;
+    }
+
+    nrho = nrho_in;
+    nT = nT_in;
+
+    // Pad the ranges a little so that a uniform density or temperature
+    // still gives a table of finite size.
+
+    lnrlo = std::log(lo[0]) - 1.e-6_rt;
+    dlnr = (std::log(hi[0]) + 1.e-6_rt - lnrlo) / static_cast<Real>(nrho - 1);
+
+    lnTlo = std::log(lo[1] / T_margin) - 1.e-6_rt;
+    dlnT = (std::log(hi[1] * T_margin) + 1.e-6_rt - lnTlo) / static_cast<Real>(nT - 1);
+
+    const int ngroups = nugroup.size();
+
+    kp.resize(ngroups * nT * nrho);
+    kr.resize(ngroups * nT * nrho);
+
+    GpuArray<Real, NGROUPS> nugroup_loc;
+    for (int g = 0; g < NGROUPS; ++g) {
+        nugroup_loc[g] = nugroup[g];
+    }
+
+    Real* const kp_ptr = kp.dataPtr();
+    Real* const kr_ptr = kr.dataPtr();
+
+    const int nr = nrho;
+    const int nt = nT;
+    const Real rlo = lnrlo;
+    const Real dr = dlnr;
+    const Real tlo = lnTlo;
+    const Real dt = dlnT;
+
+    amrex::ParallelFor(ngroups * nt * nr,
+    [=] AMREX_GPU_HOST_DEVICE (int n) noexcept
+    {
+        const int i = n % nr;
+        const int j = (n / nr) % nt;
+        const int g = n / (nr * nt);
+
+        const Real r = std::exp(rlo + i * dr);
+        const Real t = std::exp(tlo + j * dt);
+
+        const Real Ye = 0.e0_rt;
+        const bool comp_kp = true;
+        const bool comp_kr = true;
+
+        opacity(kp_ptr[n], kr_ptr[n], r, t, Ye, nugroup_loc[g], comp_kp, comp_kr);
+    });
+
+    Gpu::synchronize();
+}
+
+void
+OpacityTable::clear ()
+{
+    nrho = 0;
+    nT = 0;
+    kp.clear();
+    kr.clear();
+}
+
+OpacityTable::View
+OpacityTable::view () const
+{
+    View v;
+    v.kp = kp.dataPtr();
+    v.kr = kr.dataPtr();
+    v.nrho = nrho;
+    v.nT = nT;
+    v.lnrlo = lnrlo;
+    v.dlnr = dlnr;
+    v.lnTlo = lnTlo;
+    v.dlnT = dlnT;
+    return v;
+}
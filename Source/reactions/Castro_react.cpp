@@ -1,6 +1,7 @@
 
 #include <Castro.H>
 #include <Castro_F.H>
+#include <telemetry.H>
 
 using std::string;
 using namespace amrex;
@@ -11,6 +12,7 @@ bool
 Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
 {
     BL_PROFILE("Castro::react_state()");
+    telemetry::ScopedTimer telemetry_timer(level, telemetry::burn);
 
     // Sanity check: should only be in here if we're doing CTU.
 
@@ -62,8 +64,11 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
         amrex::Print() << "... Entering burner and doing half-timestep of burning." << std::endl << std::endl;
     }
 
-    ReduceOps<ReduceOpSum> reduce_op;
-    ReduceData<Real> reduce_data(reduce_op);
+    // Reduce the burn failures, and for the telemetry the number of
+    // valid zones burned and their RHS evaluations.
+
+    ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_op;
+    ReduceData<Real, Real, Real> reduce_data(reduce_op);
     using ReduceTuple = typename decltype(reduce_data)::Type;
 
 #ifdef _OPENMP
@@ -73,6 +78,7 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
     {
 
         const Box& bx = mfi.growntilebox(ng);
+        const Box& vbx = mfi.tilebox();
 
         auto U = s.array(mfi);
         auto reactions = r.array(mfi);
@@ -127,8 +133,16 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
                     do_burn = false;
                 }
 
+                Real burned = 0.0_rt;
+                Real n_rhs = 0.0_rt;
+
                 if (do_burn) {
                     burner(burn_state, dt);
+
+                    if (vbx.contains(IntVect(AMREX_D_DECL(i,j,k)))) {
+                        burned = 1.0_rt;
+                        n_rhs = static_cast<Real>(burn_state.n_rhs);
+                    }
                 }
 
                 // If we were unsuccessful, update the failure count.
@@ -169,7 +183,7 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
 
                 }
 
-                return {burn_failed};
+                return {burn_failed, burned, n_rhs};
 
             });
 
@@ -199,6 +213,9 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
     ReduceTuple hv = reduce_data.value();
     Real burn_failed = amrex::get<0>(hv);
 
+    telemetry::add_count(level, telemetry::burn_zones, amrex::get<1>(hv));
+    telemetry::add_count(level, telemetry::burn_rhs, amrex::get<2>(hv));
+
     if (burn_failed != 0.0) {
       burn_success = 0;
     }
@@ -261,6 +278,7 @@ Castro::react_state(Real time, Real dt)
     // S_new with the combined effects of advection and reactions.
 
     BL_PROFILE("Castro::react_state()");
+    telemetry::ScopedTimer telemetry_timer(level, telemetry::burn);
 
     // Sanity check: should only be in here if we're doing simplified SDC.
 
@@ -296,8 +314,11 @@ Castro::react_state(Real time, Real dt)
 
     int burn_success = 1;
 
-    ReduceOps<ReduceOpSum> reduce_op;
-    ReduceData<Real> reduce_data(reduce_op);
+    // Reduce the burn failures, and for the telemetry the number of
+    // valid zones burned and their RHS evaluations.
+
+    ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_op;
+    ReduceData<Real, Real, Real> reduce_data(reduce_op);
 
     using ReduceTuple = typename decltype(reduce_data)::Type;
 
@@ -305,7 +326,7 @@ Castro::react_state(Real time, Real dt)
     {
 
         const Box& bx = mfi.growntilebox(ng);
-
+        const Box& vbx = mfi.tilebox();
 
         auto U_old = S_old.array(mfi);
         auto U_new = S_new.array(mfi);
@@ -392,8 +413,16 @@ Castro::react_state(Real time, Real dt)
              burn_state.sdc_iter = sdc_iteration;
              burn_state.num_sdc_iters = sdc_iters;
 
+             Real burned = 0.0_rt;
+             Real n_rhs = 0.0_rt;
+
              if (do_burn) {
                  burner(burn_state, dt);
+
+                 if (vbx.contains(IntVect(AMREX_D_DECL(i,j,k)))) {
+                     burned = 1.0_rt;
+                     n_rhs = static_cast<Real>(burn_state.n_rhs);
+                 }
              }
 
              // If we were unsuccessful, update the failure count.
@@ -434,7 +463,7 @@ Castro::react_state(Real time, Real dt)
              }
 
 
-             return {burn_failed};
+             return {burn_failed, burned, n_rhs};
         });
 
     }
@@ -442,6 +471,9 @@ Castro::react_state(Real time, Real dt)
     ReduceTuple hv = reduce_data.value();
     Real burn_failed = amrex::get<0>(hv);
 
+    telemetry::add_count(level, telemetry::burn_zones, amrex::get<1>(hv));
+    telemetry::add_count(level, telemetry::burn_rhs, amrex::get<2>(hv));
+
     if (burn_failed != 0.0) burn_success = 0;
 
     ParallelDescriptor::ReduceIntMin(burn_success);
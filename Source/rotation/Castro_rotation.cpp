@@ -1,6 +1,7 @@
 #include <Castro.H>
 #include <Castro_F.H>
 #include <Castro_util.H>
+#include <Rotation.H>
 
 using namespace amrex;
 
@@ -26,9 +27,7 @@ Castro::construct_old_rotation_source(MultiFab& source, MultiFab& state_in, Real
 
     fill_rotation_field(phirot_old, state_in, time);
 
-    const Real *dx = geom.CellSize();
-    const int* domlo = geom.Domain().loVect();
-    const int* domhi = geom.Domain().hiVect();
+    const bool use_cache = update_rotation_cache();
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -37,7 +36,12 @@ Castro::construct_old_rotation_source(MultiFab& source, MultiFab& state_in, Real
     {
         const Box& bx = mfi.tilebox();
 
-        rsrc(bx, state_in.array(mfi), source.array(mfi), dt);
+        Array4<Real const> rot_geom;
+        if (use_cache) {
+            rot_geom = rot_cache.const_array(mfi);
+        }
+
+        rsrc(bx, state_in.array(mfi), source.array(mfi), rot_geom, use_cache, dt);
 
     }
 
@@ -86,9 +90,7 @@ Castro::construct_new_rotation_source(MultiFab& source, MultiFab& state_old, Mul
 
     // Now do corrector part of rotation source term update
 
-    const Real *dx = geom.CellSize();
-    const int* domlo = geom.Domain().loVect();
-    const int* domhi = geom.Domain().hiVect();
+    const bool use_cache = update_rotation_cache();
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -98,11 +100,17 @@ Castro::construct_new_rotation_source(MultiFab& source, MultiFab& state_old, Mul
         {
             const Box& bx = mfi.tilebox();
 
+            Array4<Real const> rot_geom;
+            if (use_cache) {
+                rot_geom = rot_cache.const_array(mfi);
+            }
+
             corrrsrc(bx,
                      phirot_old.array(mfi), phirot_new.array(mfi),
                      state_old.array(mfi), state_new.array(mfi),
                      source.array(mfi),
                      (*mass_fluxes[0]).array(mfi), (*mass_fluxes[1]).array(mfi), (*mass_fluxes[2]).array(mfi),
+                     rot_geom, use_cache,
                      dt, volume.array(mfi));
         }
     }
@@ -132,11 +140,23 @@ void Castro::fill_rotation_field(MultiFab& phi, MultiFab& state_in, Real time)
 
     BL_PROFILE("Castro::fill_rotation_field()");
 
-    const Real* dx = geom.CellSize();
+    int ng = phi.nGrow();
+
+    // The rotational potential depends only on the geometry (for a
+    // given rotation frequency), so use the cached copy if we can.
 
-    phi.setVal(0.0);
+    if (update_rotation_cache() &&
+        phi.boxArray() == rot_cache.boxArray() &&
+        phi.DistributionMap() == rot_cache.DistributionMap() &&
+        ng <= rot_cache.nGrow()) {
 
-    int ng = phi.nGrow();
+        MultiFab::Copy(phi, rot_cache, ROT_CACHE_PHI, 0, 1, ng);
+
+        return;
+
+    }
+
+    phi.setVal(0.0);
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -151,3 +171,106 @@ void Castro::fill_rotation_field(MultiFab& phi, MultiFab& state_in, Real time)
     }
 
 }
+
+
+
+bool
+Castro::update_rotation_cache()
+{
+
+    if (rotation_use_cache != 1 || do_rotation != 1) {
+        return false;
+    }
+
+    // The cached data depends on the rotation frequency, the location
+    // of the center, and which terms are included in the potential.
+
+    auto omega = get_omega();
+
+    Vector<Real> key = {omega[0], omega[1], omega[2],
+                        problem::center[0], problem::center[1], problem::center[2],
+                        static_cast<Real>(rotation_include_centrifugal),
+                        static_cast<Real>(state_in_rotating_frame)};
+
+    const int ng = get_new_data(PhiRot_Type).nGrow();
+
+    if (rot_cache.ok() &&
+        rot_cache.boxArray() == grids &&
+        rot_cache.DistributionMap() == dmap &&
+        rot_cache.nGrow() >= ng &&
+        rot_cache_key == key) {
+
+        return true;
+
+    }
+
+    BL_PROFILE("Castro::update_rotation_cache()");
+
+    rot_cache.define(grids, dmap, ROT_CACHE_NCOMP, ng);
+    rot_cache_key = key;
+
+    GeometryData geomdata = geom.data();
+
+    auto problo = geom.ProbLoArray();
+
+    auto dx = geom.CellSizeArray();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(rot_cache, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+
+        const Box& bx = mfi.growntilebox(ng);
+
+        auto rg = rot_cache.array(mfi);
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+        {
+
+            // The position is computed the same way as in the
+            // rotation sources, so that using the cache does
+            // not change the answer.
+
+            GpuArray<Real, 3> loc;
+            position(i, j, k, geomdata, loc);
+
+            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                loc[dir] -= problem::center[dir];
+            }
+
+            GpuArray<Real, 3> omega_cross_r;
+            cross_product(omega, loc, omega_cross_r);
+
+            for (int dir = 0; dir < 3; ++dir) {
+                rg(i,j,k,ROT_CACHE_R+dir) = loc[dir];
+                rg(i,j,k,ROT_CACHE_WXR+dir) = omega_cross_r[dir];
+            }
+
+            // The potential is computed as in fill_rotational_potential
+            // (which does not wrap periodic ghost zones).
+
+            GpuArray<Real, 3> r;
+
+            r[0] = problo[0] + dx[0] * (static_cast<Real>(i) + 0.5_rt) - problem::center[0];
+#if AMREX_SPACEDIM >= 2
+            r[1] = problo[1] + dx[1] * (static_cast<Real>(j) + 0.5_rt) - problem::center[1];
+#else
+            r[1] = 0.0_rt;
+#endif
+#if AMREX_SPACEDIM == 3
+            r[2] = problo[2] + dx[2] * (static_cast<Real>(k) + 0.5_rt) - problem::center[2];
+#else
+            r[2] = 0.0_rt;
+#endif
+
+            rg(i,j,k,ROT_CACHE_PHI) = rotational_potential(r);
+
+        });
+
+    }
+
+    return true;
+
+}
@@ -9,7 +9,9 @@
 void
 Castro::rsrc(const Box& bx,
              Array4<Real const> const& uold,
-             Array4<Real> const& source, 
+             Array4<Real> const& source,
+             Array4<Real const> const& rot_geom,
+             const bool use_cache,
              const Real dt) {
 
   GeometryData geomdata = geom.data();
@@ -26,10 +28,17 @@ Castro::rsrc(const Box& bx,
     Real snew[NUM_STATE] = {};
 
     GpuArray<Real, 3> loc;
-    position(i, j, k, geomdata, loc);
 
-    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
-      loc[dir] -= problem::center[dir];
+    if (use_cache) {
+      for (int dir = 0; dir < 3; ++dir) {
+        loc[dir] = rot_geom(i,j,k,ROT_CACHE_R+dir);
+      }
+    } else {
+      position(i, j, k, geomdata, loc);
+
+      for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        loc[dir] -= problem::center[dir];
+      }
     }
 
     Real rho = uold(i,j,k,URHO);
@@ -147,6 +156,8 @@ Castro::corrrsrc(const Box& bx,
                  Array4<Real const> const& flux0,
                  Array4<Real const> const& flux1,
                  Array4<Real const> const& flux2,
+                 Array4<Real const> const& rot_geom,
+                 const bool use_cache,
                  const Real dt,
                  Array4<Real const> const& vol) {
 
@@ -255,10 +266,17 @@ Castro::corrrsrc(const Box& bx,
     Real snew[NUM_STATE] = {};
 
     GpuArray<Real, 3> loc;
-    position(i, j, k, geomdata, loc);
 
-    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
-      loc[dir] -= problem::center[dir];
+    if (use_cache) {
+      for (int dir = 0; dir < 3; ++dir) {
+        loc[dir] = rot_geom(i,j,k,ROT_CACHE_R+dir);
+      }
+    } else {
+      position(i, j, k, geomdata, loc);
+
+      for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        loc[dir] -= problem::center[dir];
+      }
     }
 
     Real rhoo = uold(i,j,k,URHO);
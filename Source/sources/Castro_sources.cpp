@@ -1,5 +1,6 @@
 #include <Castro.H>
 #include <Castro_F.H>
+#include <telemetry.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -105,6 +106,7 @@ Castro::do_old_sources(
 {
 
     BL_PROFILE("Castro::do_old_sources()");
+    telemetry::ScopedTimer telemetry_timer(level, telemetry::sources);
 
     const Real strt_time = ParallelDescriptor::second();
 
@@ -199,6 +201,7 @@ Castro::do_new_sources(
 {
 
     BL_PROFILE("Castro::do_new_sources()");
+    telemetry::ScopedTimer telemetry_timer(level, telemetry::sources);
 
     const Real strt_time = ParallelDescriptor::second();
 
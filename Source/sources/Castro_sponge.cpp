@@ -8,6 +8,28 @@
 
 using namespace amrex;
 
+// The radial sponge factor: lower_factor inside the lower radius,
+// upper_factor outside the upper radius, and a cosine ramp in between.
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real
+radial_sponge_factor(const Real rad,
+                     const Real lower_radius, const Real upper_radius,
+                     const Real lower_factor, const Real upper_factor)
+{
+    if (rad < lower_radius) {
+        return lower_factor;
+
+    } else if (rad >= lower_radius && rad <= upper_radius) {
+        return lower_factor +
+            0.5_rt * (upper_factor - lower_factor) *
+            (1.0_rt - std::cos(M_PI * (rad - lower_radius) / (upper_radius - lower_radius)));
+
+    } else {
+        return upper_factor;
+    }
+}
+
 void
 Castro::construct_old_sponge_source(MultiFab& source, MultiFab& state_in, Real time, Real dt)
 {
@@ -16,9 +38,14 @@ Castro::construct_old_sponge_source(MultiFab& source, MultiFab& state_in, Real t
     if (!do_sponge) return;
 
     update_sponge_params(&time);
+    get_sponge_params();
 
     const Real mult_factor = 1.0;
 
+    const bool use_cache = update_sponge_cache() &&
+                           state_in.boxArray() == sponge_cache.boxArray() &&
+                           state_in.DistributionMap() == sponge_cache.DistributionMap();
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -26,7 +53,15 @@ Castro::construct_old_sponge_source(MultiFab& source, MultiFab& state_in, Real t
     {
         const Box& bx = mfi.tilebox();
 
-        apply_sponge(bx, state_in.array(mfi), source.array(mfi), dt, mult_factor);
+        Array4<Real const> sponge_fac;
+        if (use_cache) {
+            if (sponge_tile_active[mfi.LocalTileIndex()] == 0) {
+                continue;
+            }
+            sponge_fac = sponge_cache.const_array(mfi);
+        }
+
+        apply_sponge(bx, state_in.array(mfi), source.array(mfi), sponge_fac, use_cache, dt, mult_factor);
 
     }
 
@@ -63,6 +98,10 @@ Castro::construct_new_sponge_source(MultiFab& source, MultiFab& state_old, Multi
     // Note that the sponge parameters are still current
     // at this point from their evaluation at the old time.
 
+    bool use_cache = update_sponge_cache() &&
+                     state_old.boxArray() == sponge_cache.boxArray() &&
+                     state_old.DistributionMap() == sponge_cache.DistributionMap();
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -70,13 +109,27 @@ Castro::construct_new_sponge_source(MultiFab& source, MultiFab& state_old, Multi
     {
         const Box& bx = mfi.tilebox();
 
-        apply_sponge(bx, state_old.array(mfi), source.array(mfi), dt, mult_factor_old);
+        Array4<Real const> sponge_fac;
+        if (use_cache) {
+            if (sponge_tile_active[mfi.LocalTileIndex()] == 0) {
+                continue;
+            }
+            sponge_fac = sponge_cache.const_array(mfi);
+        }
+
+        apply_sponge(bx, state_old.array(mfi), source.array(mfi), sponge_fac, use_cache, dt, mult_factor_old);
     }
 
     // Now update to the new-time sponge parameter values
     // and then evaluate the new-time part of the corrector.
+    // The cache is only rebuilt if the parameters actually changed.
 
     update_sponge_params(&time);
+    get_sponge_params();
+
+    use_cache = update_sponge_cache() &&
+                state_new.boxArray() == sponge_cache.boxArray() &&
+                state_new.DistributionMap() == sponge_cache.DistributionMap();
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -85,7 +138,15 @@ Castro::construct_new_sponge_source(MultiFab& source, MultiFab& state_old, Multi
     {
         const Box& bx = mfi.tilebox();
 
-        apply_sponge(bx, state_new.array(mfi), source.array(mfi), dt, mult_factor_new);
+        Array4<Real const> sponge_fac;
+        if (use_cache) {
+            if (sponge_tile_active[mfi.LocalTileIndex()] == 0) {
+                continue;
+            }
+            sponge_fac = sponge_cache.const_array(mfi);
+        }
+
+        apply_sponge(bx, state_new.array(mfi), source.array(mfi), sponge_fac, use_cache, dt, mult_factor_new);
 
     }
 
@@ -120,10 +181,155 @@ Castro::sponge_finalize()
     ca_deallocate_sponge_params();
 }
 
+void
+Castro::get_sponge_params()
+{
+    ca_get_sponge_params(sponge_lower_factor, sponge_upper_factor,
+                         sponge_lower_radius, sponge_upper_radius,
+                         sponge_lower_density, sponge_upper_density,
+                         sponge_lower_pressure, sponge_upper_pressure,
+                         sponge_target_velocity, sponge_timescale);
+}
+
+bool
+Castro::update_sponge_cache()
+{
+
+    if (sponge_use_cache != 1 || do_sponge != 1) {
+        return false;
+    }
+
+    // The density and pressure sponges override the radial sponge
+    // and depend on the state, so there is nothing to precompute.
+
+    if ((sponge_upper_density > 0.0_rt && sponge_lower_density > 0.0_rt) ||
+        (sponge_upper_pressure > 0.0_rt && sponge_lower_pressure >= 0.0_rt)) {
+        return false;
+    }
+
+    Vector<Real> key = {sponge_lower_radius, sponge_upper_radius,
+                        sponge_lower_factor, sponge_upper_factor,
+                        problem::center[0], problem::center[1], problem::center[2]};
+
+    if (sponge_cache.ok() &&
+        sponge_cache.boxArray() == grids &&
+        sponge_cache.DistributionMap() == dmap &&
+        sponge_cache_key == key) {
+
+        return true;
+
+    }
+
+    BL_PROFILE("Castro::update_sponge_cache()");
+
+    sponge_cache.define(grids, dmap, 1, 0);
+    sponge_cache_key = key;
+
+    const Real lower_radius = sponge_lower_radius;
+    const Real upper_radius = sponge_upper_radius;
+    const Real lower_factor = sponge_lower_factor;
+    const Real upper_factor = sponge_upper_factor;
+
+    const bool radial = lower_radius >= 0.0_rt && upper_radius > lower_radius;
+
+    auto dx = geom.CellSizeArray();
+    auto problo = geom.ProbLoArray();
+
+    // First find the tiles with a nonzero sponge factor somewhere.
+    // The zone centers of a tile span a rectangle, so we only need
+    // the distance to its nearest and farthest points (computed the
+    // same way as the zone radius in apply_sponge).
+
+    sponge_tile_active.clear();
+
+    for (MFIter mfi(sponge_cache, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+        GpuArray<Real, 3> rlo = {0.0_rt};
+        GpuArray<Real, 3> rhi = {0.0_rt};
+
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            const Real a = problo[dir] + (static_cast<Real>(bx.smallEnd(dir)) + 0.5_rt) * dx[dir] - problem::center[dir];
+            const Real b = problo[dir] + (static_cast<Real>(bx.bigEnd(dir)) + 0.5_rt) * dx[dir] - problem::center[dir];
+
+            rlo[dir] = (a <= 0.0_rt && b >= 0.0_rt) ? 0.0_rt : amrex::min(std::abs(a), std::abs(b));
+            rhi[dir] = amrex::max(std::abs(a), std::abs(b));
+        }
+
+        const Real rmin = std::sqrt(rlo[0]*rlo[0] + rlo[1]*rlo[1] + rlo[2]*rlo[2]);
+        const Real rmax = std::sqrt(rhi[0]*rhi[0] + rhi[1]*rhi[1] + rhi[2]*rhi[2]);
+
+        int active;
+
+        if (!radial) {
+            active = 0;
+        } else if (rmax < lower_radius) {
+            active = lower_factor != 0.0_rt;
+        } else if (rmin > upper_radius) {
+            active = upper_factor != 0.0_rt;
+        } else {
+            active = 1;
+        }
+
+        const int t = mfi.LocalTileIndex();
+
+        if (t >= static_cast<int>(sponge_tile_active.size())) {
+            sponge_tile_active.resize(t + 1, 1);
+        }
+
+        sponge_tile_active[t] = active;
+    }
+
+    // Now fill in the sponge factor on the active tiles.
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(sponge_cache, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        if (sponge_tile_active[mfi.LocalTileIndex()] == 0) {
+            continue;
+        }
+
+        const Box& bx = mfi.tilebox();
+
+        auto fac = sponge_cache.array(mfi);
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+        {
+            GpuArray<Real, 3> r;
+
+            r[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0];
+#if AMREX_SPACEDIM >= 2
+            r[1] = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - problem::center[1];
+#else
+            r[1] = 0.0_rt;
+#endif
+#if AMREX_SPACEDIM == 3
+            r[2] = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - problem::center[2];
+#else
+            r[2] = 0.0_rt;
+#endif
+
+            Real rad = std::sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
+
+            fac(i,j,k) = radial_sponge_factor(rad, lower_radius, upper_radius,
+                                              lower_factor, upper_factor);
+        });
+    }
+
+    return true;
+
+}
+
 void
 Castro::apply_sponge(const Box& bx,
                      Array4<Real const> const state_in,
                      Array4<Real> const source,
+                     Array4<Real const> const sponge_fac,
+                     const bool use_cache,
                      Real dt, Real mult_factor) {
 
   // alpha is a dimensionless measure of the timestep size; if
@@ -162,12 +368,6 @@ Castro::apply_sponge(const Box& bx,
   [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
   {
 
-    Real src[NSRC];
-
-    for (int n = 0; n < NSRC; n++) {
-      src[n] = 0.0;
-    }
-
     GpuArray<Real, 3> r;
 
     r[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0];
@@ -189,9 +389,6 @@ Castro::apply_sponge(const Box& bx,
 
     // compute the update factor
 
-    // Radial distance between upper and lower boundaries.
-    Real delta_r = lsponge_upper_radius - lsponge_lower_radius;
-
     // Density difference between upper and lower cutoffs.
     Real delta_rho = lsponge_lower_density - lsponge_upper_density;
 
@@ -203,20 +400,14 @@ Castro::apply_sponge(const Box& bx,
     // so this sponge is applied only if set by the user.
     Real sponge_factor = 0.0_rt;
 
-    if (lsponge_lower_radius >= 0.0_rt && lsponge_upper_radius > lsponge_lower_radius) {
-      Real rad = std::sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
-
-      if (rad < lsponge_lower_radius) {
-        sponge_factor = lsponge_lower_factor;
+    if (use_cache) {
+      sponge_factor = sponge_fac(i,j,k);
 
-      } else if (rad >= lsponge_lower_radius && rad <= lsponge_upper_radius) {
-        sponge_factor = lsponge_lower_factor +
-          0.5_rt * (lsponge_upper_factor - lsponge_lower_factor) *
-          (1.0_rt - std::cos(M_PI * (rad - lsponge_lower_radius) / delta_r));
+    } else if (lsponge_lower_radius >= 0.0_rt && lsponge_upper_radius > lsponge_lower_radius) {
+      Real rad = std::sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
 
-      } else {
-        sponge_factor = lsponge_upper_factor;
-      }
+      sponge_factor = radial_sponge_factor(rad, lsponge_lower_radius, lsponge_upper_radius,
+                                           lsponge_lower_factor, lsponge_upper_factor);
     }
 
     // Apply density sponge. This sponge is applied only if set by the user.
@@ -276,6 +467,12 @@ Castro::apply_sponge(const Box& bx,
       }
     }
 
+    // Nothing to add where the sponge is off.
+
+    if (sponge_factor == 0.0_rt) {
+      return;
+    }
+
     // For an explicit update (sponge_implicit /= 1), the source term is given by
     // -(rho v) * alpha * sponge_factor. We simply add this directly by using the
     // current value of the momentum.
@@ -301,7 +498,6 @@ Castro::apply_sponge(const Box& bx,
     GpuArray<Real, 3> Sr;
     for (int n = 0; n < 3; n++) {
       Sr[n] = (state_in(i,j,k,UMX+n) - rho * lsponge_target_velocity[n]) * fac * mult_factor / dt;
-      src[UMX+n] = Sr[n];
     }
 
     // Kinetic energy is 1/2 rho u**2, or (rho u)**2 / (2 rho). This means
@@ -314,21 +510,23 @@ Castro::apply_sponge(const Box& bx,
       SrE += state_in(i,j,k,UMX+n) * rhoInv * Sr[n];
     }
 
-    src[UEDEN] = SrE;
+    // Add terms to the source array (the sponge only touches
+    // the momenta and the total energy).
+
+    for (int n = 0; n < 3; n++) {
+      source(i,j,k,UMX+n) += Sr[n];
+    }
+
+    source(i,j,k,UEDEN) += SrE;
 
 #ifdef HYBRID_MOMENTUM
     GpuArray<Real, 3> Sr_hybrid;
     set_hybrid_momentum_source(r, Sr, Sr_hybrid);
     for (int n = 0; n < 3; n++) {
-      src[UMR+n] = Sr_hybrid[n];
+      source(i,j,k,UMR+n) += Sr_hybrid[n];
     }
 #endif
 
-    // Add terms to the source array.
-    for (int n = 0; n < NSRC; n++) {
-      source(i,j,k,n) += src[n];
-    }
-
   });
 }
 
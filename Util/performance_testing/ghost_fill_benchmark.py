@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+
+"""Compare the time per step spent filling the ghost zones of the MHD
+face-centered magnetic field between two revisions of Castro.
+
+Each revision is checked out into a git worktree, BrioWu (3-d MHD) is
+built there with TINY_PROFILE=TRUE, and inputs.ghost_fill.bench is run
+with the same number of ranks and threads.  That setup has physical
+boundaries on every side and small grids, so most of the FillPatch work
+on B is boundary filling.  From the TinyProfiler report we print the
+inclusive time per step (the maximum over ranks) of the regions that do
+the fills:
+
+  StateData::FillBoundary         the physical boundary fills of all
+                                  state types (present in both versions)
+  face_fill()                     the C++ face-centered fill (only after
+                                  the port of filfc)
+  FillPatchIterator::Initialize   all of FillPatch
+  Castro::advance()               the whole advance, for reference
+
+The first step (and the initialization) are part of the profile, so
+use enough steps that they do not matter.
+
+usage:
+
+  ghost_fill_benchmark.py --before <rev> --after HEAD
+  ghost_fill_benchmark.py --before <rev> --after HEAD --nprocs 1 --nthreads 8
+
+AMReX and Microphysics are taken from the checkout this script is in
+(or --amrex-home / --microphysics-home), since the worktrees do not
+have the submodules.
+"""
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+
+
+SUITE_DIR = os.path.dirname(os.path.abspath(__file__))
+CASTRO_HOME = os.path.normpath(os.path.join(SUITE_DIR, "..", ".."))
+
+PROBLEM_DIR = os.path.join("Exec", "mhd_tests", "BrioWu")
+INPUT_FILE = "inputs.ghost_fill.bench"
+PROBIN_FILE = "probin.briowu.test"
+
+REGIONS = ["StateData::FillBoundary",
+           "face_fill()",
+           "FillPatchIterator::Initialize",
+           "Castro::advance()"]
+
+
+def checkout(rev, work_dir):
+    """Check out rev into a worktree under work_dir and return its path."""
+
+    sha = subprocess.check_output(["git", "rev-parse", "--short", rev],
+                                  cwd=CASTRO_HOME).decode().strip()
+
+    tree = os.path.join(work_dir, "castro-{}".format(sha))
+    if not os.path.isdir(tree):
+        subprocess.check_call(["git", "worktree", "add", "--detach", tree, sha],
+                              cwd=CASTRO_HOME)
+
+    return sha, tree
+
+
+def build(tree, args):
+    """Build BrioWu in tree and return the path of the executable."""
+
+    build_dir = os.path.join(tree, PROBLEM_DIR)
+
+    cmd = ["make", "-j{}".format(args.make_jobs),
+           "DIM=3", "COMP={}".format(args.comp),
+           "DEBUG=FALSE", "TINY_PROFILE=TRUE",
+           "USE_MPI=TRUE",
+           "USE_OMP={}".format("TRUE" if args.nthreads > 1 else "FALSE"),
+           "CASTRO_HOME={}".format(tree),
+           "AMREX_HOME={}".format(args.amrex_home),
+           "MICROPHYSICS_HOME={}".format(args.microphysics_home)]
+
+    print("  building in {}".format(build_dir))
+    with open(os.path.join(build_dir, "ghost_fill.make.out"), "w") as log:
+        if subprocess.call(cmd, cwd=build_dir, stdout=log, stderr=subprocess.STDOUT) != 0:
+            sys.exit("build failed; see {}".format(log.name))
+
+    exes = [f for f in os.listdir(build_dir) if f.startswith("Castro3d") and f.endswith(".ex")]
+    if not exes:
+        sys.exit("no executable in {}".format(build_dir))
+
+    return os.path.join(build_dir, max(exes, key=lambda f: os.path.getmtime(os.path.join(build_dir, f))))
+
+
+def run(exe, run_dir, args):
+    """Run the benchmark and return the TinyProfiler report."""
+
+    if os.path.isdir(run_dir):
+        shutil.rmtree(run_dir)
+    os.makedirs(run_dir)
+
+    # the inputs come from this checkout, so both versions run the same problem
+
+    for f in [INPUT_FILE, PROBIN_FILE]:
+        shutil.copy(os.path.join(CASTRO_HOME, PROBLEM_DIR, f), run_dir)
+
+    cmd = args.mpiexec.replace("@nprocs@", str(args.nprocs)).split()
+    cmd += [exe, INPUT_FILE, "max_step={}".format(args.steps)]
+
+    env = dict(os.environ)
+    env["OMP_NUM_THREADS"] = str(args.nthreads)
+
+    out = os.path.join(run_dir, "run.out")
+    with open(out, "w") as log:
+        if subprocess.call(cmd, cwd=run_dir, env=env, stdout=log, stderr=subprocess.STDOUT) != 0:
+            sys.exit("run failed; see {}".format(out))
+
+    with open(out) as f:
+        return f.read()
+
+
+def inclusive_times(report):
+    """Return {region: max inclusive time} from a TinyProfiler report."""
+
+    times = {}
+    in_table = False
+
+    for line in report.splitlines():
+        if "Incl. Max" in line:
+            in_table = True
+            continue
+
+        if not in_table:
+            continue
+
+        if not line.strip():
+            if times:
+                break
+            continue
+
+        fields = line.split()
+
+        # name ... ncalls min avg max max%
+        if len(fields) < 6 or not fields[-1].endswith("%"):
+            continue
+
+        name = " ".join(fields[:-5])
+        try:
+            times[name] = float(fields[-2])
+        except ValueError:
+            continue
+
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--before", required=True,
+                        help="revision with the old ghost fills")
+    parser.add_argument("--after", default="HEAD",
+                        help="revision with the new ghost fills (default: HEAD)")
+    parser.add_argument("--steps", type=int, default=20,
+                        help="number of coarse steps to run")
+    parser.add_argument("--nprocs", type=int, default=4,
+                        help="number of MPI ranks")
+    parser.add_argument("--nthreads", type=int, default=1,
+                        help="OpenMP threads per rank (builds with OpenMP if > 1)")
+    parser.add_argument("--comp", default="gnu",
+                        help="compiler")
+    parser.add_argument("--make-jobs", type=int, default=8,
+                        help="parallel make jobs")
+    parser.add_argument("--mpiexec", default="mpiexec -n @nprocs@",
+                        help="MPI launcher; @nprocs@ is replaced by the number of ranks")
+    parser.add_argument("--work-dir", default=os.path.join(os.getcwd(), "ghost_fill_runs"),
+                        help="where to put the worktrees and runs")
+    parser.add_argument("--amrex-home", default=os.path.join(CASTRO_HOME, "external", "amrex"),
+                        help="AMReX to build with")
+    parser.add_argument("--microphysics-home",
+                        default=os.path.join(CASTRO_HOME, "external", "Microphysics"),
+                        help="Microphysics to build with")
+    args = parser.parse_args()
+
+    args.work_dir = os.path.abspath(args.work_dir)
+    if not os.path.isdir(args.work_dir):
+        os.makedirs(args.work_dir)
+
+    results = []
+
+    for label, rev in [("before", args.before), ("after", args.after)]:
+        sha, tree = checkout(rev, args.work_dir)
+        print("{} ({}):".format(label, sha))
+
+        exe = build(tree, args)
+        report = run(exe, os.path.join(args.work_dir, "run-{}".format(sha)), args)
+
+        results.append((label, sha, inclusive_times(report)))
+
+    print("")
+    print("seconds per step ({} steps, {} ranks x {} threads)".format(
+        args.steps, args.nprocs, args.nthreads))
+    print("{:<32} {:>12} {:>12} {:>9}".format("region", "before", "after", "change"))
+
+    for region in REGIONS:
+        t = [r[2].get(region) for r in results]
+        per_step = ["-" if x is None else "{:.4e}".format(x / args.steps) for x in t]
+        change = "-"
+        if t[0] and t[1] is not None:
+            change = "{:+.1%}".format(t[1] / t[0] - 1.0)
+        print("{:<32} {:>12} {:>12} {:>9}".format(region, per_step[0], per_step[1], change))
+
+
+if __name__ == "__main__":
+    main()
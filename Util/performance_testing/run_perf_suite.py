@@ -0,0 +1,306 @@
+#!/usr/bin/env python3
+
+"""Build and run the Castro performance tests and compare their
+throughput against stored baselines.
+
+Each test in perf-tests.ini is a small, fixed-size problem.  It is run
+with castro.telemetry_file set, and the per-step telemetry (see
+Source/driver/telemetry.H) is turned into throughputs in zones per
+second:
+
+  total            zones advanced / step wall time
+  hydro, gravity,  zones advanced / time in that part of the advance
+  sources, fillpatch, reflux
+  burn             valid zones burned / time in the burner
+
+The times are the maximum over ranks, and the first warmupSteps steps
+are left out.  A throughput that is lower than its baseline by more
+than the test's tolerance is a regression.
+
+Baselines depend on the machine, so they are stored per machine in
+baselines/<machine>.json (the machine defaults to the host name).
+Record them with --update on a quiet node.
+
+usage:
+
+  run_perf_suite.py                          # build, run and compare all tests
+  run_perf_suite.py --tests Sedov-3d         # just one test
+  run_perf_suite.py --update                 # record new baselines
+"""
+
+import argparse
+import configparser
+import glob
+import json
+import os
+import shutil
+import socket
+import subprocess
+import sys
+
+
+SUITE_DIR = os.path.dirname(os.path.abspath(__file__))
+CASTRO_HOME = os.path.normpath(os.path.join(SUITE_DIR, "..", ".."))
+
+SUBSYSTEMS = ["hydro", "burn", "gravity", "sources", "fillpatch", "reflux"]
+
+# throughputs measured over less time than this are too noisy to compare
+MIN_TIME = 1.e-2
+
+
+class Test(object):
+    def __init__(self, name, section, main):
+        self.name = name
+
+        def get(key, default=None):
+            return section.get(key, main.get(key, default))
+
+        self.build_dir = os.path.join(CASTRO_HOME, section["buildDir"])
+        self.input_file = section["inputFile"]
+        self.probin_file = section.get("probinFile", "")
+        self.aux_files = section.get("auxFiles", "").split()
+        self.link_files = section.get("linkFiles", "").split()
+        self.dim = int(section["dim"])
+        self.make_vars = section.get("makeVars", "").split()
+        self.numprocs = int(section.get("numprocs", "1"))
+        self.numthreads = int(section.get("numthreads", "1"))
+        self.warmup_steps = int(get("warmupSteps", "0"))
+        self.tolerance = float(get("tolerance", "0.1"))
+        self.runtime_params = (main.get("runtimeParams", "").splitlines() +
+                               section.get("runtimeParams", "").splitlines())
+        self.runtime_params = [p.strip() for p in self.runtime_params if p.strip()]
+
+
+def load_suite(ini_file):
+    """Return the [main] options and the list of tests in ini_file."""
+
+    cp = configparser.ConfigParser()
+    cp.optionxform = str
+    if not cp.read(ini_file):
+        sys.exit("unable to read {}".format(ini_file))
+
+    main = dict(cp["main"]) if cp.has_section("main") else {}
+    tests = [Test(name, cp[name], main) for name in cp.sections() if name != "main"]
+
+    return main, tests
+
+
+def build(test, main, args):
+    """Build the test's executable and return its path."""
+
+    cmd = ["make", "-j{}".format(main.get("numMakeJobs", "1")),
+           "DIM={}".format(test.dim),
+           "COMP={}".format(main.get("COMP", "gnu")),
+           "USE_MPI=TRUE",
+           "USE_OMP={}".format("TRUE" if test.numthreads > 1 else "FALSE"),
+           "CASTRO_HOME={}".format(CASTRO_HOME)] + test.make_vars
+
+    print("  building: {}".format(" ".join(cmd)))
+    with open(os.path.join(args.work_dir, "{}.make.out".format(test.name)), "w") as log:
+        if subprocess.call(cmd, cwd=test.build_dir, stdout=log, stderr=subprocess.STDOUT) != 0:
+            return None
+
+    executables = glob.glob(os.path.join(test.build_dir, "Castro{}d*.ex".format(test.dim)))
+    if not executables:
+        return None
+
+    return max(executables, key=os.path.getmtime)
+
+
+def run(test, exe, args):
+    """Run the test once in a fresh directory and return the path of
+    its telemetry file, or None if the run failed."""
+
+    run_dir = os.path.join(args.work_dir, test.name)
+    if os.path.isdir(run_dir):
+        shutil.rmtree(run_dir)
+    os.makedirs(run_dir)
+
+    for f in [test.input_file, test.probin_file] + test.aux_files:
+        if f:
+            shutil.copy(os.path.join(test.build_dir, f), run_dir)
+
+    for f in test.link_files:
+        src = os.path.join(test.build_dir, f)
+        if os.path.exists(src):
+            os.symlink(os.path.realpath(src), os.path.join(run_dir, f))
+
+    telemetry = os.path.join(run_dir, "telemetry.json")
+
+    cmd = args.mpiexec.replace("@nprocs@", str(test.numprocs)).split()
+    cmd += [exe, test.input_file] + test.runtime_params
+    cmd += ["castro.telemetry_file={}".format(telemetry), "castro.telemetry_format=0"]
+
+    env = dict(os.environ)
+    env["OMP_NUM_THREADS"] = str(test.numthreads)
+
+    with open(os.path.join(run_dir, "run.out"), "w") as log:
+        if subprocess.call(cmd, cwd=run_dir, env=env, stdout=log, stderr=subprocess.STDOUT) != 0:
+            return None
+
+    return telemetry if os.path.isfile(telemetry) else None
+
+
+def throughput(telemetry_file, warmup_steps):
+    """Zones per second, overall and per subsystem, from a telemetry file
+    written with castro.telemetry_format = 0."""
+
+    with open(telemetry_file) as f:
+        records = [json.loads(line) for line in f if line.strip()]
+
+    records = records[warmup_steps:]
+
+    wall = 0.0
+    zones = 0.0
+    burn_zones = 0.0
+    times = dict((s, 0.0) for s in SUBSYSTEMS)
+
+    for r in records:
+        wall += r["wall_max"]
+        for lev in r["levels"]:
+            zones += lev["zones"]
+            burn_zones += lev["burn_zones"]
+            for s in SUBSYSTEMS:
+                times[s] += lev["{}_max".format(s)]
+
+    result = {}
+
+    if wall > MIN_TIME:
+        result["total"] = zones / wall
+
+    for s in SUBSYSTEMS:
+        if times[s] > MIN_TIME:
+            work = burn_zones if s == "burn" else zones
+            result[s] = work / times[s]
+
+    return result
+
+
+def compare(measured, baseline, tolerance):
+    """Return a list of (metric, measured, baseline, change, status)."""
+
+    rows = []
+
+    for metric in sorted(set(measured) | set(baseline)):
+        m = measured.get(metric)
+        b = baseline.get(metric)
+
+        if m is None:
+            rows.append((metric, m, b, None, "missing"))
+        elif b is None:
+            rows.append((metric, m, b, None, "new"))
+        else:
+            change = m / b - 1.0
+            rows.append((metric, m, b, change, "FAIL" if change < -tolerance else "ok"))
+
+    return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--ini", default=os.path.join(SUITE_DIR, "perf-tests.ini"),
+                        help="test suite description")
+    parser.add_argument("--tests", nargs="+", default=None,
+                        help="run only these tests")
+    parser.add_argument("--machine", default=socket.gethostname().split(".")[0],
+                        help="name of the baseline set (default: the host name)")
+    parser.add_argument("--baselines", default=None,
+                        help="baseline file (default: baselines/<machine>.json)")
+    parser.add_argument("--work-dir", default=os.path.join(os.getcwd(), "perf_runs"),
+                        help="where to run the tests")
+    parser.add_argument("--mpiexec", default="mpiexec -n @nprocs@",
+                        help="MPI launcher; @nprocs@ is replaced by the number of ranks")
+    parser.add_argument("--repeat", type=int, default=1,
+                        help="run each test this many times and keep the best throughputs")
+    parser.add_argument("--skip-build", action="store_true",
+                        help="use the newest existing executable in each build directory")
+    parser.add_argument("--update", action="store_true",
+                        help="store the measured throughputs as the new baselines")
+    args = parser.parse_args()
+
+    main_opts, tests = load_suite(args.ini)
+
+    if args.tests:
+        unknown = set(args.tests) - set(t.name for t in tests)
+        if unknown:
+            sys.exit("unknown tests: {}".format(", ".join(sorted(unknown))))
+        tests = [t for t in tests if t.name in args.tests]
+
+    args.work_dir = os.path.abspath(args.work_dir)
+    if not os.path.isdir(args.work_dir):
+        os.makedirs(args.work_dir)
+
+    baseline_file = args.baselines or os.path.join(SUITE_DIR, "baselines",
+                                                   "{}.json".format(args.machine))
+
+    baselines = {}
+    if os.path.isfile(baseline_file):
+        with open(baseline_file) as f:
+            baselines = json.load(f)
+    elif not args.update:
+        print("no baselines in {}; reporting throughputs only".format(baseline_file))
+
+    failed = []
+
+    for test in tests:
+        print("{}:".format(test.name))
+
+        if args.skip_build:
+            exes = glob.glob(os.path.join(test.build_dir, "Castro{}d*.ex".format(test.dim)))
+            exe = max(exes, key=os.path.getmtime) if exes else None
+        else:
+            exe = build(test, main_opts, args)
+
+        if exe is None:
+            print("  build failed")
+            failed.append(test.name)
+            continue
+
+        measured = {}
+        ran = True
+        for _ in range(args.repeat):
+            telemetry = run(test, exe, args)
+            if telemetry is None:
+                ran = False
+                break
+            for metric, value in throughput(telemetry, test.warmup_steps).items():
+                measured[metric] = max(value, measured.get(metric, 0.0))
+
+        if not ran:
+            print("  run failed; see {}".format(os.path.join(args.work_dir, test.name, "run.out")))
+            failed.append(test.name)
+            continue
+
+        if args.update:
+            baselines[test.name] = measured
+
+        rows = compare(measured, baselines.get(test.name, {}), test.tolerance)
+
+        print("  {:<10} {:>14} {:>14} {:>9}".format("zones/s", "measured", "baseline", "change"))
+        for metric, m, b, change, status in rows:
+            print("  {:<10} {:>14} {:>14} {:>9}  {}".format(
+                metric,
+                "-" if m is None else "{:.4g}".format(m),
+                "-" if b is None else "{:.4g}".format(b),
+                "-" if change is None else "{:+.1%}".format(change),
+                status))
+
+        if any(r[4] == "FAIL" for r in rows):
+            failed.append(test.name)
+
+    if args.update:
+        if not os.path.isdir(os.path.dirname(baseline_file)):
+            os.makedirs(os.path.dirname(baseline_file))
+        with open(baseline_file, "w") as f:
+            json.dump(baselines, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("baselines written to {}".format(baseline_file))
+
+    if failed:
+        print("performance regressions or failures in: {}".format(", ".join(failed)))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+
+"""Read the binary tracer particle timestamp files written with
+particles.timestamp_format = 1.
+
+Each rank writes its own file, Timestamp_NNNNN.bin, in
+particles.timestamp_dir.  A file starts with a header
+
+  "CASTROTS" | int32 version | int32 sizeof(Real) | int32 dim | int32 nvars |
+  nvars x (int32 length | name)
+
+followed by one block per level per timestamp
+
+  Real time | int32 level | int64 nparticles |
+  nparticles x (int64 id | int32 cpu | Real pos[dim] | Real vel[dim] | Real vals[nvars])
+
+All values are in the native byte order of the machine that wrote them.
+
+usage:
+
+  read_timestamps.py timestamp_dir              # summary
+  read_timestamps.py timestamp_dir id cpu       # history of one particle
+"""
+
+import glob
+import os
+import sys
+
+import numpy as np
+
+
+MAGIC = b"CASTROTS"
+
+
+def _read_header(f):
+    if f.read(len(MAGIC)) != MAGIC:
+        raise ValueError("not a Castro binary timestamp file")
+
+    version, real_size, dim, nvars = np.fromfile(f, dtype=np.int32, count=4)
+    if version != 1:
+        raise ValueError("unsupported timestamp file version {}".format(version))
+
+    names = []
+    for _ in range(nvars):
+        n = int(np.fromfile(f, dtype=np.int32, count=1)[0])
+        names.append(f.read(n).decode())
+
+    return {"real": np.float64 if real_size == 8 else np.float32,
+            "dim": int(dim), "names": names}
+
+
+def _record_dtype(header):
+    real = header["real"]
+    fields = [("id", np.int64), ("cpu", np.int32)]
+    fields += [(x, real) for x in ["x", "y", "z"][:header["dim"]]]
+    fields += [(v, real) for v in ["vx", "vy", "vz"][:header["dim"]]]
+    fields += [(name, real) for name in header["names"]]
+    return np.dtype(fields)
+
+
+def read_file(filename):
+    """Return (header, records) for one rank's file, where records is a
+    structured array of all the particle records in the file with the
+    extra fields "time" and "level"."""
+
+    with open(filename, "rb") as f:
+        header = _read_header(f)
+        rec = _record_dtype(header)
+        real = header["real"]
+
+        out_dtype = np.dtype([("time", real), ("level", np.int32)] + rec.descr)
+
+        blocks = []
+        while True:
+            t = np.fromfile(f, dtype=real, count=1)
+            if t.size == 0:
+                break
+            level = np.fromfile(f, dtype=np.int32, count=1)[0]
+            n = int(np.fromfile(f, dtype=np.int64, count=1)[0])
+            data = np.fromfile(f, dtype=rec, count=n)
+            if data.size != n:
+                # a truncated final block (e.g. the run was killed
+                # while writing); ignore it
+                break
+
+            block = np.empty(n, dtype=out_dtype)
+            block["time"] = t[0]
+            block["level"] = level
+            for name in rec.names:
+                block[name] = data[name]
+            blocks.append(block)
+
+    if blocks:
+        records = np.concatenate(blocks)
+    else:
+        records = np.empty(0, dtype=out_dtype)
+
+    return header, records
+
+
+def read_dir(dirname):
+    """Read all of the rank files in a timestamp directory, returning
+    (header, records) with the records from all ranks sorted by time."""
+
+    files = sorted(glob.glob(os.path.join(dirname, "Timestamp_*.bin")))
+    if not files:
+        raise IOError("no binary timestamp files in {}".format(dirname))
+
+    header = None
+    all_records = []
+    for filename in files:
+        h, r = read_file(filename)
+        if header is None:
+            header = h
+        elif h != header:
+            raise ValueError("{} has a different header".format(filename))
+        all_records.append(r)
+
+    records = np.concatenate(all_records)
+    records = records[np.argsort(records["time"], kind="stable")]
+
+    return header, records
+
+
+def history(records, pid, cpu):
+    """The time history of the particle with the given id and cpu."""
+    return records[(records["id"] == pid) & (records["cpu"] == cpu)]
+
+
+def main():
+    if len(sys.argv) not in [2, 4]:
+        sys.exit(__doc__)
+
+    header, records = read_dir(sys.argv[1])
+
+    if len(sys.argv) == 2:
+        ids = np.unique(records[["id", "cpu"]])
+        print("variables: {}".format(", ".join(header["names"])))
+        print("records:   {}".format(records.size))
+        print("particles: {}".format(ids.size))
+        if records.size > 0:
+            print("times:     {} to {}".format(records["time"].min(), records["time"].max()))
+    else:
+        h = history(records, int(sys.argv[2]), int(sys.argv[3]))
+        names = list(h.dtype.names)
+        print(" ".join("{:>14}".format(n) for n in names))
+        for row in h:
+            print(" ".join("{:14.6g}".format(row[n]) for n in names))
+
+
+if __name__ == "__main__":
+    main()